@@ -0,0 +1,204 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bitmap size
+#define GB_DEMO_CORE_BATCH_SIZE         (512)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the batch demo type
+typedef struct __gb_demo_core_batch_t
+{
+    // the rects
+    gb_rect_ref_t           rects;
+
+    // the circles
+    gb_circle_ref_t         circles;
+
+    // the matrices of the path instances
+    gb_matrix_ref_t         matrices;
+
+    // the instanced path
+    gb_path_ref_t           path;
+
+    // the count
+    tb_size_t               count;
+
+}gb_demo_core_batch_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t gb_demo_core_batch_init(gb_demo_core_batch_t* batch, tb_size_t count)
+{
+    // init shapes
+    batch->count    = count;
+    batch->rects    = tb_nalloc0_type(count, gb_rect_t);
+    batch->circles  = tb_nalloc0_type(count, gb_circle_t);
+    batch->matrices = tb_nalloc0_type(count, gb_matrix_t);
+    batch->path     = gb_path_init();
+    tb_assert_and_check_return_val(batch->rects && batch->circles && batch->matrices && batch->path, tb_false);
+
+    // make the random shapes, some of them are out of the bitmap
+    tb_size_t i = 0;
+    tb_random_reset(tb_true);
+    for (i = 0; i < count; i++)
+    {
+        gb_rect_imake(&batch->rects[i], tb_random_range(-32, GB_DEMO_CORE_BATCH_SIZE + 16), tb_random_range(-32, GB_DEMO_CORE_BATCH_SIZE + 16), tb_random_range(1, 24), tb_random_range(1, 24));
+        gb_circle_imake(&batch->circles[i], tb_random_range(-32, GB_DEMO_CORE_BATCH_SIZE + 32), tb_random_range(-32, GB_DEMO_CORE_BATCH_SIZE + 32), tb_random_range(1, 20));
+        gb_matrix_init_rotate(&batch->matrices[i], gb_long_to_float(tb_random_range(0, 360)));
+        gb_matrix_translate_lhs(&batch->matrices[i], gb_long_to_float(tb_random_range(-16, GB_DEMO_CORE_BATCH_SIZE + 16)), gb_long_to_float(tb_random_range(-16, GB_DEMO_CORE_BATCH_SIZE + 16)));
+    }
+
+    // make the concave arrow path for the instances
+    gb_path_move2i_to(batch->path, -10, -4);
+    gb_path_line2i_to(batch->path, 4, -4);
+    gb_path_line2i_to(batch->path, 4, -10);
+    gb_path_line2i_to(batch->path, 14, 0);
+    gb_path_line2i_to(batch->path, 4, 10);
+    gb_path_line2i_to(batch->path, 4, 4);
+    gb_path_line2i_to(batch->path, -10, 4);
+    gb_path_clos(batch->path);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_demo_core_batch_exit(gb_demo_core_batch_t* batch)
+{
+    // exit shapes
+    if (batch->rects) tb_free(batch->rects);
+    if (batch->circles) tb_free(batch->circles);
+    if (batch->matrices) tb_free(batch->matrices);
+    if (batch->path) gb_path_exit(batch->path);
+    tb_memset(batch, 0, sizeof(gb_demo_core_batch_t));
+}
+static tb_hong_t gb_demo_core_batch_draw(gb_canvas_ref_t canvas, gb_demo_core_batch_t* batch, tb_size_t kind, tb_size_t mode, tb_bool_t batched)
+{
+    // clear it
+    gb_canvas_draw_clear(canvas, GB_COLOR_BLACK);
+
+    // init paint
+    gb_canvas_mode_set(canvas, mode);
+    gb_canvas_color_set(canvas, gb_color_make(0xff, 0x40, 0xa0, 0xf0));
+    gb_canvas_alpha_set(canvas, 0x80);
+
+    // draw shapes
+    tb_size_t i = 0;
+    tb_hong_t dt = tb_mclock();
+    switch (kind)
+    {
+    case 0:
+        if (batched) gb_canvas_draw_rects(canvas, batch->rects, batch->count);
+        else for (i = 0; i < batch->count; i++) gb_canvas_draw_rect(canvas, &batch->rects[i]);
+        break;
+    case 1:
+        if (batched) gb_canvas_draw_circles(canvas, batch->circles, batch->count);
+        else for (i = 0; i < batch->count; i++) gb_canvas_draw_circle(canvas, &batch->circles[i]);
+        break;
+    default:
+        if (batched) gb_canvas_draw_path_instances(canvas, batch->path, batch->matrices, batch->count);
+        else
+        {
+            // apply the matrix of every instance before the canvas matrix
+            for (i = 0; i < batch->count; i++)
+            {
+                gb_matrix_multiply(gb_canvas_save_matrix(canvas), &batch->matrices[i]);
+                gb_canvas_draw_path(canvas, batch->path);
+                gb_canvas_load_matrix(canvas);
+            }
+        }
+        break;
+    }
+    return tb_mclock() - dt;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_batch_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the shapes count
+    tb_size_t count = argc > 1? tb_atoi(argv[1]) : 20000;
+    tb_assert_and_check_return_val(count, -1);
+
+    // init bitmaps, canvases and shapes
+    tb_size_t               failed = 0;
+    gb_demo_core_batch_t    batch = {0};
+    gb_bitmap_ref_t         bitmap_single = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888 | GB_PIXFMT_NENDIAN, GB_DEMO_CORE_BATCH_SIZE, GB_DEMO_CORE_BATCH_SIZE, 0, tb_false);
+    gb_bitmap_ref_t         bitmap_batched = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888 | GB_PIXFMT_NENDIAN, GB_DEMO_CORE_BATCH_SIZE, GB_DEMO_CORE_BATCH_SIZE, 0, tb_false);
+    gb_canvas_ref_t         canvas_single = bitmap_single? gb_canvas_init_from_bitmap(bitmap_single) : tb_null;
+    gb_canvas_ref_t         canvas_batched = bitmap_batched? gb_canvas_init_from_bitmap(bitmap_batched) : tb_null;
+    tb_size_t               quality = gb_quality();
+    do
+    {
+        // check
+        tb_assert_and_check_break(canvas_single && canvas_batched);
+
+        // init shapes
+        if (!gb_demo_core_batch_init(&batch, count))
+        {
+            failed++;
+            break;
+        }
+
+        // the same canvas matrix for the both canvases
+        gb_canvas_scalep(canvas_single, GB_ONE + GB_ONE / 4, GB_ONE + GB_ONE / 4, gb_long_to_float(256), gb_long_to_float(256));
+        gb_canvas_scalep(canvas_batched, GB_ONE + GB_ONE / 4, GB_ONE + GB_ONE / 4, gb_long_to_float(256), gb_long_to_float(256));
+
+        // the aliased and antialiased shapes
+        tb_size_t   q = 0;
+        tb_size_t   qualities[] = {GB_QUALITY_LOW, GB_QUALITY_TOP};
+        for (q = 0; q < tb_arrayn(qualities); q++)
+        {
+            // the rects, circles and path instances
+            tb_size_t kind = 0;
+            gb_quality_set(qualities[q]);
+            for (kind = 0; kind < 3; kind++)
+            {
+                // the filled and stroked shapes
+                tb_size_t mode = 0;
+                for (mode = GB_PAINT_MODE_FILL; mode <= GB_PAINT_MODE_STROKE; mode++)
+                {
+                    // draw them one by one and batched
+                    tb_hong_t dt_single = gb_demo_core_batch_draw(canvas_single, &batch, kind, mode, tb_false);
+                    tb_hong_t dt_batched = gb_demo_core_batch_draw(canvas_batched, &batch, kind, mode, tb_true);
+
+                    // the output pixels are identical
+                    tb_bool_t same = !tb_memcmp(gb_bitmap_data(bitmap_single), gb_bitmap_data(bitmap_batched), gb_bitmap_row_bytes(bitmap_single) * GB_DEMO_CORE_BATCH_SIZE);
+                    if (!same) failed++;
+
+                    // trace
+                    tb_trace_i("quality: %lu, kind: %lu, mode: %lu, count: %lu, single: %lld ms, batched: %lld ms, same: %s", qualities[q], kind, mode, count, dt_single, dt_batched, same? "ok" : "no");
+                }
+            }
+        }
+
+    } while (0);
+
+    // restore quality
+    gb_quality_set(quality);
+
+    // exit shapes
+    gb_demo_core_batch_exit(&batch);
+
+    // exit canvases and bitmaps
+    if (canvas_single) gb_canvas_exit(canvas_single);
+    if (canvas_batched) gb_canvas_exit(canvas_batched);
+    if (bitmap_single) gb_bitmap_exit(bitmap_single);
+    if (bitmap_batched) gb_bitmap_exit(bitmap_batched);
+
+    // trace
+    tb_trace_i("batch: failed: %lu", failed);
+
+    // check
+    if (failed) tb_abort();
+    return 0;
+}
@@ -0,0 +1,250 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bitmap size
+#define GB_DEMO_CORE_BLEND_SIZE         (8)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the pixfmts
+static tb_size_t        g_blend_pixfmts[] =
+{
+    GB_PIXFMT_ARGB8888 | GB_PIXFMT_NENDIAN
+,   GB_PIXFMT_XRGB8888 | GB_PIXFMT_NENDIAN
+,   GB_PIXFMT_PARGB8888 | GB_PIXFMT_NENDIAN
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static __tb_inline__ tb_long_t gb_demo_core_blend_mul(tb_long_t a, tb_long_t b)
+{
+    return (a * b + 127) / 255;
+}
+static tb_long_t gb_demo_core_blend_channel(tb_size_t mode, tb_long_t s, tb_long_t d, tb_long_t sa, tb_long_t da)
+{
+    // the reference blend operation of the premultiplied channel, all values are in [0, 255]
+    switch (mode)
+    {
+    case GB_PAINT_BLEND_SRC_OVER:   return s + gb_demo_core_blend_mul(d, 255 - sa);
+    case GB_PAINT_BLEND_CLEAR:      return 0;
+    case GB_PAINT_BLEND_SRC:        return s;
+    case GB_PAINT_BLEND_DST:        return d;
+    case GB_PAINT_BLEND_DST_OVER:   return d + gb_demo_core_blend_mul(s, 255 - da);
+    case GB_PAINT_BLEND_SRC_IN:     return gb_demo_core_blend_mul(s, da);
+    case GB_PAINT_BLEND_DST_IN:     return gb_demo_core_blend_mul(d, sa);
+    case GB_PAINT_BLEND_SRC_OUT:    return gb_demo_core_blend_mul(s, 255 - da);
+    case GB_PAINT_BLEND_DST_OUT:    return gb_demo_core_blend_mul(d, 255 - sa);
+    case GB_PAINT_BLEND_SRC_ATOP:   return gb_demo_core_blend_mul(s, da) + gb_demo_core_blend_mul(d, 255 - sa);
+    case GB_PAINT_BLEND_DST_ATOP:   return gb_demo_core_blend_mul(d, sa) + gb_demo_core_blend_mul(s, 255 - da);
+    case GB_PAINT_BLEND_XOR:        return gb_demo_core_blend_mul(s, 255 - da) + gb_demo_core_blend_mul(d, 255 - sa);
+    case GB_PAINT_BLEND_PLUS:       return tb_min(s + d, 255);
+    case GB_PAINT_BLEND_MULTIPLY:   return gb_demo_core_blend_mul(s, 255 - da) + gb_demo_core_blend_mul(d, 255 - sa) + gb_demo_core_blend_mul(s, d);
+    case GB_PAINT_BLEND_SCREEN:     return s + d - gb_demo_core_blend_mul(s, d);
+    case GB_PAINT_BLEND_DARKEN:     return s + d - tb_max(gb_demo_core_blend_mul(s, da), gb_demo_core_blend_mul(d, sa));
+    case GB_PAINT_BLEND_LIGHTEN:    return s + d - tb_min(gb_demo_core_blend_mul(s, da), gb_demo_core_blend_mul(d, sa));
+    default:
+        break;
+    }
+    return 0;
+}
+static tb_uint32_t gb_demo_core_blend_premul(gb_color_t color)
+{
+    // premultiply the color to the argb32 pixel
+    return ((tb_uint32_t)color.a << 24) | (gb_demo_core_blend_mul(color.r, color.a) << 16) | (gb_demo_core_blend_mul(color.g, color.a) << 8) | gb_demo_core_blend_mul(color.b, color.a);
+}
+static tb_uint32_t gb_demo_core_blend_expect(tb_size_t mode, tb_size_t pixfmt, gb_color_t src, gb_color_t dst)
+{
+    // the destination without alpha is opaque
+    if (GB_PIXFMT(pixfmt) == GB_PIXFMT(GB_PIXFMT_XRGB8888)) dst.a = 0xff;
+
+    // the premultiplied source and destination
+    tb_uint32_t s = gb_demo_core_blend_premul(src);
+    tb_uint32_t d = gb_demo_core_blend_premul(dst);
+
+    // blend all channels, the alpha channel uses the same formula
+    tb_size_t   i = 0;
+    tb_uint32_t r = 0;
+    for (i = 0; i < 32; i += 8)
+    {
+        tb_long_t c = gb_demo_core_blend_channel(mode, (s >> i) & 0xff, (d >> i) & 0xff, s >> 24, d >> 24);
+        r |= (tb_uint32_t)tb_max(tb_min(c, 255), 0) << i;
+    }
+    return r;
+}
+static tb_uint32_t gb_demo_core_blend_result(gb_bitmap_ref_t bitmap)
+{
+    // the center pixel
+    tb_size_t   pixfmt = gb_bitmap_pixfmt(bitmap);
+    tb_byte_t*  data = (tb_byte_t*)gb_bitmap_data(bitmap) + (GB_DEMO_CORE_BLEND_SIZE >> 1) * gb_bitmap_row_bytes(bitmap) + (GB_DEMO_CORE_BLEND_SIZE >> 1) * 4;
+    tb_uint32_t pixel = *((tb_uint32_t*)data);
+
+    // the premultiplied argb32 pixel
+    switch (GB_PIXFMT(pixfmt))
+    {
+    case GB_PIXFMT(GB_PIXFMT_ARGB8888):     return gb_demo_core_blend_premul(gb_pixel_color(pixel));
+    case GB_PIXFMT(GB_PIXFMT_XRGB8888):     return pixel | 0xff000000;
+    default:                                return pixel;
+    }
+}
+static tb_bool_t gb_demo_core_blend_check(tb_char_t const* name, tb_size_t mode, tb_size_t pixfmt, tb_uint32_t result, tb_uint32_t expect)
+{
+    // the error of every channel, the xrgb8888 has not alpha
+    tb_size_t i = 0;
+    tb_size_t n = GB_PIXFMT(pixfmt) == GB_PIXFMT(GB_PIXFMT_XRGB8888)? 24 : 32;
+    for (i = 0; i < n; i += 8)
+    {
+        tb_long_t e = (tb_long_t)((result >> i) & 0xff) - (tb_long_t)((expect >> i) & 0xff);
+        if (tb_abs(e) > 2)
+        {
+            // trace
+            tb_trace_e("%s: mode: %lu, pixfmt: %lx, result: %08x != expect: %08x", name, mode, pixfmt, result, expect);
+            return tb_false;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_demo_core_blend_fill(tb_size_t mode, tb_size_t pixfmt, gb_color_t src, gb_color_t dst)
+{
+    // init bitmap and canvas
+    tb_bool_t       ok = tb_false;
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, pixfmt, GB_DEMO_CORE_BLEND_SIZE, GB_DEMO_CORE_BLEND_SIZE, 0, tb_true);
+    gb_canvas_ref_t canvas = bitmap? gb_canvas_init_from_bitmap(bitmap) : tb_null;
+    if (canvas)
+    {
+        // fill the solid rect
+        gb_canvas_draw_clear(canvas, dst);
+        gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+        gb_canvas_blend_set(canvas, mode);
+        gb_canvas_color_set(canvas, gb_color_make(0xff, src.r, src.g, src.b));
+        gb_canvas_alpha_set(canvas, src.a);
+        gb_canvas_draw_rect2i(canvas, 0, 0, GB_DEMO_CORE_BLEND_SIZE, GB_DEMO_CORE_BLEND_SIZE);
+
+        // check it
+        ok = gb_demo_core_blend_check("fill", mode, pixfmt, gb_demo_core_blend_result(bitmap), gb_demo_core_blend_expect(mode, pixfmt, src, dst));
+    }
+
+    // exit canvas and bitmap
+    if (canvas) gb_canvas_exit(canvas);
+    if (bitmap) gb_bitmap_exit(bitmap);
+    return ok;
+}
+static tb_bool_t gb_demo_core_blend_draw_bitmap(tb_size_t mode, tb_size_t pixfmt, tb_size_t spixfmt, gb_color_t src, gb_color_t dst)
+{
+    // init bitmaps and canvas
+    tb_bool_t       ok = tb_false;
+    tb_bool_t       has_alpha = GB_PIXFMT(spixfmt) != GB_PIXFMT(GB_PIXFMT_XRGB8888);
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, pixfmt, GB_DEMO_CORE_BLEND_SIZE, GB_DEMO_CORE_BLEND_SIZE, 0, tb_true);
+    gb_bitmap_ref_t source = gb_bitmap_init(tb_null, spixfmt, GB_DEMO_CORE_BLEND_SIZE, GB_DEMO_CORE_BLEND_SIZE, 0, has_alpha);
+    gb_canvas_ref_t canvas = bitmap? gb_canvas_init_from_bitmap(bitmap) : tb_null;
+    gb_canvas_ref_t scanvas = source? gb_canvas_init_from_bitmap(source) : tb_null;
+    if (canvas && scanvas)
+    {
+        /* make the source pixels
+         *
+         * the source without alpha is opaque and the paint alpha will be the source alpha
+         */
+        gb_color_t  color = src;
+        tb_byte_t   alpha = 0xff;
+        if (!has_alpha)
+        {
+            color.a = 0xff;
+            alpha   = src.a;
+        }
+        gb_canvas_draw_clear(scanvas, color);
+
+        // draw the source bitmap
+        gb_canvas_draw_clear(canvas, dst);
+        gb_canvas_blend_set(canvas, mode);
+        gb_canvas_alpha_set(canvas, alpha);
+        gb_canvas_draw_bitmap(canvas, source, 0, 0);
+
+        // check it
+        ok = gb_demo_core_blend_check("bitmap", mode, pixfmt, gb_demo_core_blend_result(bitmap), gb_demo_core_blend_expect(mode, pixfmt, src, dst));
+    }
+
+    // exit canvas and bitmaps
+    if (scanvas) gb_canvas_exit(scanvas);
+    if (canvas) gb_canvas_exit(canvas);
+    if (source) gb_bitmap_exit(source);
+    if (bitmap) gb_bitmap_exit(bitmap);
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_blend_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the known colors
+    gb_color_t srcs[] =
+    {
+        gb_color_make(0x80, 0xff, 0x00, 0x00)
+    ,   gb_color_make(0xff, 0x20, 0xc0, 0x60)
+    ,   gb_color_make(0x40, 0xff, 0xff, 0xff)
+    ,   gb_color_make(0x00, 0x80, 0x80, 0x80)
+    };
+    gb_color_t dsts[] =
+    {
+        gb_color_make(0xff, 0x00, 0x00, 0xff)
+    ,   gb_color_make(0x80, 0x00, 0xff, 0x00)
+    ,   gb_color_make(0x00, 0x00, 0x00, 0x00)
+    };
+
+    // no antialiasing and dithering for the exact colors
+    tb_size_t quality = gb_quality();
+    gb_quality_set(GB_QUALITY_LOW);
+
+    // done
+    tb_size_t failed = 0;
+    tb_size_t mode = 0;
+    tb_size_t f = 0;
+    tb_size_t s = 0;
+    tb_size_t d = 0;
+    for (mode = 0; mode < GB_PAINT_BLEND_MAXN; mode++)
+    {
+        for (f = 0; f < tb_arrayn(g_blend_pixfmts); f++)
+        {
+            for (s = 0; s < tb_arrayn(srcs); s++)
+            {
+                for (d = 0; d < tb_arrayn(dsts); d++)
+                {
+                    /* the source-over mode of the non-premultiplied pixfmt lerps the unpremultiplied channels,
+                     * so it is only same as the porter-duff formula for the opaque destination
+                     */
+                    if (    mode == GB_PAINT_BLEND_SRC_OVER 
+                        &&  GB_PIXFMT(g_blend_pixfmts[f]) == GB_PIXFMT(GB_PIXFMT_ARGB8888)
+                        &&  dsts[d].a != 0xff)
+                        continue;
+
+                    // fill the solid color
+                    if (!gb_demo_core_blend_fill(mode, g_blend_pixfmts[f], srcs[s], dsts[d])) failed++;
+
+                    // draw the bitmap of the same pixfmt and the argb8888 bitmap
+                    if (!gb_demo_core_blend_draw_bitmap(mode, g_blend_pixfmts[f], g_blend_pixfmts[f], srcs[s], dsts[d])) failed++;
+                    if (!gb_demo_core_blend_draw_bitmap(mode, g_blend_pixfmts[f], GB_PIXFMT_ARGB8888 | GB_PIXFMT_NENDIAN, srcs[s], dsts[d])) failed++;
+                }
+            }
+        }
+    }
+
+    // restore quality
+    gb_quality_set(quality);
+
+    // trace
+    tb_trace_i("blend: failed: %lu", failed);
+
+    // check
+    if (failed) tb_abort();
+    return 0;
+}
@@ -0,0 +1,238 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bitmap width
+#define GB_DEMO_CORE_DITHER_WIDTH       (61)
+
+// the bitmap height
+#define GB_DEMO_CORE_DITHER_HEIGHT      (37)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the 16-bit pixfmts
+static tb_size_t        g_dither_pixfmts[] =
+{
+    GB_PIXFMT_RGB565 | GB_PIXFMT_NENDIAN
+,   GB_PIXFMT_ARGB4444 | GB_PIXFMT_NENDIAN
+,   GB_PIXFMT_XRGB1555 | GB_PIXFMT_NENDIAN
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_void_t gb_demo_core_dither_draw(gb_canvas_ref_t canvas, gb_color_t color, tb_byte_t alpha)
+{
+    // the solid color
+    gb_canvas_color_set(canvas, color);
+    gb_canvas_alpha_set(canvas, alpha);
+
+    // fill the rects at the odd positions
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_draw_rect2i(canvas, 3, 1, 37, 21);
+    gb_canvas_draw_rect2i(canvas, 1, 25, 58, 11);
+
+    // stroke the vertical, horizontal and diagonal hairlines, only the diagonal hairline is antialiased
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+    gb_canvas_draw_line2i(canvas, 45, 2, 45, 20);
+    gb_canvas_draw_line2i(canvas, 42, 22, 59, 22);
+    gb_canvas_draw_line2i(canvas, 48, 2, 59, 19);
+}
+static tb_bool_t gb_demo_core_dither_covered(tb_size_t pixfmt, tb_byte_t const* data, tb_byte_t const* cleared, tb_long_t x, tb_long_t y, gb_color_t color, tb_size_t steps)
+{
+    // only the pixels of the antialiased diagonal hairline are covered partially
+    tb_check_return_val(x >= 47 && y < 21, tb_false);
+
+    /* the covered pixel is the dithered color of its position blended with the unknown coverage
+     *
+     * so it need be same as the pixel blended by the alpha pixmap with one of all alphas, 
+     * or the pixel set by the opaque pixmap for the full coverage
+     */
+    gb_pixmap_ref_t blended = gb_pixmap(pixfmt, GB_ALPHA_MINN);
+    gb_pixmap_ref_t opaque = gb_pixmap(pixfmt, 0xff);
+    tb_assert_and_check_return_val(blended && opaque, tb_false);
+
+    // done
+    tb_size_t   alpha = 0;
+    tb_uint16_t expect = 0;
+    gb_color_t  dithered = gb_pixmap_dither_color(color, steps, x, y);
+    for (alpha = 1; alpha < 256; alpha++)
+    {
+        tb_memcpy(&expect, cleared, 2);
+        blended->pixel_set(&expect, blended->pixel(dithered), (tb_byte_t)alpha);
+        if (!tb_memcmp(data, &expect, 2)) return tb_true;
+    }
+    opaque->pixel_set(&expect, opaque->pixel(dithered), 0xff);
+    if (!tb_memcmp(data, &expect, 2)) return tb_true;
+
+    // failed
+    return tb_false;
+}
+static tb_bool_t gb_demo_core_dither_check(tb_size_t pixfmt, gb_color_t color, tb_byte_t alpha)
+{
+    // init bitmap and canvas
+    tb_bool_t       ok = tb_false;
+    tb_byte_t*      cleared = tb_null;
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, pixfmt, GB_DEMO_CORE_DITHER_WIDTH, GB_DEMO_CORE_DITHER_HEIGHT, 0, tb_false);
+    gb_canvas_ref_t canvas = bitmap? gb_canvas_init_from_bitmap(bitmap) : tb_null;
+    do
+    {
+        // check
+        tb_check_break(canvas);
+
+        // the pixmaps and the dither steps
+        gb_pixmap_ref_t pixmap = gb_pixmap(pixfmt, alpha);
+        tb_size_t       steps = pixmap? gb_pixmap_dither_steps(pixmap) : 0;
+        tb_assert_and_check_break(steps);
+
+        // clear it and save the cleared pixels
+        tb_size_t row_bytes = gb_bitmap_row_bytes(bitmap);
+        tb_size_t size = row_bytes * GB_DEMO_CORE_DITHER_HEIGHT;
+        gb_canvas_draw_clear(canvas, gb_color_make(0xff, 0x30, 0x60, 0x90));
+        cleared = (tb_byte_t*)tb_malloc(size);
+        tb_assert_and_check_break(cleared);
+        tb_memcpy(cleared, gb_bitmap_data(bitmap), size);
+
+        // draw it
+        gb_demo_core_dither_draw(canvas, color, alpha);
+
+        /* check all drawn pixels
+         *
+         * the pixel at (x, y) is the dithered color of its position blended to the cleared pixel
+         */
+        tb_long_t   x = 0;
+        tb_long_t   y = 0;
+        tb_size_t   drawn = 0;
+        tb_size_t   failed = 0;
+        tb_uint16_t expect = 0;
+        tb_byte_t*  data = (tb_byte_t*)gb_bitmap_data(bitmap);
+        for (y = 0; y < GB_DEMO_CORE_DITHER_HEIGHT; y++)
+        {
+            for (x = 0; x < GB_DEMO_CORE_DITHER_WIDTH; x++)
+            {
+                tb_size_t offset = y * row_bytes + (x << 1);
+                if (!tb_memcmp(data + offset, cleared + offset, 2)) continue;
+
+                // the expected pixel
+                tb_memcpy(&expect, cleared + offset, 2);
+                pixmap->pixel_set(&expect, pixmap->pixel(gb_pixmap_dither_color(color, steps, x, y)), alpha);
+                if (tb_memcmp(data + offset, &expect, 2) && !gb_demo_core_dither_covered(pixfmt, data + offset, cleared + offset, x, y, color, steps)) failed++;
+                drawn++;
+            }
+        }
+
+        // trace
+        tb_trace_i("%s: alpha: %u, drawn: %lu, failed: %lu", pixmap->name, alpha, drawn, failed);
+
+        // ok?
+        ok = drawn && !failed;
+
+    } while (0);
+
+    // exit canvas and bitmap
+    if (cleared) tb_free(cleared);
+    if (canvas) gb_canvas_exit(canvas);
+    if (bitmap) gb_bitmap_exit(bitmap);
+    return ok;
+}
+static tb_bool_t gb_demo_core_dither_average(tb_size_t pixfmt, gb_color_t color)
+{
+    // init bitmap and canvas
+    tb_bool_t       ok = tb_false;
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, pixfmt, 16, 16, 0, tb_false);
+    gb_canvas_ref_t canvas = bitmap? gb_canvas_init_from_bitmap(bitmap) : tb_null;
+    if (canvas)
+    {
+        // fill it
+        gb_canvas_draw_clear(canvas, GB_COLOR_BLACK);
+        gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+        gb_canvas_color_set(canvas, color);
+        gb_canvas_draw_rect2i(canvas, 0, 0, 16, 16);
+
+        // the sum of the colors
+        tb_size_t       i = 0;
+        tb_size_t       r = 0;
+        tb_size_t       g = 0;
+        tb_size_t       b = 0;
+        gb_pixmap_ref_t pixmap = gb_pixmap(pixfmt, 0xff);
+        tb_byte_t*      data = (tb_byte_t*)gb_bitmap_data(bitmap);
+        for (i = 0; i < 256; i++)
+        {
+            gb_color_t c = pixmap->color(pixmap->pixel_get(data + (i >> 4) * gb_bitmap_row_bytes(bitmap) + ((i & 15) << 1)));
+            r += c.r;
+            g += c.g;
+            b += c.b;
+        }
+
+        // the dithered colors are the given color on average
+        ok =    tb_abs((tb_long_t)(r >> 8) - color.r) <= 2
+            &&  tb_abs((tb_long_t)(g >> 8) - color.g) <= 2
+            &&  tb_abs((tb_long_t)(b >> 8) - color.b) <= 2;
+
+        // trace
+        tb_trace_i("%s: average: %02lx%02lx%02lx, color: %02x%02x%02x", pixmap->name, r >> 8, g >> 8, b >> 8, color.r, color.g, color.b);
+    }
+
+    // exit canvas and bitmap
+    if (canvas) gb_canvas_exit(canvas);
+    if (bitmap) gb_bitmap_exit(bitmap);
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_dither_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the known colors between the quantized levels
+    gb_color_t colors[] =
+    {
+        gb_color_make(0xff, 0x64, 0x96, 0xcb)
+    ,   gb_color_make(0xff, 0x13, 0x85, 0x2e)
+    ,   gb_color_make(0xff, 0xc9, 0x27, 0x7d)
+    };
+
+    // the opaque and translucent alphas
+    tb_byte_t alphas[] = {0xff, 0x96, 0x40};
+
+    // dither it
+    tb_size_t quality = gb_quality();
+    gb_quality_set(GB_QUALITY_MID);
+
+    // done
+    tb_size_t failed = 0;
+    tb_size_t f = 0;
+    tb_size_t c = 0;
+    tb_size_t a = 0;
+    for (f = 0; f < tb_arrayn(g_dither_pixfmts); f++)
+    {
+        for (c = 0; c < tb_arrayn(colors); c++)
+        {
+            // the pixels of the opaque and translucent fills and hairlines
+            for (a = 0; a < tb_arrayn(alphas); a++)
+            {
+                if (!gb_demo_core_dither_check(g_dither_pixfmts[f], colors[c], alphas[a])) failed++;
+            }
+
+            // the average color of the opaque fill
+            if (!gb_demo_core_dither_average(g_dither_pixfmts[f], colors[c])) failed++;
+        }
+    }
+
+    // restore quality
+    gb_quality_set(quality);
+
+    // trace
+    tb_trace_i("dither: failed: %lu", failed);
+
+    // check
+    if (failed) tb_abort();
+    return 0;
+}
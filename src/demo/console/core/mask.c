@@ -0,0 +1,156 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bitmap size
+#define GB_DEMO_CORE_MASK_SIZE          (512)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static gb_path_ref_t gb_demo_core_mask_path()
+{
+    // init path
+    gb_path_ref_t path = gb_path_init();
+    tb_assert_and_check_return_val(path, tb_null);
+
+    // make the concave flower with the curved petals and the self-intersecting star inside it
+    tb_size_t i = 0;
+    tb_size_t n = 12;
+    gb_path_move2i_to(path, 24, 0);
+    for (i = 1; i <= n; i++)
+    {
+        tb_double_t a0 = 2 * TB_PI * (i - 0.5) / n;
+        tb_double_t a1 = 2 * TB_PI * i / n;
+        gb_path_quad2i_to(path, (tb_long_t)(40 * tb_cos(a0)), (tb_long_t)(40 * tb_sin(a0)), (tb_long_t)(24 * tb_cos(a1)), (tb_long_t)(24 * tb_sin(a1)));
+    }
+    gb_path_clos(path);
+    gb_path_move2i_to(path, 0, -16);
+    gb_path_line2i_to(path, 9, 13);
+    gb_path_line2i_to(path, -15, -5);
+    gb_path_line2i_to(path, 15, -5);
+    gb_path_line2i_to(path, -9, 13);
+    gb_path_clos(path);
+
+    // ok
+    return path;
+}
+static tb_hong_t gb_demo_core_mask_draw(gb_canvas_ref_t canvas, gb_path_ref_t path, gb_point_ref_t offsets, tb_size_t count, tb_size_t rule, tb_bool_t cached)
+{
+    // clear it
+    gb_canvas_draw_clear(canvas, GB_COLOR_BLACK);
+
+    // init paint
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_fill_rule_set(canvas, rule);
+
+    /* draw the path at all offsets
+     *
+     * the repeated path is filled by the cached mask,
+     * and the polygon of the path is always filled directly
+     */
+    tb_size_t i = 0;
+    tb_hong_t dt = tb_mclock();
+    for (i = 0; i < count; i++)
+    {
+        gb_canvas_color_set(canvas, gb_color_make(0xff, (tb_byte_t)(i * 7), (tb_byte_t)(i * 13), (tb_byte_t)(i * 29)));
+        gb_canvas_save_matrix(canvas);
+        gb_canvas_translate(canvas, offsets[i].x, offsets[i].y);
+        if (cached) gb_canvas_draw_path(canvas, path);
+        else gb_canvas_draw_polygon(canvas, gb_path_polygon(path));
+        gb_canvas_load_matrix(canvas);
+    }
+    return tb_mclock() - dt;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_mask_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the draws count
+    tb_size_t count = argc > 1? tb_atoi(argv[1]) : 20000;
+    tb_assert_and_check_return_val(count, -1);
+
+    // init bitmaps, canvases, path and offsets
+    tb_size_t       failed = 0;
+    gb_path_ref_t   path = gb_demo_core_mask_path();
+    gb_point_ref_t  offsets = tb_nalloc0_type(count, gb_point_t);
+    gb_bitmap_ref_t bitmap_direct = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888 | GB_PIXFMT_NENDIAN, GB_DEMO_CORE_MASK_SIZE, GB_DEMO_CORE_MASK_SIZE, 0, tb_false);
+    gb_bitmap_ref_t bitmap_cached = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888 | GB_PIXFMT_NENDIAN, GB_DEMO_CORE_MASK_SIZE, GB_DEMO_CORE_MASK_SIZE, 0, tb_false);
+    gb_canvas_ref_t canvas_direct = bitmap_direct? gb_canvas_init_from_bitmap(bitmap_direct) : tb_null;
+    gb_canvas_ref_t canvas_cached = bitmap_cached? gb_canvas_init_from_bitmap(bitmap_cached) : tb_null;
+    tb_size_t       quality = gb_quality();
+    do
+    {
+        // check
+        tb_assert_and_check_break(path && offsets && canvas_direct && canvas_cached);
+
+        // the polygon fills are aliased
+        gb_quality_set(GB_QUALITY_LOW);
+
+        /* make the random offsets in the quarter pixel steps, some of them are out of the bitmap
+         *
+         * the few subpixel offsets are reused by the cached masks
+         */
+        tb_size_t i = 0;
+        tb_random_reset(tb_true);
+        for (i = 0; i < count; i++)
+        {
+            offsets[i].x = gb_long_to_float(tb_random_range(-48, GB_DEMO_CORE_MASK_SIZE + 48)) + GB_ONE * tb_random_range(0, 3) / 4;
+            offsets[i].y = gb_long_to_float(tb_random_range(-48, GB_DEMO_CORE_MASK_SIZE + 48)) + GB_ONE * tb_random_range(0, 3) / 4;
+        }
+
+        // the unscaled and scaled paths
+        tb_size_t s = 0;
+        for (s = 0; s < 2; s++)
+        {
+            // scale the both canvases
+            if (s)
+            {
+                gb_canvas_scale(canvas_direct, GB_ONE + GB_ONE / 2, GB_ONE + GB_ONE / 2);
+                gb_canvas_scale(canvas_cached, GB_ONE + GB_ONE / 2, GB_ONE + GB_ONE / 2);
+            }
+
+            // the odd and non-zero rules
+            tb_size_t rule = 0;
+            for (rule = GB_PAINT_FILL_RULE_ODD; rule <= GB_PAINT_FILL_RULE_NONZERO; rule++)
+            {
+                // fill them directly and by the cached masks
+                tb_hong_t dt_direct = gb_demo_core_mask_draw(canvas_direct, path, offsets, count, rule, tb_false);
+                tb_hong_t dt_cached = gb_demo_core_mask_draw(canvas_cached, path, offsets, count, rule, tb_true);
+
+                // the output pixels are identical
+                tb_bool_t same = !tb_memcmp(gb_bitmap_data(bitmap_direct), gb_bitmap_data(bitmap_cached), gb_bitmap_row_bytes(bitmap_direct) * GB_DEMO_CORE_MASK_SIZE);
+                if (!same) failed++;
+
+                // trace
+                tb_trace_i("scaled: %lu, rule: %lu, count: %lu, direct: %lld ms, cached: %lld ms, same: %s", s, rule, count, dt_direct, dt_cached, same? "ok" : "no");
+            }
+        }
+
+    } while (0);
+
+    // restore quality
+    gb_quality_set(quality);
+
+    // exit canvases, bitmaps, path and offsets
+    if (canvas_direct) gb_canvas_exit(canvas_direct);
+    if (canvas_cached) gb_canvas_exit(canvas_cached);
+    if (bitmap_direct) gb_bitmap_exit(bitmap_direct);
+    if (bitmap_cached) gb_bitmap_exit(bitmap_cached);
+    if (offsets) tb_free(offsets);
+    if (path) gb_path_exit(path);
+
+    // trace
+    tb_trace_i("mask: failed: %lu", failed);
+
+    // check
+    if (failed) tb_abort();
+    return 0;
+}
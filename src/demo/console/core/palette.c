@@ -0,0 +1,320 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bitmap size
+#define GB_DEMO_CORE_PALETTE_SIZE       (48)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static gb_palette_ref_t gb_demo_core_palette_init()
+{
+    // make the 6x6x6 color cube and the grays
+    gb_color_t  colors[GB_PALETTE_MAXN];
+    tb_size_t   i = 0;
+    tb_size_t   n = 0;
+    for (i = 0; i < 216; i++) colors[n++] = gb_color_make(0xff, (i / 36) * 0x33, ((i / 6) % 6) * 0x33, (i % 6) * 0x33);
+    for (i = 0; n < GB_PALETTE_MAXN; i++)
+    {
+        tb_byte_t g = (tb_byte_t)(8 + i * 6);
+        colors[n++] = gb_color_make(0xff, g, g, g);
+    }
+
+    // init palette
+    return gb_palette_init(colors, n);
+}
+static gb_color_t gb_demo_core_palette_blend(gb_color_t dst, gb_color_t src, tb_long_t alpha)
+{
+    // blend the source color to the destination color
+    dst.r = (tb_byte_t)(dst.r + ((((tb_long_t)src.r - dst.r) * alpha) >> 8));
+    dst.g = (tb_byte_t)(dst.g + ((((tb_long_t)src.g - dst.g) * alpha) >> 8));
+    dst.b = (tb_byte_t)(dst.b + ((((tb_long_t)src.b - dst.b) * alpha) >> 8));
+    return dst;
+}
+static tb_size_t gb_demo_core_palette_lookup(gb_palette_ref_t palette)
+{
+    /* the nearest color of every palette color is itself
+     *
+     * the index is looked up by the rgb555 cube, so the close grays may be mapped to each other
+     */
+    tb_size_t i = 0;
+    tb_size_t n = gb_palette_size(palette);
+    tb_size_t failed = 0;
+    for (i = 0; i < n; i++)
+    {
+        gb_color_t color = gb_palette_color(palette, i);
+        gb_color_t found = gb_palette_color(palette, gb_palette_index(palette, color));
+        if (tb_abs(color.r - found.r) > 8 || tb_abs(color.g - found.g) > 8 || tb_abs(color.b - found.b) > 8) failed++;
+    }
+
+    // trace
+    tb_trace_i("lookup: colors: %lu, failed: %lu", n, failed);
+    return failed;
+}
+static tb_size_t gb_demo_core_palette_fill(gb_palette_ref_t palette, gb_color_t clear, gb_color_t color, tb_byte_t alpha)
+{
+    // init bitmap and canvas
+    tb_size_t       failed = 1;
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_PAL8, GB_DEMO_CORE_PALETTE_SIZE, GB_DEMO_CORE_PALETTE_SIZE, 0, tb_false);
+    gb_canvas_ref_t canvas = tb_null;
+    do
+    {
+        // check
+        tb_check_break(bitmap);
+
+        // init canvas with the palette
+        gb_bitmap_palette_set(bitmap, palette);
+        canvas = gb_canvas_init_from_bitmap(bitmap);
+        tb_check_break(canvas);
+
+        // clear it
+        gb_canvas_draw_clear(canvas, clear);
+
+        // fill the rect
+        gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+        gb_canvas_color_set(canvas, color);
+        gb_canvas_alpha_set(canvas, alpha);
+        gb_canvas_draw_rect2i(canvas, 8, 8, 16, 16);
+
+        /* check all pixels
+         *
+         * the cleared pixel is the nearest index of the clear color,
+         * the filled pixel is the nearest index of the color blended to the cleared palette color
+         */
+        tb_size_t   x = 0;
+        tb_size_t   y = 0;
+        tb_size_t   index = 0;
+        tb_size_t   cleared = gb_palette_index(palette, clear);
+        tb_size_t   filled = gb_palette_index(palette, gb_demo_core_palette_blend(gb_palette_color(palette, cleared), color, alpha));
+        tb_byte_t*  data = (tb_byte_t*)gb_bitmap_data(bitmap);
+        if (alpha == 0xff) filled = gb_palette_index(palette, color);
+        for (failed = 0, y = 0; y < GB_DEMO_CORE_PALETTE_SIZE; y++)
+        {
+            for (x = 0; x < GB_DEMO_CORE_PALETTE_SIZE; x++)
+            {
+                index = (x >= 8 && x < 24 && y >= 8 && y < 24)? filled : cleared;
+                if (data[y * gb_bitmap_row_bytes(bitmap) + x] != index) failed++;
+            }
+        }
+
+        // trace
+        tb_trace_i("fill: alpha: %u, cleared: %lu, filled: %lu, failed: %lu", alpha, cleared, filled, failed);
+
+    } while (0);
+
+    // exit canvas and bitmap
+    if (canvas) gb_canvas_exit(canvas);
+    if (bitmap) gb_bitmap_exit(bitmap);
+    return failed;
+}
+static tb_size_t gb_demo_core_palette_hairline(gb_palette_ref_t palette, gb_color_t clear, gb_color_t color)
+{
+    // init bitmap and canvas
+    tb_size_t       failed = 1;
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_PAL8, GB_DEMO_CORE_PALETTE_SIZE, GB_DEMO_CORE_PALETTE_SIZE, 0, tb_false);
+    gb_canvas_ref_t canvas = tb_null;
+    tb_size_t       quality = gb_quality();
+    do
+    {
+        // check
+        tb_check_break(bitmap);
+
+        // init canvas with the palette
+        gb_bitmap_palette_set(bitmap, palette);
+        canvas = gb_canvas_init_from_bitmap(bitmap);
+        tb_check_break(canvas);
+
+        // stroke the antialiased hairline
+        gb_quality_set(GB_QUALITY_TOP);
+        gb_canvas_draw_clear(canvas, clear);
+        gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+        gb_canvas_color_set(canvas, color);
+        gb_canvas_draw_line2i(canvas, 2, 3, 45, 40);
+
+        /* check all drawn pixels
+         *
+         * the pixel is the nearest index of the color blended to the cleared palette color with one of all coverages
+         */
+        tb_size_t   i = 0;
+        tb_size_t   a = 0;
+        tb_size_t   drawn = 0;
+        tb_size_t   partial = 0;
+        tb_size_t   cleared = gb_palette_index(palette, clear);
+        tb_byte_t*  data = (tb_byte_t*)gb_bitmap_data(bitmap);
+        for (failed = 0, i = 0; i < GB_DEMO_CORE_PALETTE_SIZE * GB_DEMO_CORE_PALETTE_SIZE; i++)
+        {
+            tb_size_t index = data[i];
+            if (index == cleared) continue;
+
+            // find the coverage
+            for (a = 1; a < 256; a++)
+            {
+                if (index == gb_palette_index(palette, gb_demo_core_palette_blend(gb_palette_color(palette, cleared), color, a))) break;
+            }
+            if (index == gb_palette_index(palette, color)) a = 256;
+            else if (a < 256) partial++;
+            else failed++;
+            drawn++;
+        }
+
+        // the edges of the hairline are blended
+        if (!drawn || !partial) failed++;
+
+        // trace
+        tb_trace_i("hairline: drawn: %lu, partial: %lu, failed: %lu", drawn, partial, failed);
+
+    } while (0);
+
+    // restore quality
+    gb_quality_set(quality);
+
+    // exit canvas and bitmap
+    if (canvas) gb_canvas_exit(canvas);
+    if (bitmap) gb_bitmap_exit(bitmap);
+    return failed;
+}
+static tb_size_t gb_demo_core_palette_draw_bitmap(gb_palette_ref_t palette)
+{
+    // init bitmaps and canvas
+    tb_size_t       failed = 1;
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_PAL8, GB_DEMO_CORE_PALETTE_SIZE, GB_DEMO_CORE_PALETTE_SIZE, 0, tb_false);
+    gb_bitmap_ref_t source = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888 | GB_PIXFMT_NENDIAN, GB_DEMO_CORE_PALETTE_SIZE, GB_DEMO_CORE_PALETTE_SIZE, 0, tb_false);
+    gb_canvas_ref_t canvas = tb_null;
+    tb_size_t       quality = gb_quality();
+    do
+    {
+        // check
+        tb_check_break(bitmap && source);
+
+        // init canvas with the palette
+        gb_bitmap_palette_set(bitmap, palette);
+        canvas = gb_canvas_init_from_bitmap(bitmap);
+        tb_check_break(canvas);
+
+        // make the gradient source
+        tb_size_t           i = 0;
+        tb_size_t           x = 0;
+        tb_size_t           y = 0;
+        gb_pixmap_ref_t     pixmap = gb_pixmap(gb_bitmap_pixfmt(source), 0xff);
+        tb_byte_t*          sdata = (tb_byte_t*)gb_bitmap_data(source);
+        tb_assert_and_check_break(pixmap);
+        for (y = 0; y < GB_DEMO_CORE_PALETTE_SIZE; y++)
+        {
+            for (x = 0; x < GB_DEMO_CORE_PALETTE_SIZE; x++)
+                pixmap->color_set(sdata + y * gb_bitmap_row_bytes(source) + (x << 2), gb_color_make(0xff, (tb_byte_t)(x * 5), (tb_byte_t)(y * 5), (tb_byte_t)((x + y) * 2)));
+        }
+
+        // draw the source without filtering for the exact pixels
+        gb_quality_set(GB_QUALITY_LOW);
+        gb_canvas_draw_clear(canvas, GB_COLOR_BLACK);
+        gb_canvas_draw_bitmap(canvas, source, 0, 0);
+
+        // the pixel is the nearest index of the source color
+        tb_byte_t* data = (tb_byte_t*)gb_bitmap_data(bitmap);
+        for (failed = 0, i = 0; i < GB_DEMO_CORE_PALETTE_SIZE * GB_DEMO_CORE_PALETTE_SIZE; i++)
+        {
+            x = i % GB_DEMO_CORE_PALETTE_SIZE;
+            y = i / GB_DEMO_CORE_PALETTE_SIZE;
+            gb_color_t color = pixmap->color_get(sdata + y * gb_bitmap_row_bytes(source) + (x << 2));
+            if (data[y * gb_bitmap_row_bytes(bitmap) + x] != gb_palette_index(palette, color)) failed++;
+        }
+
+        // trace
+        tb_trace_i("bitmap: failed: %lu", failed);
+
+    } while (0);
+
+    // restore quality
+    gb_quality_set(quality);
+
+    // exit canvas and bitmaps
+    if (canvas) gb_canvas_exit(canvas);
+    if (source) gb_bitmap_exit(source);
+    if (bitmap) gb_bitmap_exit(bitmap);
+    return failed;
+}
+static tb_size_t gb_demo_core_palette_quantize(gb_palette_ref_t palette)
+{
+    // init bitmap
+    tb_size_t       failed = 1;
+    gb_palette_ref_t quantized = tb_null;
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888 | GB_PIXFMT_NENDIAN, GB_DEMO_CORE_PALETTE_SIZE, GB_DEMO_CORE_PALETTE_SIZE, 0, tb_false);
+    do
+    {
+        // check
+        tb_check_break(bitmap);
+
+        // make the pixels of the 16 colors of the palette
+        tb_size_t       i = 0;
+        gb_pixmap_ref_t pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), 0xff);
+        tb_byte_t*      data = (tb_byte_t*)gb_bitmap_data(bitmap);
+        tb_assert_and_check_break(pixmap);
+        for (i = 0; i < GB_DEMO_CORE_PALETTE_SIZE * GB_DEMO_CORE_PALETTE_SIZE; i++)
+            pixmap->color_set(data + (i / GB_DEMO_CORE_PALETTE_SIZE) * gb_bitmap_row_bytes(bitmap) + ((i % GB_DEMO_CORE_PALETTE_SIZE) << 2), gb_palette_color(palette, (i * 7 % 16) * 13));
+
+        // quantize it to 16 colors
+        quantized = gb_palette_init_from_bitmap(bitmap, 16);
+        tb_check_break(quantized);
+
+        // all colors are kept by the quantized palette
+        for (failed = 0, i = 0; i < 16; i++)
+        {
+            gb_color_t color = gb_palette_color(palette, i * 13);
+            gb_color_t found = gb_palette_color(quantized, gb_palette_index(quantized, color));
+            if (tb_abs(color.r - found.r) > 8 || tb_abs(color.g - found.g) > 8 || tb_abs(color.b - found.b) > 8) failed++;
+        }
+
+        // trace
+        tb_trace_i("quantize: colors: %lu, failed: %lu", gb_palette_size(quantized), failed);
+
+    } while (0);
+
+    // exit palette and bitmap
+    if (quantized) gb_palette_exit(quantized);
+    if (bitmap) gb_bitmap_exit(bitmap);
+    return failed;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_palette_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init palette
+    gb_palette_ref_t palette = gb_demo_core_palette_init();
+    tb_assert_and_check_return_val(palette, -1);
+
+    // no antialiasing and filtering for the exact pixels
+    tb_size_t quality = gb_quality();
+    gb_quality_set(GB_QUALITY_LOW);
+
+    // done
+    tb_size_t failed = 0;
+    failed += gb_demo_core_palette_lookup(palette);
+    failed += gb_demo_core_palette_fill(palette, GB_COLOR_BLACK, gb_color_make(0xff, 0xff, 0x00, 0x00), 0xff);
+    failed += gb_demo_core_palette_fill(palette, GB_COLOR_BLACK, gb_color_make(0xff, 0x40, 0xa0, 0xf0), 0xff);
+    failed += gb_demo_core_palette_fill(palette, GB_COLOR_BLACK, gb_color_make(0xff, 0xff, 0xff, 0xff), 0x80);
+    failed += gb_demo_core_palette_fill(palette, gb_color_make(0xff, 0x00, 0x66, 0xcc), gb_color_make(0xff, 0xff, 0x33, 0x00), 0x60);
+    failed += gb_demo_core_palette_hairline(palette, GB_COLOR_BLACK, GB_COLOR_WHITE);
+    failed += gb_demo_core_palette_draw_bitmap(palette);
+    failed += gb_demo_core_palette_quantize(palette);
+
+    // restore quality
+    gb_quality_set(quality);
+
+    // exit palette
+    gb_palette_exit(palette);
+
+    // trace
+    tb_trace_i("palette: failed: %lu", failed);
+
+    // check
+    if (failed) tb_abort();
+    return 0;
+}
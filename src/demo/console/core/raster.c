@@ -0,0 +1,168 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bitmap size
+#define GB_DEMO_CORE_RASTER_SIZE        (512)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static gb_path_ref_t gb_demo_core_raster_path(tb_size_t kind)
+{
+    // init path
+    gb_path_ref_t path = gb_path_init();
+    tb_assert_and_check_return_val(path, tb_null);
+
+    // the center and radius
+    tb_long_t x0 = tb_random_range(16, GB_DEMO_CORE_RASTER_SIZE - 16);
+    tb_long_t y0 = tb_random_range(16, GB_DEMO_CORE_RASTER_SIZE - 16);
+    tb_long_t r = tb_random_range(5, 15);
+
+    // make path
+    tb_size_t i = 0;
+    tb_size_t n = 0;
+    switch (kind)
+    {
+    case 0:
+        {
+            // the random self-intersecting polygon with many edges
+            n = tb_random_range(16, 64);
+            gb_path_move2i_to(path, x0 + tb_random_range(-r, r), y0 + tb_random_range(-r, r));
+            for (i = 1; i < n; i++) gb_path_line2i_to(path, x0 + tb_random_range(-r, r), y0 + tb_random_range(-r, r));
+            gb_path_clos(path);
+        }
+        break;
+    case 1:
+        {
+            // the flattened circle
+            n = 32;
+            gb_path_move2i_to(path, x0 + r, y0);
+            for (i = 1; i < n; i++) gb_path_line2i_to(path, x0 + (tb_long_t)(r * tb_cos(2 * TB_PI * i / n)), y0 + (tb_long_t)(r * tb_sin(2 * TB_PI * i / n)));
+            gb_path_clos(path);
+        }
+        break;
+    default:
+        {
+            // the simple polygon with few edges
+            n = tb_random_range(3, 8);
+            gb_path_move2i_to(path, x0 + tb_random_range(-r, r), y0 + tb_random_range(-r, r));
+            for (i = 1; i < n; i++) gb_path_line2i_to(path, x0 + tb_random_range(-r, r), y0 + tb_random_range(-r, r));
+            gb_path_clos(path);
+        }
+        break;
+    }
+
+    // ok
+    return path;
+}
+static tb_hong_t gb_demo_core_raster_draw(gb_canvas_ref_t canvas, gb_path_ref_t* paths, tb_size_t count, tb_size_t flag, tb_size_t rule)
+{
+    // clear it
+    gb_canvas_draw_clear(canvas, GB_COLOR_BLACK);
+
+    // init paint
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_flag_set(canvas, flag);
+    gb_canvas_fill_rule_set(canvas, rule);
+
+    // draw all paths with the different colors
+    tb_size_t i = 0;
+    tb_hong_t dt = tb_mclock();
+    for (i = 0; i < count; i++)
+    {
+        gb_canvas_color_set(canvas, gb_color_make(0xff, (tb_byte_t)(i * 7), (tb_byte_t)(i * 13), (tb_byte_t)(i * 29)));
+        gb_canvas_draw_path(canvas, paths[i]);
+    }
+    return tb_mclock() - dt;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_raster_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the paths count
+    tb_size_t count = argc > 1? tb_atoi(argv[1]) : 30000;
+    tb_assert_and_check_return_val(count, -1);
+
+    // init bitmaps, canvases and paths
+    tb_size_t       failed = 0;
+    gb_path_ref_t*  paths = tb_nalloc0_type(count, gb_path_ref_t);
+    gb_bitmap_ref_t bitmap_scan = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888 | GB_PIXFMT_NENDIAN, GB_DEMO_CORE_RASTER_SIZE, GB_DEMO_CORE_RASTER_SIZE, 0, tb_false);
+    gb_bitmap_ref_t bitmap_strip = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888 | GB_PIXFMT_NENDIAN, GB_DEMO_CORE_RASTER_SIZE, GB_DEMO_CORE_RASTER_SIZE, 0, tb_false);
+    gb_canvas_ref_t canvas_scan = bitmap_scan? gb_canvas_init_from_bitmap(bitmap_scan) : tb_null;
+    gb_canvas_ref_t canvas_strip = bitmap_strip? gb_canvas_init_from_bitmap(bitmap_strip) : tb_null;
+    tb_size_t       quality = gb_quality();
+    do
+    {
+        // check
+        tb_assert_and_check_break(paths && canvas_scan && canvas_strip);
+
+        // the polygon fills are aliased
+        gb_quality_set(GB_QUALITY_LOW);
+
+        // the many edges, circles and few edges
+        tb_size_t kind = 0;
+        for (kind = 0; kind < 3; kind++)
+        {
+            // make the same paths for the both rasters
+            tb_size_t i = 0;
+            tb_random_reset(tb_true);
+            for (i = 0; i < count; i++)
+            {
+                if (paths[i]) gb_path_exit(paths[i]);
+                paths[i] = gb_demo_core_raster_path(kind);
+                tb_assert_and_check_break(paths[i]);
+            }
+            tb_check_break(i == count);
+
+            // the odd and non-zero rules
+            tb_size_t rule = 0;
+            for (rule = GB_PAINT_FILL_RULE_ODD; rule <= GB_PAINT_FILL_RULE_NONZERO; rule++)
+            {
+                // draw them by the scanline and the sparse strip rasters
+                tb_hong_t dt_scan = gb_demo_core_raster_draw(canvas_scan, paths, count, GB_PAINT_FLAG_NONE, rule);
+                tb_hong_t dt_strip = gb_demo_core_raster_draw(canvas_strip, paths, count, GB_PAINT_FLAG_SPARSE_RASTER, rule);
+
+                // the output pixels are identical
+                tb_bool_t same = !tb_memcmp(gb_bitmap_data(bitmap_scan), gb_bitmap_data(bitmap_strip), gb_bitmap_row_bytes(bitmap_scan) * GB_DEMO_CORE_RASTER_SIZE);
+                if (!same) failed++;
+
+                // trace
+                tb_trace_i("kind: %lu, rule: %lu, paths: %lu, scanline: %lld ms, strip: %lld ms, same: %s", kind, rule, count, dt_scan, dt_strip, same? "ok" : "no");
+            }
+        }
+        if (kind < 3) failed++;
+
+    } while (0);
+
+    // restore quality
+    gb_quality_set(quality);
+
+    // exit paths
+    if (paths)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++) if (paths[i]) gb_path_exit(paths[i]);
+        tb_free(paths);
+    }
+
+    // exit canvases and bitmaps
+    if (canvas_scan) gb_canvas_exit(canvas_scan);
+    if (canvas_strip) gb_canvas_exit(canvas_strip);
+    if (bitmap_scan) gb_bitmap_exit(bitmap_scan);
+    if (bitmap_strip) gb_bitmap_exit(bitmap_strip);
+
+    // trace
+    tb_trace_i("raster: failed: %lu", failed);
+
+    // check
+    if (failed) tb_abort();
+    return 0;
+}
@@ -36,10 +36,18 @@ static gb_demo_t g_demo[] =
     GB_DEMO_MAIN_ITEM(core_path)
 ,   GB_DEMO_MAIN_ITEM(core_bitmap)
 ,   GB_DEMO_MAIN_ITEM(core_vector)
+,   GB_DEMO_MAIN_ITEM(core_blend)
+,   GB_DEMO_MAIN_ITEM(core_dither)
+,   GB_DEMO_MAIN_ITEM(core_palette)
+,   GB_DEMO_MAIN_ITEM(core_raster)
+,   GB_DEMO_MAIN_ITEM(core_batch)
+,   GB_DEMO_MAIN_ITEM(core_mask)
 
     // utils
 ,   GB_DEMO_MAIN_ITEM(utils_mesh)
 ,   GB_DEMO_MAIN_ITEM(utils_geometry)
+,   GB_DEMO_MAIN_ITEM(utils_tessellator)
+,   GB_DEMO_MAIN_ITEM(utils_tessellation)
 
     // ohter
 ,   GB_DEMO_MAIN_ITEM(other_test)
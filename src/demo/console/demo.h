@@ -45,10 +45,18 @@
 GB_DEMO_MAIN_DECL(core_path);
 GB_DEMO_MAIN_DECL(core_bitmap);
 GB_DEMO_MAIN_DECL(core_vector);
+GB_DEMO_MAIN_DECL(core_blend);
+GB_DEMO_MAIN_DECL(core_dither);
+GB_DEMO_MAIN_DECL(core_palette);
+GB_DEMO_MAIN_DECL(core_raster);
+GB_DEMO_MAIN_DECL(core_batch);
+GB_DEMO_MAIN_DECL(core_mask);
 
 // utils
 GB_DEMO_MAIN_DECL(utils_mesh);
 GB_DEMO_MAIN_DECL(utils_geometry);
+GB_DEMO_MAIN_DECL(utils_tessellator);
+GB_DEMO_MAIN_DECL(utils_tessellation);
 
 // other
 GB_DEMO_MAIN_DECL(other_test);
@@ -0,0 +1,236 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum points count of the contour
+#define GB_DEMO_UTILS_TESSELLATION_MAXN         (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the tessellation result type
+typedef struct __gb_demo_utils_tessellation_result_t
+{
+    // the contour
+    gb_point_ref_t          points;
+
+    // the points count of the contour
+    tb_size_t               count;
+
+    // the polygons count, not including the polygons of the guard contour
+    tb_size_t               polygons;
+
+    // the area * 2 of all polygons, fixed 32.32
+    tb_hong_t               area;
+
+    // the count of the output points which are not the points of the contour
+    tb_size_t               unknown;
+
+}gb_demo_utils_tessellation_result_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_void_t gb_demo_utils_tessellation_func(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_demo_utils_tessellation_result_t* result = (gb_demo_utils_tessellation_result_t*)priv;
+    tb_assert_and_check_return(result && points && count);
+
+    // skip the polygon of the guard contour at the negative coordinates
+    tb_check_return(points[0].x >= 0);
+
+    // update the polygons count
+    result->polygons++;
+
+    // the output points need be the points of the contour for the simple polygon
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    for (i = 0; i < count; i++)
+    {
+        for (j = 0; j < result->count; j++)
+            if (points[i].x == result->points[j].x && points[i].y == result->points[j].y) break;
+        if (j == result->count) result->unknown++;
+    }
+
+    // update the area using the fixed cross products relative to the first point, it is exact for the integer points
+    tb_long_t   x0 = gb_float_to_fixed(points[0].x);
+    tb_long_t   y0 = gb_float_to_fixed(points[0].y);
+    tb_hong_t   area = 0;
+    for (i = 2; i < count; i++)
+    {
+        tb_hong_t dx1 = gb_float_to_fixed(points[i - 1].x) - x0;
+        tb_hong_t dy1 = gb_float_to_fixed(points[i - 1].y) - y0;
+        tb_hong_t dx2 = gb_float_to_fixed(points[i].x) - x0;
+        tb_hong_t dy2 = gb_float_to_fixed(points[i].y) - y0;
+        area += dx1 * dy2 - dx2 * dy1;
+    }
+    result->area += tb_abs(area);
+}
+static tb_size_t gb_demo_utils_tessellation_contour(gb_point_ref_t points, tb_size_t shape)
+{
+    // make contour
+    tb_size_t i = 0;
+    tb_size_t n = 0;
+    switch (shape)
+    {
+    case 0:
+        {
+            /* the y-monotone comb, it is not convex
+             *
+             *  ___
+             *  \  |
+             *  /  |
+             *  \  |
+             *  /__|
+             */
+            gb_point_imake(&points[n++], 100, 0);
+            gb_point_imake(&points[n++], 100, 200);
+            for (i = 0; i <= 20; i++) gb_point_imake(&points[n++], (i & 1)? 40 : 0, 200 - i * 10);
+        }
+        break;
+    case 1:
+        {
+            // the star with 10 spikes, it is simple but not monotone
+            for (i = 0; i < 20; i++)
+            {
+                tb_double_t a = 2 * TB_PI * i / 20;
+                tb_long_t   r = (i & 1)? 40 : 100;
+                gb_point_imake(&points[n++], 100 + (tb_long_t)(r * tb_cos(a)), 100 + (tb_long_t)(r * tb_sin(a)));
+            }
+        }
+        break;
+    default:
+        {
+            // the concave u-shape with the notches, it is simple but not monotone
+            gb_point_imake(&points[n++], 0, 0);
+            gb_point_imake(&points[n++], 40, 0);
+            for (i = 1; i < 8; i++)
+            {
+                gb_point_imake(&points[n++], 40 + (i & 1) * 5, i * 20);
+            }
+            gb_point_imake(&points[n++], 40, 160);
+            gb_point_imake(&points[n++], 160, 160);
+            gb_point_imake(&points[n++], 160, 0);
+            gb_point_imake(&points[n++], 200, 0);
+            gb_point_imake(&points[n++], 200, 200);
+            gb_point_imake(&points[n++], 0, 200);
+        }
+        break;
+    }
+
+    // close it
+    points[n] = points[0];
+    return n + 1;
+}
+static tb_bool_t gb_demo_utils_tessellation_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, gb_demo_utils_tessellation_result_t* result, tb_size_t loop, tb_hong_t* ptime)
+{
+    // done tessellator for the result
+    gb_tessellator_func_set(tessellator, gb_demo_utils_tessellation_func, result);
+    gb_tessellator_stats_enable(tessellator, tb_true);
+    gb_tessellator_done(tessellator, polygon, bounds);
+
+    // it is tessellated by the simple path if no events are swept
+    gb_tessellator_stats_ref_t  stats = gb_tessellator_stats(tessellator);
+    tb_bool_t                   simple = stats && !stats->events;
+    gb_tessellator_stats_enable(tessellator, tb_false);
+
+    // done tessellator for the time
+    gb_demo_utils_tessellation_result_t ignored = *result;
+    gb_tessellator_func_set(tessellator, gb_demo_utils_tessellation_func, &ignored);
+    tb_hong_t dt = tb_mclock();
+    while (loop--) gb_tessellator_done(tessellator, polygon, bounds);
+    *ptime = tb_mclock() - dt;
+
+    // simple?
+    return simple;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_utils_tessellation_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the loop count for the time
+    tb_size_t loop = argc > 1? tb_atoi(argv[1]) : 20000;
+    tb_assert_and_check_return_val(loop, -1);
+
+    // init tessellator
+    gb_tessellator_ref_t tessellator = gb_tessellator_init();
+    tb_assert_and_check_return_val(tessellator, -1);
+
+    // done
+    tb_size_t   failed = 0;
+    tb_size_t   shape = 0;
+    tb_size_t   mode = 0;
+    gb_point_t  points[GB_DEMO_UTILS_TESSELLATION_MAXN + 4];
+    for (shape = 0; shape < 3; shape++)
+    {
+        // make the contour and the guard triangle at the negative coordinates
+        tb_size_t count = gb_demo_utils_tessellation_contour(points, shape);
+        gb_point_imake(&points[count], -100, -100);
+        gb_point_imake(&points[count + 1], -90, -100);
+        gb_point_imake(&points[count + 2], -100, -90);
+        points[count + 3] = points[count];
+
+        /* the simple polygon with the single contour and the same polygon with the guard contour
+         *
+         * the simple path only tessellates the single contour,
+         * so the guard contour makes it go through the general path and its polygons are skipped
+         */
+        tb_uint16_t     counts_simple[] = {(tb_uint16_t)count, 0};
+        tb_uint16_t     counts_general[] = {(tb_uint16_t)count, 4, 0};
+        gb_polygon_t    polygon_simple = {points, counts_simple, tb_false};
+        gb_polygon_t    polygon_general = {points, counts_general, tb_false};
+
+        // make bounds
+        gb_rect_t bounds_simple;
+        gb_rect_t bounds_general;
+        gb_rect_imake(&bounds_simple, 0, 0, 200, 200);
+        gb_rect_imake(&bounds_general, -100, -100, 300, 300);
+
+        // the convex, monotone and triangulation modes
+        for (mode = GB_TESSELLATOR_MODE_CONVEX; mode <= GB_TESSELLATOR_MODE_TRIANGULATION; mode++)
+        {
+            // done tessellator
+            tb_hong_t                           dt_simple = 0;
+            tb_hong_t                           dt_general = 0;
+            gb_demo_utils_tessellation_result_t result_simple = {points, count - 1, 0, 0, 0};
+            gb_demo_utils_tessellation_result_t result_general = {points, count - 1, 0, 0, 0};
+            gb_tessellator_mode_set(tessellator, mode);
+            tb_bool_t simple = gb_demo_utils_tessellation_done(tessellator, &polygon_simple, &bounds_simple, &result_simple, loop, &dt_simple);
+            gb_demo_utils_tessellation_done(tessellator, &polygon_general, &bounds_general, &result_general, loop, &dt_general);
+
+            /* the both paths cover the same area without the new points,
+             * and the triangles count is the points count - 2
+             */
+            tb_bool_t ok =      result_simple.polygons && result_general.polygons
+                            &&  result_simple.area == result_general.area
+                            &&  !result_simple.unknown && !result_general.unknown;
+            if (mode == GB_TESSELLATOR_MODE_TRIANGULATION)
+                ok = ok && result_simple.polygons == count - 3 && result_general.polygons == count - 3;
+            if (!ok) failed++;
+
+            // trace
+            tb_trace_i("shape: %lu, mode: %lu, fast: %s, polygons: %lu => %lu, area: %lld => %lld, simple: %lld ms, general: %lld ms, ok: %s"
+                    , shape, mode, simple? "yes" : "no", result_simple.polygons, result_general.polygons
+                    , result_simple.area >> 33, result_general.area >> 33, dt_simple, dt_general, ok? "ok" : "no");
+        }
+    }
+
+    // exit tessellator
+    gb_tessellator_exit(tessellator);
+
+    // trace
+    tb_trace_i("tessellation: failed: %lu", failed);
+
+    // check
+    if (failed) tb_abort();
+    return 0;
+}
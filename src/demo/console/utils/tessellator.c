@@ -0,0 +1,223 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the tessellator result type
+typedef struct __gb_demo_utils_tessellator_result_t
+{
+    // the polygons count
+    tb_size_t               count;
+
+    // the area * 2 of all polygons, fixed 32.32
+    tb_hong_t               area;
+
+    // the points of all polygons
+    gb_point_ref_t          points;
+
+    // the points count
+    tb_size_t               points_size;
+
+    // the points maxn
+    tb_size_t               points_maxn;
+
+    // the points count of all polygons
+    tb_uint16_t*            counts;
+
+    // the counts maxn
+    tb_size_t               counts_maxn;
+
+}gb_demo_utils_tessellator_result_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_void_t gb_demo_utils_tessellator_func(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_demo_utils_tessellator_result_t* result = (gb_demo_utils_tessellator_result_t*)priv;
+    tb_assert_and_check_return(result && points && count);
+
+    // grow the points and counts
+    if (result->points_size + count > result->points_maxn)
+    {
+        result->points_maxn = (result->points_size + count) << 1;
+        result->points = (gb_point_ref_t)tb_ralloc(result->points, result->points_maxn * sizeof(gb_point_t));
+        tb_assert_and_check_return(result->points);
+    }
+    if (result->count + 1 > result->counts_maxn)
+    {
+        result->counts_maxn = (result->count + 1) << 1;
+        result->counts = (tb_uint16_t*)tb_ralloc(result->counts, result->counts_maxn * sizeof(tb_uint16_t));
+        tb_assert_and_check_return(result->counts);
+    }
+
+    // save the points and count of this polygon
+    tb_memcpy(result->points + result->points_size, points, count * sizeof(gb_point_t));
+    result->points_size += count;
+    result->counts[result->count] = count;
+
+    // update the polygons count
+    result->count++;
+
+    // update the area using the fixed cross products relative to the first point, it is exact for the float and fixed
+    tb_size_t   i = 0;
+    tb_long_t   x0 = gb_float_to_fixed(points[0].x);
+    tb_long_t   y0 = gb_float_to_fixed(points[0].y);
+    tb_hong_t   area = 0;
+    for (i = 2; i < count; i++)
+    {
+        tb_hong_t dx1 = gb_float_to_fixed(points[i - 1].x) - x0;
+        tb_hong_t dy1 = gb_float_to_fixed(points[i - 1].y) - y0;
+        tb_hong_t dx2 = gb_float_to_fixed(points[i].x) - x0;
+        tb_hong_t dy2 = gb_float_to_fixed(points[i].y) - y0;
+        area += dx1 * dy2 - dx2 * dy1;
+    }
+    result->area += tb_abs(area);
+}
+static gb_polygon_ref_t gb_demo_utils_tessellator_islands(gb_polygon_ref_t polygon, tb_size_t islands, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(polygon && islands && count >= 3, tb_null);
+
+    // make points and counts, the outer contour and the hole of every island
+    polygon->points     = tb_nalloc_type((count + 1) * islands * 2, gb_point_t);
+    polygon->counts     = tb_nalloc_type(islands * 2 + 1, tb_uint16_t);
+    polygon->convex     = tb_false;
+    tb_assert_and_check_return_val(polygon->points && polygon->counts, tb_null);
+
+    /* make islands
+     *
+     *  _/\/\_      _/\/\_
+     *  >  _  <     >  _  <
+     *  > (_) <     > (_) <    ...
+     *  -\/\/-      -\/\/-
+     *
+     */
+    tb_size_t       i = 0;
+    tb_size_t       j = 0;
+    gb_float_t      step = gb_lsh(gb_idiv(GB_PI, count), 1);
+    gb_point_ref_t  points = polygon->points;
+    for (i = 0; i < islands; i++)
+    {
+        // the center of this island
+        gb_float_t x = gb_long_to_float(60 + (i & 7) * 100);
+        gb_float_t y = gb_long_to_float(60 + (i >> 3) * 100);
+
+        // make the star-shaped outer contour
+        gb_point_ref_t head = points;
+        for (j = 0; j < count; j++)
+        {
+            gb_float_t c;
+            gb_float_t s;
+            gb_sincos(gb_imul(step, j), &s, &c);
+            tb_long_t r = (j & 1)? 30 : 45;
+            gb_point_make(points++, x + gb_imul(c, r), y + gb_imul(s, r));
+        }
+        *points++ = *head;
+        polygon->counts[i << 1] = (tb_uint16_t)(count + 1);
+
+        // make the round hole with the reverse direction
+        head = points;
+        for (j = 0; j < count; j++)
+        {
+            gb_float_t c;
+            gb_float_t s;
+            gb_sincos(gb_imul(step, count - j), &s, &c);
+            gb_point_make(points++, x + gb_imul(c, 10), y + gb_imul(s, 10));
+        }
+        *points++ = *head;
+        polygon->counts[(i << 1) + 1] = (tb_uint16_t)(count + 1);
+    }
+    polygon->counts[islands << 1] = 0;
+
+    // ok
+    return polygon;
+}
+static tb_void_t gb_demo_utils_tessellator_exit(gb_demo_utils_tessellator_result_t* result)
+{
+    // exit the points and counts
+    if (result->points) tb_free(result->points);
+    if (result->counts) tb_free(result->counts);
+    tb_memset(result, 0, sizeof(gb_demo_utils_tessellator_result_t));
+}
+static tb_bool_t gb_demo_utils_tessellator_same(gb_demo_utils_tessellator_result_t const* result1, gb_demo_utils_tessellator_result_t const* result2)
+{
+    // the same polygons with the same points in the same order?
+    return      result1->count == result2->count
+            &&  result1->area == result2->area
+            &&  result1->points_size == result2->points_size
+            &&  (!result1->count || !tb_memcmp(result1->counts, result2->counts, result1->count * sizeof(tb_uint16_t)))
+            &&  (!result1->points_size || !tb_memcmp(result1->points, result2->points, result1->points_size * sizeof(gb_point_t)));
+}
+static tb_void_t gb_demo_utils_tessellator_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t threads, gb_demo_utils_tessellator_result_t* result)
+{
+    // clear result
+    tb_memset(result, 0, sizeof(gb_demo_utils_tessellator_result_t));
+
+    // init func and threads
+    gb_tessellator_func_set(tessellator, gb_demo_utils_tessellator_func, result);
+    gb_tessellator_threads_set(tessellator, threads);
+
+    // done tessellator
+    tb_hong_t dt = tb_mclock();
+    gb_tessellator_done(tessellator, polygon, bounds);
+    dt = tb_mclock() - dt;
+
+    // trace
+    tb_trace_i("threads: %lu, polygons: %lu, area: %lld, time: %lld ms", threads, result->count, result->area >> 33, dt);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_utils_tessellator_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the islands count, the points count of every contour and the threads count
+    tb_size_t islands   = argc > 1? tb_atoi(argv[1]) : 40;
+    tb_size_t count     = argc > 2? tb_atoi(argv[2]) : 200;
+    tb_size_t threads   = argc > 3? tb_atoi(argv[3]) : 4;
+    tb_assert_and_check_return_val(islands && islands <= 2048 && count >= 3 && count < TB_MAXU16 && threads, -1);
+
+    // init tessellator
+    gb_polygon_t            polygon = {0};
+    gb_tessellator_ref_t    tessellator = gb_tessellator_init();
+    if (tessellator && gb_demo_utils_tessellator_islands(&polygon, islands, count))
+    {
+        // make bounds
+        gb_rect_t bounds;
+        gb_rect_make(&bounds, 0, 0, gb_long_to_float(820), gb_long_to_float(((islands + 7) >> 3) * 100 + 20));
+
+        // the triangulation mode
+        gb_tessellator_mode_set(tessellator, GB_TESSELLATOR_MODE_TRIANGULATION);
+
+        // done it with one thread and the given threads
+        gb_demo_utils_tessellator_result_t result1;
+        gb_demo_utils_tessellator_result_t resultn;
+        gb_demo_utils_tessellator_done(tessellator, &polygon, &bounds, 1, &result1);
+        gb_demo_utils_tessellator_done(tessellator, &polygon, &bounds, threads, &resultn);
+
+        // the outputs are same for any threads count
+        tb_bool_t same = gb_demo_utils_tessellator_same(&result1, &resultn);
+        tb_trace_i("same: %s", same? "ok" : "no");
+
+        // exit results
+        gb_demo_utils_tessellator_exit(&result1);
+        gb_demo_utils_tessellator_exit(&resultn);
+
+        // check
+        if (!same) tb_abort();
+    }
+
+    // exit polygon
+    if (polygon.points) tb_free(polygon.points);
+    if (polygon.counts) tb_free(polygon.counts);
+
+    // exit tessellator
+    if (tessellator) gb_tessellator_exit(tessellator);
+    return 0;
+}
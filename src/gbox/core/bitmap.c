@@ -61,6 +61,9 @@ typedef struct __gb_bitmap_impl_t
 	// the lpitch
 	tb_uint16_t         row_bytes;
 
+	// the palette, only for pal8
+	gb_palette_ref_t    palette;
+
 }gb_bitmap_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -322,3 +325,21 @@ tb_size_t gb_bitmap_row_bytes(gb_bitmap_ref_t bitmap)
     // the row bytes
 	return impl->row_bytes;
 }
+gb_palette_ref_t gb_bitmap_palette(gb_bitmap_ref_t bitmap)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return_val(impl, tb_null);
+
+    // the palette
+	return impl->palette;
+}
+tb_void_t gb_bitmap_palette_set(gb_bitmap_ref_t bitmap, gb_palette_ref_t palette)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return(impl && GB_PIXFMT(impl->pixfmt) == GB_PIXFMT(GB_PIXFMT_PAL8));
+
+    // done
+    impl->palette = palette;
+}
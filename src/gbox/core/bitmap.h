@@ -164,6 +164,23 @@ tb_void_t           gb_bitmap_set_alpha(gb_bitmap_ref_t bitmap, tb_bool_t has_al
  */
 tb_size_t           gb_bitmap_row_bytes(gb_bitmap_ref_t bitmap);
 
+/*! the bitmap palette
+ *
+ * @param bitmap    the bitmap
+ *
+ * @return          the palette, return tb_null if no palette
+ */
+gb_palette_ref_t    gb_bitmap_palette(gb_bitmap_ref_t bitmap);
+
+/*! set the bitmap palette, only for the pal8 bitmap
+ *
+ * the palette will not be exited with the bitmap and must be kept until the bitmap is exited
+ *
+ * @param bitmap    the bitmap
+ * @param palette   the palette
+ */
+tb_void_t           gb_bitmap_palette_set(gb_bitmap_ref_t bitmap, gb_palette_ref_t palette);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
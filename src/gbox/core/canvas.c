@@ -37,8 +37,10 @@
 #include "device.h"
 #include "path.h"
 #include "paint.h"
+#include "bitmap.h"
 #include "clipper.h"
 #include "impl/bounds.h"
+#include "impl/geometry.h"
 #include "impl/cache_stack.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -448,6 +450,10 @@ tb_void_t gb_canvas_flag_set(gb_canvas_ref_t canvas, tb_size_t flag)
 {
     gb_paint_flag_set(gb_canvas_paint(canvas), flag);
 }
+tb_void_t gb_canvas_blend_set(gb_canvas_ref_t canvas, tb_size_t blend)
+{
+    gb_paint_blend_set(gb_canvas_paint(canvas), blend);
+}
 tb_void_t gb_canvas_color_set(gb_canvas_ref_t canvas, gb_color_t color)
 {
     gb_paint_color_set(gb_canvas_paint(canvas), color);
@@ -845,6 +851,15 @@ tb_void_t gb_canvas_draw_path(gb_canvas_ref_t canvas, gb_path_ref_t path)
     // draw path
     gb_device_draw_path(impl->device, path);
 }
+tb_void_t gb_canvas_draw_path_instances(gb_canvas_ref_t canvas, gb_path_ref_t path, gb_matrix_ref_t matrices, tb_size_t count)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && path && matrices);
+
+    // draw the instances of path
+    gb_device_draw_path_instances(impl->device, path, matrices, count);
+}
 tb_void_t gb_canvas_draw_point(gb_canvas_ref_t canvas, gb_point_ref_t point)
 {
     // check
@@ -993,19 +1008,9 @@ tb_void_t gb_canvas_draw_rect(gb_canvas_ref_t canvas, gb_rect_ref_t rect)
 
     // init polygon
     gb_point_t      points[5];
-    tb_uint16_t     counts[] = {5, 0};
+    tb_uint16_t     counts[2];
     gb_polygon_t    polygon = {points, counts, tb_true};
-
-    // init points
-    points[0].x = rect->x;
-    points[0].y = rect->y;
-    points[1].x = rect->x + rect->w;
-    points[1].y = rect->y;
-    points[2].x = rect->x + rect->w;
-    points[2].y = rect->y + rect->h;
-    points[3].x = rect->x;
-    points[3].y = rect->y + rect->h;
-    points[4] = points[0];
+    gb_geometry_make_rect_polygon(&polygon, rect);
 
     // init hint
     gb_shape_t      hint;
@@ -1033,6 +1038,22 @@ tb_void_t gb_canvas_draw_rect2i(gb_canvas_ref_t canvas, tb_long_t x, tb_long_t y
     // draw rect
     gb_canvas_draw_rect(canvas, &rect);
 }
+tb_void_t gb_canvas_draw_rects(gb_canvas_ref_t canvas, gb_rect_ref_t rects, tb_size_t count)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && rects);
+
+    // empty?
+    tb_check_return(count);
+
+    // init bounds
+    gb_rect_t bounds;
+    gb_bounds_make_for_rects(&bounds, rects, count);
+
+    // draw rects
+    gb_device_draw_rects(impl->device, rects, count, &bounds);
+}
 tb_void_t gb_canvas_draw_round_rect(gb_canvas_ref_t canvas, gb_round_rect_ref_t rect)
 {
     // check
@@ -1128,6 +1149,22 @@ tb_void_t gb_canvas_draw_circle2i(gb_canvas_ref_t canvas, tb_long_t x0, tb_long_
     // draw circle
     gb_canvas_draw_circle(canvas, &circle);
 }
+tb_void_t gb_canvas_draw_circles(gb_canvas_ref_t canvas, gb_circle_ref_t circles, tb_size_t count)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && circles);
+
+    // empty?
+    tb_check_return(count);
+
+    // init bounds
+    gb_rect_t bounds;
+    gb_bounds_make_for_circles(&bounds, circles, count);
+
+    // draw circles
+    gb_device_draw_circles(impl->device, circles, count, &bounds);
+}
 tb_void_t gb_canvas_draw_ellipse(gb_canvas_ref_t canvas, gb_ellipse_ref_t ellipse)
 {
     // check
@@ -1193,3 +1230,32 @@ tb_void_t gb_canvas_draw_points(gb_canvas_ref_t canvas, gb_point_ref_t points, t
     // draw points
     gb_device_draw_points(impl->device, points, count, tb_null);
 }
+tb_void_t gb_canvas_draw_bitmap(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, gb_float_t x, gb_float_t y)
+{
+    // check
+    tb_assert_and_check_return(bitmap);
+
+    // make rect
+    gb_rect_t rect;
+    gb_rect_make(&rect, x, y, gb_long_to_float((tb_long_t)gb_bitmap_width(bitmap)), gb_long_to_float((tb_long_t)gb_bitmap_height(bitmap)));
+
+    // draw bitmap
+    gb_canvas_draw_bitmap_rect(canvas, bitmap, tb_null, &rect);
+}
+tb_void_t gb_canvas_draw_bitmap_rect(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && bitmap && dst_rect);
+
+    // the whole bitmap
+    gb_rect_t rect;
+    if (!src_rect)
+    {
+        gb_rect_imake(&rect, 0, 0, gb_bitmap_width(bitmap), gb_bitmap_height(bitmap));
+        src_rect = &rect;
+    }
+
+    // draw bitmap
+    gb_device_draw_bitmap(impl->device, bitmap, src_rect, dst_rect);
+}
@@ -240,6 +240,13 @@ tb_void_t           gb_canvas_mode_set(gb_canvas_ref_t canvas, tb_size_t mode);
  */
 tb_void_t           gb_canvas_flag_set(gb_canvas_ref_t canvas, tb_size_t flag);
 
+/*! set the paint blend mode 
+ *
+ * @param canvas    the canvas
+ * @param blend     the paint blend mode
+ */
+tb_void_t           gb_canvas_blend_set(gb_canvas_ref_t canvas, tb_size_t blend);
+
 /*! set the paint color 
  *
  * @param canvas    the canvas
@@ -875,6 +882,18 @@ tb_void_t           gb_canvas_draw(gb_canvas_ref_t canvas);
  */
 tb_void_t           gb_canvas_draw_path(gb_canvas_ref_t canvas, gb_path_ref_t path);
 
+/*! draw the instances of the given path
+ *
+ * the path is drawn once for each matrix which is applied before the canvas matrix,
+ * and the paint and the device state are only bound once for all instances
+ *
+ * @param canvas    the canvas
+ * @param path      the path
+ * @param matrices  the matrices of all instances
+ * @param count     the instances count
+ */
+tb_void_t           gb_canvas_draw_path_instances(gb_canvas_ref_t canvas, gb_path_ref_t path, gb_matrix_ref_t matrices, tb_size_t count);
+
 /*! draw point
  *
  * @param canvas    the canvas
@@ -1014,6 +1033,14 @@ tb_void_t           gb_canvas_draw_rect2(gb_canvas_ref_t canvas, gb_float_t x, g
  */
 tb_void_t           gb_canvas_draw_rect2i(gb_canvas_ref_t canvas, tb_long_t x, tb_long_t y, tb_size_t w, tb_size_t h);
 
+/*! draw rects
+ *
+ * @param canvas    the canvas
+ * @param rects     the rects
+ * @param count     the rects count
+ */
+tb_void_t           gb_canvas_draw_rects(gb_canvas_ref_t canvas, gb_rect_ref_t rects, tb_size_t count);
+
 /*! draw round rect
  *
  * @param canvas    the canvas
@@ -1064,6 +1091,14 @@ tb_void_t           gb_canvas_draw_circle2(gb_canvas_ref_t canvas, gb_float_t x0
  */
 tb_void_t           gb_canvas_draw_circle2i(gb_canvas_ref_t canvas, tb_long_t x0, tb_long_t y0, tb_size_t r);
 
+/*! draw circles
+ *
+ * @param canvas    the canvas
+ * @param circles   the circles
+ * @param count     the circles count
+ */
+tb_void_t           gb_canvas_draw_circles(gb_canvas_ref_t canvas, gb_circle_ref_t circles, tb_size_t count);
+
 /*! draw ellipse
  *
  * @param canvas    the canvas
@@ -1114,6 +1149,26 @@ tb_void_t           gb_canvas_draw_lines(gb_canvas_ref_t canvas, gb_point_ref_t
  */
 tb_void_t           gb_canvas_draw_points(gb_canvas_ref_t canvas, gb_point_ref_t points, tb_size_t count);
 
+/*! draw bitmap at (x, y)
+ *
+ * @param canvas    the canvas
+ * @param bitmap    the bitmap
+ * @param x         the x-coordinate
+ * @param y         the y-coordinate
+ */
+tb_void_t           gb_canvas_draw_bitmap(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, gb_float_t x, gb_float_t y);
+
+/*! draw bitmap from the source rect to the destination rect
+ *
+ * the bitmap will be filtered if GB_PAINT_FLAG_FILTER_BITMAP is enabled
+ *
+ * @param canvas    the canvas
+ * @param bitmap    the bitmap
+ * @param src_rect  the source rect of the bitmap, draw the whole bitmap if be null
+ * @param dst_rect  the destination rect
+ */
+tb_void_t           gb_canvas_draw_bitmap_rect(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -34,6 +34,7 @@
 #include "shader.h"
 #include "pixmap.h"
 #include "bitmap.h"
+#include "palette.h"
 #include "canvas.h"
 #include "device.h"
 #include "clipper.h"
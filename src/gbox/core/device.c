@@ -37,6 +37,7 @@
 #include "device/prefix.h"
 #include "path.h"
 #include "paint.h"
+#include "impl/geometry.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
@@ -250,4 +251,127 @@ tb_void_t gb_device_draw_polygon(gb_device_ref_t device, gb_polygon_ref_t polygo
     // draw polygon
     impl->draw_polygon(impl, polygon, hint, bounds);
 }
+tb_void_t gb_device_draw_rects(gb_device_ref_t device, gb_rect_ref_t rects, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl && rects);
+
+    // empty?
+    tb_check_return(count);
+
+    // draw rects
+    if (impl->draw_rects) impl->draw_rects(impl, rects, count, bounds);
+    else
+    {
+        // init polygon
+        gb_point_t      points[5];
+        tb_uint16_t     counts[2];
+        gb_polygon_t    polygon = {points, counts, tb_true};
+
+        // init hint
+        gb_shape_t      hint;
+        hint.type       = GB_SHAPE_TYPE_RECT;
+
+        // draw the polygon for each rect
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            // the rect
+            gb_rect_ref_t rect = &rects[i];
+
+            // make polygon
+            gb_geometry_make_rect_polygon(&polygon, rect);
+
+            // make hint
+            hint.u.rect = *rect;
+
+            // draw it
+            gb_device_draw_polygon(device, &polygon, &hint, rect);
+        }
+    }
+}
+tb_void_t gb_device_draw_circles(gb_device_ref_t device, gb_circle_ref_t circles, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl && circles);
+
+    // empty?
+    tb_check_return(count);
+
+    // draw circles
+    if (impl->draw_circles) impl->draw_circles(impl, circles, count, bounds);
+    else
+    {
+        // init path
+        gb_path_ref_t path = gb_path_init();
+        tb_assert_and_check_return(path);
+
+        // draw the path for each circle
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            // make circle
+            gb_path_clear(path);
+            gb_path_add_circle(path, &circles[i], GB_ROTATE_DIRECTION_CW);
+
+            // draw it
+            gb_device_draw_path(device, path);
+        }
+
+        // exit path
+        gb_path_exit(path);
+    }
+}
+tb_void_t gb_device_draw_path_instances(gb_device_ref_t device, gb_path_ref_t path, gb_matrix_ref_t matrices, tb_size_t count)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl && impl->matrix && path && matrices);
+
+    // empty?
+    tb_check_return(count && !gb_path_null(path));
+
+    // draw the instances of path
+    if (impl->draw_path_instances) impl->draw_path_instances(impl, path, matrices, count);
+    else
+    {
+        // save matrix
+        gb_matrix_ref_t matrix = impl->matrix;
+
+        // draw the path for each instance
+        tb_size_t   i = 0;
+        gb_matrix_t applied;
+        for (i = 0; i < count; i++)
+        {
+            // apply the matrix of this instance
+            applied = *matrix;
+            gb_matrix_multiply(&applied, &matrices[i]);
+            impl->matrix = &applied;
+
+            // draw it
+            gb_device_draw_path(device, path);
+        }
+
+        // restore matrix
+        impl->matrix = matrix;
+    }
+}
+tb_void_t gb_device_draw_bitmap(gb_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl && bitmap && src_rect && dst_rect);
+
+    // no draw_bitmap?
+    if (!impl->draw_bitmap)
+    {
+        tb_trace_noimpl();
+        return ;
+    }
+
+    // draw bitmap
+    impl->draw_bitmap(impl, bitmap, src_rect, dst_rect);
+}
 
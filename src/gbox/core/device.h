@@ -191,6 +191,42 @@ tb_void_t           gb_device_draw_points(gb_device_ref_t device, gb_point_ref_t
  */
 tb_void_t           gb_device_draw_polygon(gb_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds);
 
+/*! draw rects
+ *
+ * @param device    the device
+ * @param rects     the rects
+ * @param count     the rects count
+ * @param bounds    the bounds of all rects
+ */
+tb_void_t           gb_device_draw_rects(gb_device_ref_t device, gb_rect_ref_t rects, tb_size_t count, gb_rect_ref_t bounds);
+
+/*! draw circles
+ *
+ * @param device    the device
+ * @param circles   the circles
+ * @param count     the circles count
+ * @param bounds    the bounds of all circles
+ */
+tb_void_t           gb_device_draw_circles(gb_device_ref_t device, gb_circle_ref_t circles, tb_size_t count, gb_rect_ref_t bounds);
+
+/*! draw the instances of path
+ *
+ * @param device    the device
+ * @param path      the path
+ * @param matrices  the matrices of all instances, applied before the device matrix
+ * @param count     the instances count
+ */
+tb_void_t           gb_device_draw_path_instances(gb_device_ref_t device, gb_path_ref_t path, gb_matrix_ref_t matrices, tb_size_t count);
+
+/*! draw bitmap
+ *
+ * @param device    the device
+ * @param bitmap    the bitmap
+ * @param src_rect  the source rect of the bitmap
+ * @param dst_rect  the destination rect
+ */
+tb_void_t           gb_device_draw_bitmap(gb_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -47,6 +47,13 @@
 #   define GB_DEVICE_BITMAP_POINTS_GROW      (128)
 #endif
 
+// the maximum memory size of the mask cache
+#ifdef __gb_small__
+#   define GB_DEVICE_BITMAP_MASKS_MAXN       (256 << 10)
+#else
+#   define GB_DEVICE_BITMAP_MASKS_MAXN       (1 << 20)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -77,8 +84,12 @@ static tb_void_t gb_device_bitmap_draw_clear(gb_device_impl_t* device, gb_color_
     tb_size_t count = gb_bitmap_size(impl->bitmap) / pixmap->btp;
     tb_assert(count);
 
+    // the pixel, map it to the nearest palette color for pal8
+    gb_palette_ref_t    palette = gb_bitmap_palette(impl->bitmap);
+    gb_pixel_t          pixel = palette? (gb_pixel_t)gb_palette_index(palette, color) : pixmap->pixel(color);
+
     // clear it
-    pixmap->pixels_fill(pixels, pixmap->pixel(color), count, 0xff);
+    pixmap->pixels_fill(pixels, pixel, count, 0xff);
 }
 static tb_void_t gb_device_bitmap_draw_lines(gb_device_impl_t* device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
 {
@@ -144,6 +155,63 @@ static tb_void_t gb_device_bitmap_draw_path(gb_device_impl_t* device, gb_path_re
         gb_bitmap_render_exit(impl);
     }
 }
+static tb_void_t gb_device_bitmap_draw_rects(gb_device_impl_t* device, gb_rect_ref_t rects, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
+    tb_assert_and_check_return(impl && rects && count);
+
+    // init render, the biltter is only inited once for all rects
+    if (gb_bitmap_render_init(impl))
+    {
+        // draw rects
+        gb_bitmap_render_draw_rects(impl, rects, count, bounds);
+    
+        // exit render
+        gb_bitmap_render_exit(impl);
+    }
+}
+static tb_void_t gb_device_bitmap_draw_circles(gb_device_impl_t* device, gb_circle_ref_t circles, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
+    tb_assert_and_check_return(impl && circles && count);
+
+    // init render, the biltter is only inited once for all circles
+    if (gb_bitmap_render_init(impl))
+    {
+        // draw circles
+        gb_bitmap_render_draw_circles(impl, circles, count, bounds);
+    
+        // exit render
+        gb_bitmap_render_exit(impl);
+    }
+}
+static tb_void_t gb_device_bitmap_draw_path_instances(gb_device_impl_t* device, gb_path_ref_t path, gb_matrix_ref_t matrices, tb_size_t count)
+{
+    // check
+    gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
+    tb_assert_and_check_return(impl && path && matrices && count);
+
+    // init render, the biltter is only inited once for all instances
+    if (gb_bitmap_render_init(impl))
+    {
+        // draw the instances of path
+        gb_bitmap_render_draw_path_instances(impl, path, matrices, count);
+    
+        // exit render
+        gb_bitmap_render_exit(impl);
+    }
+}
+static tb_void_t gb_device_bitmap_draw_bitmap(gb_device_impl_t* device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
+    tb_assert_and_check_return(impl && bitmap && src_rect && dst_rect);
+
+    // draw bitmap, the pixels are sampled from the bitmap and the biltter is not used
+    gb_bitmap_render_draw_bitmap(impl, bitmap, src_rect, dst_rect);
+}
 static gb_shader_ref_t gb_device_bitmap_shader_linear(gb_device_impl_t* device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line)
 {
     // check
@@ -193,6 +261,18 @@ static tb_void_t gb_device_bitmap_exit(gb_device_impl_t* device)
     if (impl->raster) gb_polygon_raster_exit(impl->raster);
     impl->raster = tb_null;
 
+    // exit strip raster
+    if (impl->strip_raster) gb_strip_raster_exit(impl->strip_raster);
+    impl->strip_raster = tb_null;
+
+    // exit path
+    if (impl->path) gb_path_exit(impl->path);
+    impl->path = tb_null;
+
+    // exit masks
+    if (impl->masks) gb_mask_cache_exit(impl->masks);
+    impl->masks = tb_null;
+
     // exit it
     tb_free(impl);
 }
@@ -227,6 +307,10 @@ gb_device_ref_t gb_device_init_bitmap(gb_bitmap_ref_t bitmap)
         impl->base.draw_lines       = gb_device_bitmap_draw_lines;
         impl->base.draw_points      = gb_device_bitmap_draw_points;
         impl->base.draw_polygon     = gb_device_bitmap_draw_polygon;
+        impl->base.draw_rects       = gb_device_bitmap_draw_rects;
+        impl->base.draw_circles     = gb_device_bitmap_draw_circles;
+        impl->base.draw_path_instances = gb_device_bitmap_draw_path_instances;
+        impl->base.draw_bitmap      = gb_device_bitmap_draw_bitmap;
         impl->base.shader_linear    = gb_device_bitmap_shader_linear;
         impl->base.shader_radial    = gb_device_bitmap_shader_radial;
         impl->base.shader_bitmap    = gb_device_bitmap_shader_bitmap;
@@ -243,10 +327,22 @@ gb_device_ref_t gb_device_init_bitmap(gb_bitmap_ref_t bitmap)
         impl->raster = gb_polygon_raster_init();
         tb_assert_and_check_break(impl->raster);
 
+        // init strip raster
+        impl->strip_raster = gb_strip_raster_init();
+        tb_assert_and_check_break(impl->strip_raster);
+
         // init stroker
         impl->stroker = gb_stroker_init();
         tb_assert_and_check_break(impl->stroker);
 
+        // init path
+        impl->path = gb_path_init();
+        tb_assert_and_check_break(impl->path);
+
+        // init masks
+        impl->masks = gb_mask_cache_init(GB_DEVICE_BITMAP_MASKS_MAXN);
+        tb_assert_and_check_break(impl->masks);
+
         // init points
         impl->points = tb_vector_init(GB_DEVICE_BITMAP_POINTS_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
         tb_assert_and_check_break(impl->points);
@@ -64,6 +64,14 @@ tb_void_t gb_bitmap_biltter_done_p(gb_bitmap_biltter_ref_t biltter, tb_long_t x,
     // done it
     biltter->done_p(biltter, x, y);
 }
+tb_void_t gb_bitmap_biltter_done_a(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_size_t coverage)
+{   
+    // check
+    tb_assert(biltter && biltter->done_a);
+
+    // done it
+    biltter->done_a(biltter, x, y, coverage);
+}
 tb_void_t gb_bitmap_biltter_done_h(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w)
 {   
     // check
@@ -48,6 +48,24 @@ typedef struct __gb_bitmap_biltter_solid_t
     // the alpha
     tb_byte_t                       alpha;
 
+    // the color, only for pal8
+    gb_color_t                      color;
+
+    // the blended pixmap for the antialiasing coverage
+    gb_pixmap_ref_t                 apixmap;
+
+    // the pixel is set by the pixmap directly? not dithered or remapped to the palette
+    tb_bool_t                       direct;
+
+    // the dithered pixels of the 4x4 bayer matrix, row by row
+    gb_pixel_t                      dither[16];
+
+    // the dithered pixels with the stored byte order for filling the opaque 16-bit pixels, row by row
+    tb_uint16_t                     pattern[16];
+
+    // the indices of the palette colors blended with this color, only for pal8
+    tb_byte_t                       remap[256];
+
 }gb_bitmap_biltter_solid_t;
 
 // the bitmap biltter type
@@ -86,6 +104,15 @@ typedef struct __gb_bitmap_biltter_t
      */
     tb_void_t                       (*done_p)(struct __gb_bitmap_biltter_t* biltter, tb_long_t x, tb_long_t y);
 
+    /* done biltter by pixel with the antialiasing coverage
+     *
+     * @param biltter               the biltter
+     * @param x                     the x-coordinate
+     * @param y                     the y-coordinate
+     * @param coverage              the coverage, [0, 256], 256: fully covered
+     */
+    tb_void_t                       (*done_a)(struct __gb_bitmap_biltter_t* biltter, tb_long_t x, tb_long_t y, tb_size_t coverage);
+
     /* done biltter by horizontal
      *
      * @param biltter               the biltter
@@ -144,6 +171,15 @@ tb_void_t               gb_bitmap_biltter_exit(gb_bitmap_biltter_ref_t biltter);
  */
 tb_void_t               gb_bitmap_biltter_done_p(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y);
 
+/* done biltter by pixel with the antialiasing coverage
+ *
+ * @param biltter       the biltter
+ * @param x             the x-coordinate
+ * @param y             the y-coordinate
+ * @param coverage      the coverage, [0, 256], 256: fully covered
+ */
+tb_void_t               gb_bitmap_biltter_done_a(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_size_t coverage);
+
 /* done biltter by horizontal
  *
  * @param biltter       the biltter
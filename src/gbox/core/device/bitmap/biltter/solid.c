@@ -51,6 +51,30 @@ static tb_void_t gb_bitmap_biltter_solid_done_p(gb_bitmap_biltter_ref_t biltter,
     // done
     biltter->pixmap->pixel_set(pixels + y * biltter->row_bytes + x * biltter->btp, biltter->u.solid.pixel, biltter->u.solid.alpha);
 }
+static tb_void_t gb_bitmap_biltter_solid_done_a(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_size_t coverage)
+{
+    // check
+    tb_assert(biltter && biltter->u.solid.apixmap && biltter->u.solid.apixmap->pixel_set);
+    tb_assert(x >= 0 && y >= 0 && coverage <= 256);
+
+    // fully covered? 
+    if (coverage == 256) 
+    {
+        gb_bitmap_biltter_solid_done_p(biltter, x, y);
+        return ;
+    }
+
+    // the alpha of the coverage
+    coverage = (biltter->u.solid.alpha * coverage) >> 8;
+    tb_check_return(coverage);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // done
+    biltter->u.solid.apixmap->pixel_set(pixels + y * biltter->row_bytes + x * biltter->btp, biltter->u.solid.pixel, (tb_byte_t)coverage);
+}
 static tb_void_t gb_bitmap_biltter_solid_done_h(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w)
 {
     // check
@@ -110,11 +134,11 @@ static tb_void_t gb_bitmap_biltter_solid_done_r(gb_bitmap_biltter_ref_t biltter,
     tb_byte_t                       alpha = biltter->u.solid.alpha;
     gb_pixmap_func_pixels_fill_t    pixels_fill = biltter->pixmap->pixels_fill;
 
-    // done
+    // the contiguous rows? fill them at once
+    pixels += y * row_bytes + x * btp;
     if (!x && (w * btp == row_bytes)) pixels_fill(pixels, pixel, h * w, alpha);
     else
     {
-        pixels += y * row_bytes + x * btp;
         while (h--) 
         {
             pixels_fill(pixels, pixel, w, alpha);
@@ -122,6 +146,410 @@ static tb_void_t gb_bitmap_biltter_solid_done_r(gb_bitmap_biltter_ref_t biltter,
         }
     }
 }
+static tb_void_t gb_bitmap_biltter_solid_dither_done_p(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y)
+{
+    // check
+    tb_assert(biltter && biltter->pixmap && biltter->pixmap->pixel_set);
+    tb_assert(x >= 0 && y >= 0);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // done
+    biltter->pixmap->pixel_set(pixels + y * biltter->row_bytes + x * biltter->btp, biltter->u.solid.dither[((y & 3) << 2) + (x & 3)], biltter->u.solid.alpha);
+}
+static tb_void_t gb_bitmap_biltter_solid_dither_done_a(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_size_t coverage)
+{
+    // check
+    tb_assert(biltter && biltter->u.solid.apixmap && biltter->u.solid.apixmap->pixel_set);
+    tb_assert(x >= 0 && y >= 0 && coverage <= 256);
+
+    // fully covered? 
+    if (coverage == 256) 
+    {
+        gb_bitmap_biltter_solid_dither_done_p(biltter, x, y);
+        return ;
+    }
+
+    // the alpha of the coverage
+    coverage = (biltter->u.solid.alpha * coverage) >> 8;
+    tb_check_return(coverage);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // done
+    biltter->u.solid.apixmap->pixel_set(pixels + y * biltter->row_bytes + x * biltter->btp, biltter->u.solid.dither[((y & 3) << 2) + (x & 3)], (tb_byte_t)coverage);
+}
+static tb_void_t gb_bitmap_biltter_solid_dither_done_h(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w)
+{
+    // check
+    tb_assert(biltter && biltter->pixmap && biltter->pixmap->pixel_set);
+    tb_assert(x >= 0 && y >= 0 && w >= 0);
+
+    // no width? ignore it
+    tb_check_return(w);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // the factors
+    tb_size_t                       btp = biltter->btp;
+    gb_pixel_t const*               row = biltter->u.solid.dither + ((y & 3) << 2);
+    tb_byte_t                       alpha = biltter->u.solid.alpha;
+    gb_pixmap_func_pixel_set_t      pixel_set = biltter->pixmap->pixel_set;
+
+    // the same pixels for this row? fill it directly
+    if (row[0] == row[1] && row[0] == row[2] && row[0] == row[3])
+    {
+        biltter->pixmap->pixels_fill(pixels + y * biltter->row_bytes + x * btp, row[0], w, alpha);
+        return ;
+    }
+
+    // done
+    pixels += y * biltter->row_bytes + x * btp;
+    while (w--) 
+    {
+        pixel_set(pixels, row[x++ & 3], alpha);
+        pixels += btp;
+    }
+}
+static tb_void_t gb_bitmap_biltter_solid_dither_done_v(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t h)
+{
+    // check
+    tb_assert(biltter && biltter->pixmap && biltter->pixmap->pixel_set);
+    tb_assert(x >= 0 && y >= 0 && h >= 0);
+
+    // no height? ignore it
+    tb_check_return(h);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // the factors
+    tb_size_t                       row_bytes = biltter->row_bytes;
+    gb_pixel_t const*               column = biltter->u.solid.dither + (x & 3);
+    tb_byte_t                       alpha = biltter->u.solid.alpha;
+    gb_pixmap_func_pixel_set_t      pixel_set = biltter->pixmap->pixel_set;
+
+    // done
+    pixels += y * row_bytes + x * biltter->btp;
+    while (h--) 
+    {
+        pixel_set(pixels, column[(y++ & 3) << 2], alpha);
+        pixels += row_bytes;
+    }
+}
+static tb_void_t gb_bitmap_biltter_solid_dither_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
+{
+    // check
+    tb_assert(biltter);
+    tb_assert(x >= 0 && y >= 0 && w >= 0 && h >= 0);
+
+    // done
+    while (h--) gb_bitmap_biltter_solid_dither_done_h(biltter, x, y++, w);
+}
+static tb_void_t gb_bitmap_biltter_solid_dither_fill(tb_uint16_t* data, tb_uint16_t const* row, tb_long_t x, tb_long_t count)
+{
+    // check
+    tb_assert(data && row && !((tb_size_t)data & 1));
+
+    // align data to 8-bytes
+    while (((tb_size_t)data & 7) && count)
+    {
+        *data++ = row[x++ & 3];
+        count--;
+    }
+
+    // the four pixels of the aligned data
+    tb_uint16_t pattern[4];
+    pattern[0] = row[x & 3];
+    pattern[1] = row[(x + 1) & 3];
+    pattern[2] = row[(x + 2) & 3];
+    pattern[3] = row[(x + 3) & 3];
+
+    // fill 32-bytes for each loop
+    tb_uint64_t p;
+    tb_memcpy(&p, pattern, sizeof(p));
+    tb_uint64_t*    d = (tb_uint64_t*)data;
+    tb_long_t       n = count >> 4;
+    while (n--)
+    {
+        d[0] = p;
+        d[1] = p;
+        d[2] = p;
+        d[3] = p;
+        d += 4;
+    }
+
+    // fill the left pixels
+    data = (tb_uint16_t*)d;
+    count &= 15;
+    for (n = 0; n < count; n++) data[n] = pattern[n & 3];
+}
+static tb_void_t gb_bitmap_biltter_solid_dither_opaque_done_h(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w)
+{
+    // check
+    tb_assert(biltter && biltter->btp == 2);
+    tb_assert(x >= 0 && y >= 0 && w >= 0);
+
+    // no width? ignore it
+    tb_check_return(w);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // done
+    gb_bitmap_biltter_solid_dither_fill((tb_uint16_t*)(pixels + y * biltter->row_bytes + (x << 1)), biltter->u.solid.pattern + ((y & 3) << 2), x, w);
+}
+static tb_void_t gb_bitmap_biltter_solid_dither_opaque_done_v(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t h)
+{
+    // check
+    tb_assert(biltter && biltter->btp == 2);
+    tb_assert(x >= 0 && y >= 0 && h >= 0);
+
+    // no height? ignore it
+    tb_check_return(h);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // the factors
+    tb_size_t           row_bytes = biltter->row_bytes;
+    tb_uint16_t const*  column = biltter->u.solid.pattern + (x & 3);
+
+    // done
+    pixels += y * row_bytes + (x << 1);
+    while (h--) 
+    {
+        *((tb_uint16_t*)pixels) = column[(y++ & 3) << 2];
+        pixels += row_bytes;
+    }
+}
+static tb_void_t gb_bitmap_biltter_solid_dither_opaque_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
+{
+    // check
+    tb_assert(biltter && biltter->btp == 2);
+    tb_assert(x >= 0 && y >= 0 && w >= 0 && h >= 0);
+
+    // no width and height? ignore it
+    tb_check_return(h && w);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // done
+    tb_size_t           row_bytes = biltter->row_bytes;
+    tb_uint16_t const*  pattern = biltter->u.solid.pattern;
+    pixels += y * row_bytes + (x << 1);
+    while (h--) 
+    {
+        gb_bitmap_biltter_solid_dither_fill((tb_uint16_t*)pixels, pattern + ((y++ & 3) << 2), x, w);
+        pixels += row_bytes;
+    }
+}
+static tb_bool_t gb_bitmap_biltter_solid_dither_init(gb_bitmap_biltter_ref_t biltter, gb_color_t color)
+{
+    // check
+    tb_assert(biltter && biltter->pixmap && biltter->pixmap->pixel);
+
+    // the dither steps, no dithering for the high-depth pixfmts or the low quality
+    tb_size_t steps = gb_pixmap_dither_steps(biltter->pixmap);
+    tb_check_return_val(steps, tb_false);
+
+    // make the dithered pixels
+    tb_size_t   i = 0;
+    tb_bool_t   same = tb_true;
+    gb_pixel_t* dither = biltter->u.solid.dither;
+    for (i = 0; i < 16; i++) 
+    {
+        dither[i] = biltter->pixmap->pixel(gb_pixmap_dither_color(color, steps, i & 3, i >> 2));
+        if (dither[i] != dither[0]) same = tb_false;
+    }
+
+    // this color need not be dithered
+    tb_check_return_val(!same, tb_false);
+
+    // the pixels are dithered, not set directly
+    biltter->u.solid.direct = tb_false;
+
+    // init operations
+    biltter->done_p     = gb_bitmap_biltter_solid_dither_done_p;
+    biltter->done_a     = gb_bitmap_biltter_solid_dither_done_a;
+    biltter->done_h     = gb_bitmap_biltter_solid_dither_done_h;
+    biltter->done_v     = gb_bitmap_biltter_solid_dither_done_v;
+    biltter->done_r     = gb_bitmap_biltter_solid_dither_done_r;
+
+    /* opaque? fill the stored pixels of the rows directly
+     *
+     * the opaque source-over pixmap only stores the pixel, so the pixels need not be blended one by one
+     */
+    tb_check_return_val(biltter->pixmap == gb_pixmap(gb_bitmap_pixfmt(biltter->bitmap), 0xff) && biltter->btp == 2, tb_true);
+    for (i = 0; i < 16; i++) biltter->pixmap->pixel_set(&biltter->u.solid.pattern[i], dither[i], 0xff);
+    biltter->done_h     = gb_bitmap_biltter_solid_dither_opaque_done_h;
+    biltter->done_v     = gb_bitmap_biltter_solid_dither_opaque_done_v;
+    biltter->done_r     = gb_bitmap_biltter_solid_dither_opaque_done_r;
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_bitmap_biltter_solid_pal8_done_p(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y)
+{
+    // check
+    tb_assert(biltter);
+    tb_assert(x >= 0 && y >= 0);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // done
+    pixels += y * biltter->row_bytes + x;
+    *pixels = biltter->u.solid.remap[*pixels];
+}
+static tb_void_t gb_bitmap_biltter_solid_pal8_done_a(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_size_t coverage)
+{
+    // check
+    tb_assert(biltter && biltter->done_p);
+    tb_assert(x >= 0 && y >= 0 && coverage <= 256);
+
+    // fully covered? 
+    if (coverage == 256) 
+    {
+        biltter->done_p(biltter, x, y);
+        return ;
+    }
+
+    // the alpha of the coverage
+    tb_long_t alpha = (tb_long_t)((biltter->u.solid.alpha * coverage) >> 8);
+    tb_check_return(alpha);
+
+    // the palette
+    gb_palette_ref_t palette = gb_bitmap_palette(biltter->bitmap);
+    tb_assert(palette);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // keep the invalid index
+    pixels += y * biltter->row_bytes + x;
+    tb_check_return(*pixels < gb_palette_size(palette));
+
+    // blend the palette color of this pixel and map it to the nearest index
+    gb_color_t  color = biltter->u.solid.color;
+    gb_color_t  c = gb_palette_color(palette, *pixels);
+    c.r = (tb_byte_t)(c.r + ((((tb_long_t)color.r - c.r) * alpha) >> 8));
+    c.g = (tb_byte_t)(c.g + ((((tb_long_t)color.g - c.g) * alpha) >> 8));
+    c.b = (tb_byte_t)(c.b + ((((tb_long_t)color.b - c.b) * alpha) >> 8));
+    *pixels = (tb_byte_t)gb_palette_index(palette, c);
+}
+static tb_void_t gb_bitmap_biltter_solid_pal8_done_h(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w)
+{
+    // check
+    tb_assert(biltter);
+    tb_assert(x >= 0 && y >= 0 && w >= 0);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // done
+    tb_byte_t const* remap = biltter->u.solid.remap;
+    pixels += y * biltter->row_bytes + x;
+    while (w--) 
+    {
+        *pixels = remap[*pixels];
+        pixels++;
+    }
+}
+static tb_void_t gb_bitmap_biltter_solid_pal8_done_v(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t h)
+{
+    // check
+    tb_assert(biltter);
+    tb_assert(x >= 0 && y >= 0 && h >= 0);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // done
+    tb_size_t           row_bytes = biltter->row_bytes;
+    tb_byte_t const*    remap = biltter->u.solid.remap;
+    pixels += y * row_bytes + x;
+    while (h--) 
+    {
+        *pixels = remap[*pixels];
+        pixels += row_bytes;
+    }
+}
+static tb_void_t gb_bitmap_biltter_solid_pal8_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
+{
+    // check
+    tb_assert(biltter);
+    tb_assert(x >= 0 && y >= 0 && w >= 0 && h >= 0);
+
+    // done
+    while (h--) gb_bitmap_biltter_solid_pal8_done_h(biltter, x, y++, w);
+}
+static tb_bool_t gb_bitmap_biltter_solid_pal8_init(gb_bitmap_biltter_ref_t biltter, gb_color_t color, tb_byte_t alpha)
+{
+    // check
+    tb_assert(biltter && biltter->bitmap);
+
+    // the palette
+    gb_palette_ref_t palette = gb_bitmap_palette(biltter->bitmap);
+    tb_assert_and_check_return_val(palette, tb_false);
+
+    // the pixel is the nearest color index
+    biltter->u.solid.pixel = (gb_pixel_t)gb_palette_index(palette, color);
+    biltter->u.solid.color = color;
+    biltter->u.solid.alpha = alpha;
+
+    // blend the coverage with the palette colors
+    biltter->done_a = gb_bitmap_biltter_solid_pal8_done_a;
+
+    // opaque? fill the index directly
+    tb_check_return_val(!GB_ALPHA_IS_OPAQUE(alpha), tb_true);
+
+    /* make the blended indices of all palette colors
+     *
+     * the blended index of the pixel is only depend on the old index, so blend it only once for each palette color
+     */
+    tb_size_t   i = 0;
+    tb_size_t   n = gb_palette_size(palette);
+    tb_byte_t*  remap = biltter->u.solid.remap;
+    for (i = 0; i < n; i++)
+    {
+        gb_color_t c = gb_palette_color(palette, i);
+        c.r = (tb_byte_t)(c.r + ((((tb_long_t)color.r - c.r) * alpha) >> 8));
+        c.g = (tb_byte_t)(c.g + ((((tb_long_t)color.g - c.g) * alpha) >> 8));
+        c.b = (tb_byte_t)(c.b + ((((tb_long_t)color.b - c.b) * alpha) >> 8));
+        remap[i] = (tb_byte_t)gb_palette_index(palette, c);
+    }
+
+    // keep the invalid indices
+    for (; i < 256; i++) remap[i] = (tb_byte_t)i;
+
+    // the pixels are remapped to the palette, not set directly
+    biltter->u.solid.direct = tb_false;
+
+    // init operations
+    biltter->done_p     = gb_bitmap_biltter_solid_pal8_done_p;
+    biltter->done_h     = gb_bitmap_biltter_solid_pal8_done_h;
+    biltter->done_v     = gb_bitmap_biltter_solid_pal8_done_v;
+    biltter->done_r     = gb_bitmap_biltter_solid_pal8_done_r;
+
+    // ok
+    return tb_true;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -134,25 +562,62 @@ tb_bool_t gb_bitmap_biltter_solid_init(gb_bitmap_biltter_ref_t biltter, gb_bitma
     // init bitmap
     biltter->bitmap = bitmap;
 
-    // init pixmap
-    biltter->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), gb_paint_alpha(paint));
-    tb_check_return_val(biltter->pixmap, tb_false);
+    /* init pixmap, blend it in the linear-light color space?
+     *
+     * GB_ALPHA_MINN always selects the alpha pixmap which blends the antialiasing coverage
+     */
+    if ((gb_paint_flag(paint) & GB_PAINT_FLAG_LINEAR) && gb_paint_blend(paint) == GB_PAINT_BLEND_SRC_OVER)
+    {
+        biltter->pixmap             = gb_pixmap_linear(gb_bitmap_pixfmt(bitmap), gb_paint_alpha(paint));
+        biltter->u.solid.apixmap    = gb_pixmap_linear(gb_bitmap_pixfmt(bitmap), GB_ALPHA_MINN);
+    }
+    else 
+    {
+        biltter->pixmap             = gb_pixmap_blend(gb_bitmap_pixfmt(bitmap), gb_paint_blend(paint), gb_paint_alpha(paint));
+        biltter->u.solid.apixmap    = gb_pixmap_blend(gb_bitmap_pixfmt(bitmap), gb_paint_blend(paint), GB_ALPHA_MINN);
+    }
+    tb_check_return_val(biltter->pixmap && biltter->u.solid.apixmap, tb_false);
 
     // init btp and row_bytes
     biltter->btp        = biltter->pixmap->btp;
     biltter->row_bytes  = gb_bitmap_row_bytes(biltter->bitmap);
 
-    // init solid
-    biltter->u.solid.pixel = biltter->pixmap->pixel(gb_paint_color(paint));
-    biltter->u.solid.alpha = gb_paint_alpha(paint);
-
     // init operations
     biltter->done_p     = gb_bitmap_biltter_solid_done_p;
+    biltter->done_a     = gb_bitmap_biltter_solid_done_a;
     biltter->done_h     = gb_bitmap_biltter_solid_done_h;
     biltter->done_v     = gb_bitmap_biltter_solid_done_v;
     biltter->done_r     = gb_bitmap_biltter_solid_done_r;
     biltter->exit       = tb_null;
 
+    // the pixels are set directly for the non-dithered colors
+    biltter->u.solid.direct = tb_true;
+
+    /* map the solid color to the palette for pal8
+     *
+     * the pixel is the palette index, the pal8 pixmap cannot make it from the color
+     */
+    if (GB_PIXFMT(gb_bitmap_pixfmt(bitmap)) == GB_PIXFMT(GB_PIXFMT_PAL8))
+        return gb_bitmap_biltter_solid_pal8_init(biltter, gb_paint_color(paint), gb_paint_alpha(paint));
+
+    /* init solid
+     *
+     * the blend pixmap takes the premultiplied source with the paint alpha, 
+     * so the alpha of the biltter is only the full coverage for it
+     */
+    gb_color_t  color = gb_paint_color(paint);
+    tb_byte_t   alpha = gb_paint_alpha(paint);
+    if (gb_paint_blend(paint) != GB_PAINT_BLEND_SRC_OVER)
+    {
+        color.a = alpha;
+        alpha   = 0xff;
+    }
+    biltter->u.solid.pixel = biltter->pixmap->pixel(color);
+    biltter->u.solid.alpha = alpha;
+
+    // dither the solid color for the low-depth pixfmts
+    gb_bitmap_biltter_solid_dither_init(biltter, color);
+
     // ok
     return tb_true;
 }
@@ -32,6 +32,8 @@
 #include "biltter.h"
 #include "../../impl/stroker.h"
 #include "../../impl/polygon_raster.h"
+#include "../../impl/strip_raster.h"
+#include "../../impl/mask_cache.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -64,12 +66,21 @@ typedef struct __gb_bitmap_device_t
     // the raster
     gb_polygon_raster_ref_t         raster;
 
+    // the sparse strip raster
+    gb_strip_raster_ref_t           strip_raster;
+
     // the biltter
     gb_bitmap_biltter_t             biltter;
 
     // the stroker
     gb_stroker_ref_t                stroker;
 
+    // the path for the batched shapes which cannot be filled directly
+    gb_path_ref_t                   path;
+
+    // the mask cache of the filled paths
+    gb_mask_cache_ref_t             masks;
+
 }gb_bitmap_device_t, *gb_bitmap_device_ref_t;
 
 #endif
@@ -37,11 +37,40 @@
 #include "biltter.h"
 #include "render/render.h"
 #include "../../impl/bounds.h"
+#include "../../impl/geometry.h"
 #include "../../impl/stroker.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static tb_void_t gb_bitmap_render_apply_matrix_for_round_rect(gb_matrix_ref_t matrix, gb_round_rect_ref_t rect, gb_round_rect_ref_t output)
+{
+    // check
+    tb_assert(matrix && rect && output);
+
+    // apply matrix to bounds
+    gb_rect_apply2(&rect->bounds, &output->bounds, matrix);
+
+    /* scale the radius of the corners
+     *
+     * the corners are swapped if the matrix is flipped
+     *
+     * flip x: lt <=> rt, lb <=> rb
+     * flip y: lt <=> lb, rt <=> rb
+     */
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    gb_float_t  sx = gb_abs(matrix->sx);
+    gb_float_t  sy = gb_abs(matrix->sy);
+    for (i = 0; i < GB_RECT_CORNER_MAXN; i++)
+    {
+        j = i;
+        if (matrix->sx < 0) j ^= 1;
+        if (matrix->sy < 0) j = GB_RECT_CORNER_LB - j;
+        output->radius[j].x = gb_mul(rect->radius[i].x, sx);
+        output->radius[j].y = gb_mul(rect->radius[i].y, sy);
+    }
+}
 static tb_bool_t gb_bitmap_render_apply_matrix_for_hint(gb_bitmap_device_ref_t device, gb_shape_ref_t hint, gb_shape_ref_t output)
 {
     // check
@@ -50,21 +79,100 @@ static tb_bool_t gb_bitmap_render_apply_matrix_for_hint(gb_bitmap_device_ref_t d
     // clear output first
     output->type = GB_SHAPE_TYPE_NONE;
 
-    // rect and no rotation?
-    if (    hint
-        &&  hint->type == GB_SHAPE_TYPE_RECT
-        &&  0 == device->base.matrix->kx && 0 == device->base.matrix->ky)
+    // no hint or rotation?
+    gb_matrix_ref_t matrix = device->base.matrix;
+    tb_check_return_val(hint && 0 == matrix->kx && 0 == matrix->ky, tb_false);
+
+    // done
+    gb_rect_t       bounds;
+    gb_round_rect_t rect;
+    switch (hint->type)
     {
-        // apply matrix to rect
-        gb_rect_apply2(&hint->u.rect, &output->u.rect, device->base.matrix);
+    case GB_SHAPE_TYPE_RECT:
+        {
+            // apply matrix to rect
+            gb_rect_apply2(&hint->u.rect, &output->u.rect, matrix);
+
+            // mark the output hint type
+            output->type = GB_SHAPE_TYPE_RECT;
+        }
+        break;
+    case GB_SHAPE_TYPE_CIRCLE:
+        {
+            // make the round rect of the circle
+            gb_rect_make(&bounds, hint->u.circle.c.x - hint->u.circle.r, hint->u.circle.c.y - hint->u.circle.r, gb_lsh(hint->u.circle.r, 1), gb_lsh(hint->u.circle.r, 1));
+            gb_round_rect_make_same(&rect, &bounds, hint->u.circle.r, hint->u.circle.r);
+
+            // apply matrix to it
+            gb_bitmap_render_apply_matrix_for_round_rect(matrix, &rect, &output->u.round_rect);
 
-        // mark the output hint type
-        output->type = GB_SHAPE_TYPE_RECT;
+            // mark the output hint type
+            output->type = GB_SHAPE_TYPE_ROUND_RECT;
+        }
+        break;
+    case GB_SHAPE_TYPE_ELLIPSE:
+        {
+            // make the round rect of the ellipse
+            gb_rect_make(&bounds, hint->u.ellipse.c.x - hint->u.ellipse.rx, hint->u.ellipse.c.y - hint->u.ellipse.ry, gb_lsh(hint->u.ellipse.rx, 1), gb_lsh(hint->u.ellipse.ry, 1));
+            gb_round_rect_make_same(&rect, &bounds, hint->u.ellipse.rx, hint->u.ellipse.ry);
+
+            // apply matrix to it
+            gb_bitmap_render_apply_matrix_for_round_rect(matrix, &rect, &output->u.round_rect);
+
+            // mark the output hint type
+            output->type = GB_SHAPE_TYPE_ROUND_RECT;
+        }
+        break;
+    case GB_SHAPE_TYPE_ROUND_RECT:
+        {
+            // apply matrix to round rect
+            gb_bitmap_render_apply_matrix_for_round_rect(matrix, &hint->u.round_rect, &output->u.round_rect);
+
+            // mark the output hint type
+            output->type = GB_SHAPE_TYPE_ROUND_RECT;
+        }
+        break;
+    default:
+        break;
     }
 
     // ok?
     return output->type != GB_SHAPE_TYPE_NONE;
 }
+static tb_bool_t gb_bitmap_render_fill_hint(gb_bitmap_device_ref_t device, gb_shape_ref_t hint)
+{
+    // check
+    tb_assert(device && device->bitmap);
+
+    // apply matrix to hint
+    gb_shape_t      filled_hint;
+    tb_check_return_val(gb_bitmap_render_apply_matrix_for_hint(device, hint, &filled_hint), tb_false);
+
+    // the device bounds of the filled hint
+    gb_rect_ref_t   bounds = filled_hint.type == GB_SHAPE_TYPE_RECT? &filled_hint.u.rect : &filled_hint.u.round_rect.bounds;
+
+    // clip it, outside the device? nothing need be filled, keep one pixel for the antialiasing
+    if (    bounds->x + bounds->w + GB_ONE < 0
+        ||  bounds->y + bounds->h + GB_ONE < 0
+        ||  bounds->x - GB_ONE > gb_long_to_float(gb_bitmap_width(device->bitmap))
+        ||  bounds->y - GB_ONE > gb_long_to_float(gb_bitmap_height(device->bitmap)))
+        return tb_true;
+
+    // fill rect
+    if (filled_hint.type == GB_SHAPE_TYPE_RECT) gb_bitmap_render_fill_rect(device, &filled_hint.u.rect);
+    // fill round rect, circle and ellipse
+    else
+    {
+        // check
+        tb_assert(filled_hint.type == GB_SHAPE_TYPE_ROUND_RECT);
+
+        // fill round rect, fill the polygon of it if it is too large
+        return gb_bitmap_render_fill_round_rect(device, &filled_hint.u.round_rect);
+    }
+
+    // ok
+    return tb_true;
+}
 static tb_size_t gb_bitmap_render_apply_matrix_for_points(gb_bitmap_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_point_ref_t* output)
 {
     // check
@@ -155,6 +263,43 @@ static gb_rect_ref_t gb_bitmap_render_make_bounds_for_points(gb_bitmap_device_re
     // ok?
     return &device->bounds;
 }
+static tb_void_t gb_bitmap_render_fill_points(gb_bitmap_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(device && polygon);
+
+    // apply matrix to points
+    gb_polygon_t    filled_polygon = {tb_null, polygon->counts, polygon->convex};
+    tb_size_t       filled_count   = gb_bitmap_render_apply_matrix_for_polygon(device, polygon, &filled_polygon.points);
+    tb_assert(filled_polygon.points && filled_count);
+
+    // make the filled bounds
+    gb_rect_ref_t   filled_bounds = gb_bitmap_render_make_bounds_for_points(device, bounds, filled_polygon.points, filled_count);
+    tb_assert(filled_bounds);
+
+    // TODO: clip it
+    // ...
+
+    // fill polygon
+    gb_bitmap_render_fill_polygon(device, &filled_polygon, filled_bounds);
+}
+static tb_bool_t gb_bitmap_render_fill_cached_mask(gb_bitmap_device_ref_t device, gb_path_ref_t path)
+{
+    // check
+    tb_assert(device && device->masks && device->base.paint && device->base.matrix && path);
+
+    // get the cached mask of the path, it will be made if the path is drawn repeatedly
+    tb_long_t       dx = 0;
+    tb_long_t       dy = 0;
+    gb_mask_ref_t   mask = gb_mask_cache_get(device->masks, device->raster, path, device->base.matrix, gb_paint_fill_rule(device->base.paint), &dx, &dy);
+    tb_check_return_val(mask, tb_false);
+
+    // fill mask
+    gb_bitmap_render_fill_mask(device, mask, dx, dy);
+
+    // ok
+    return tb_true;
+}
 static tb_void_t gb_bitmap_render_stroke_fill(gb_bitmap_device_ref_t device, gb_path_ref_t path)
 {
     // check
@@ -184,6 +329,43 @@ static tb_void_t gb_bitmap_render_stroke_fill(gb_bitmap_device_ref_t device, gb_
     // restore the fill mode
     gb_paint_fill_rule_set(device->base.paint, rule);
 }
+static tb_bool_t gb_bitmap_render_bounds_outside(gb_bitmap_device_ref_t device, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(device && device->base.paint && device->base.matrix && device->bitmap);
+
+    // no bounds?
+    tb_check_return_val(bounds, tb_false);
+
+    /* inflate the bounds for the stroke
+     *
+     * the full stroke width is enough for the half width and the miter joins of the rects
+     */
+    gb_rect_t   inflated = *bounds;
+    gb_float_t  width = gb_paint_stroke_width(device->base.paint);
+    if ((gb_paint_mode(device->base.paint) & GB_PAINT_MODE_STROKE) && width > 0)
+    {
+        inflated.x -= width;
+        inflated.y -= width;
+        inflated.w += gb_lsh(width, 1);
+        inflated.h += gb_lsh(width, 1);
+    }
+
+    // apply matrix to the four corners
+    gb_point_t points[4];
+    gb_point_make(&points[0], inflated.x, inflated.y);
+    gb_point_make(&points[1], inflated.x + inflated.w, inflated.y);
+    gb_point_make(&points[2], inflated.x + inflated.w, inflated.y + inflated.h);
+    gb_point_make(&points[3], inflated.x, inflated.y + inflated.h);
+    gb_matrix_apply_points(device->base.matrix, points, tb_arrayn(points));
+    gb_bounds_make(&inflated, points, tb_arrayn(points));
+
+    // outside the device? keep one pixel for the antialiasing
+    return (    inflated.x + inflated.w + GB_ONE < 0
+            ||  inflated.y + inflated.h + GB_ONE < 0
+            ||  inflated.x - GB_ONE > gb_long_to_float(gb_bitmap_width(device->bitmap))
+            ||  inflated.y - GB_ONE > gb_long_to_float(gb_bitmap_height(device->bitmap)))? tb_true : tb_false;
+}
 static __tb_inline__ tb_bool_t gb_bitmap_render_stroke_only(gb_bitmap_device_ref_t device)
 {
     // check
@@ -244,7 +426,15 @@ tb_void_t gb_bitmap_render_draw_path(gb_bitmap_device_ref_t device, gb_path_ref_
     // fill it
     if (mode & GB_PAINT_MODE_FILL)
     {
-        gb_bitmap_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        /* fill the hint shape directly? need not make the polygon of the path
+         *
+         * or fill the cached mask if the path is drawn repeatedly, otherwise fill the points of polygon
+         */
+        if (    !gb_bitmap_render_fill_hint(device, gb_path_hint(path))
+            &&  !gb_bitmap_render_fill_cached_mask(device, path))
+        {
+            gb_bitmap_render_fill_points(device, gb_path_polygon(path), gb_path_bounds(path));
+        }
     }
 
     // stroke it
@@ -342,30 +532,9 @@ tb_void_t gb_bitmap_render_draw_polygon(gb_bitmap_device_ref_t device, gb_polygo
     // fill it
     if (mode & GB_PAINT_MODE_FILL)
     {
-        // apply matrix to points
-        gb_polygon_t    filled_polygon = {tb_null, polygon->counts, polygon->convex};
-        tb_size_t       filled_count   = gb_bitmap_render_apply_matrix_for_polygon(device, polygon, &filled_polygon.points);
-        tb_assert(filled_polygon.points && filled_count);
-
-        // make the filled bounds
-        gb_rect_ref_t   filled_bounds = gb_bitmap_render_make_bounds_for_points(device, bounds, filled_polygon.points, filled_count);
-        tb_assert(filled_bounds);
-
-        // TODO: clip it
-        tb_bool_t       clipped = tb_false;
-
-        // apply matrix to hint
-        gb_shape_t      filled_hint;
-        if (!clipped && gb_bitmap_render_apply_matrix_for_hint(device, hint, &filled_hint))
-        {
-            // check
-            tb_assert(filled_hint.type == GB_SHAPE_TYPE_RECT);
-
-            // fill rect
-            gb_bitmap_render_fill_rect(device, &filled_hint.u.rect);
-        }
-        // fill polygon
-        else gb_bitmap_render_fill_polygon(device, &filled_polygon, filled_bounds);
+        // fill the hint shape directly? or fill the points of polygon
+        if (!gb_bitmap_render_fill_hint(device, hint))
+            gb_bitmap_render_fill_points(device, polygon, bounds);
     }
 
     // stroke it
@@ -389,4 +558,147 @@ tb_void_t gb_bitmap_render_draw_polygon(gb_bitmap_device_ref_t device, gb_polygo
         else gb_bitmap_render_stroke_fill(device, gb_stroker_done_polygon(device->stroker, device->base.paint, polygon, hint));
     }
 }
+tb_void_t gb_bitmap_render_draw_rects(gb_bitmap_device_ref_t device, gb_rect_ref_t rects, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(device && device->base.paint && rects && count);
 
+    // all rects are outside the device?
+    tb_check_return(!gb_bitmap_render_bounds_outside(device, bounds));
+
+    // init polygon
+    gb_point_t      points[5];
+    tb_uint16_t     counts[2];
+    gb_polygon_t    polygon = {points, counts, tb_true};
+
+    // init hint
+    gb_shape_t      hint;
+    hint.type       = GB_SHAPE_TYPE_RECT;
+
+    // done
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // the rect
+        gb_rect_ref_t rect = &rects[i];
+
+        // make hint
+        hint.u.rect = *rect;
+
+        // make polygon
+        gb_geometry_make_rect_polygon(&polygon, rect);
+
+        // draw polygon, the rect will be filled directly from the hint if no rotation
+        gb_bitmap_render_draw_polygon(device, &polygon, &hint, rect);
+    }
+}
+tb_void_t gb_bitmap_render_draw_circles(gb_bitmap_device_ref_t device, gb_circle_ref_t circles, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(device && device->base.paint && device->path && circles && count);
+
+    // all circles are outside the device?
+    tb_check_return(!gb_bitmap_render_bounds_outside(device, bounds));
+
+    // only fill?
+    tb_bool_t   fill_only = gb_paint_mode(device->base.paint) == GB_PAINT_MODE_FILL;
+
+    // init hint
+    gb_shape_t  hint;
+    hint.type   = GB_SHAPE_TYPE_CIRCLE;
+
+    // done
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // make hint
+        hint.u.circle = circles[i];
+
+        // fill the circle directly?
+        if (fill_only && gb_bitmap_render_fill_hint(device, &hint)) continue;
+
+        // make the path of circle
+        gb_path_clear(device->path);
+        gb_path_add_circle(device->path, &circles[i], GB_ROTATE_DIRECTION_CW);
+
+        // draw path
+        gb_bitmap_render_draw_path(device, device->path);
+    }
+}
+tb_void_t gb_bitmap_render_draw_path_instances(gb_bitmap_device_ref_t device, gb_path_ref_t path, gb_matrix_ref_t matrices, tb_size_t count)
+{
+    // check
+    tb_assert(device && device->base.matrix && path && matrices && count);
+
+    // save matrix
+    gb_matrix_ref_t matrix = device->base.matrix;
+
+    /* draw path for each instance
+     *
+     * the polygon of path is only made once and cached in the path
+     */
+    tb_size_t   i = 0;
+    gb_matrix_t applied;
+    for (i = 0; i < count; i++)
+    {
+        // apply the matrix of this instance
+        applied = *matrix;
+        gb_matrix_multiply(&applied, &matrices[i]);
+        device->base.matrix = &applied;
+
+        // draw path
+        gb_bitmap_render_draw_path(device, path);
+    }
+
+    // restore matrix
+    device->base.matrix = matrix;
+}
+tb_void_t gb_bitmap_render_draw_bitmap(gb_bitmap_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    tb_assert(device && device->base.matrix && bitmap && src_rect && dst_rect);
+
+    // empty?
+    tb_check_return(src_rect->w > 0 && src_rect->h > 0 && dst_rect->w > 0 && dst_rect->h > 0);
+
+    /* make the matrix for mapping the source rect to the device
+     *
+     * matrix = device_matrix * (src_rect => dst_rect)
+     */
+    gb_matrix_t matrix = *device->base.matrix;
+    gb_matrix_t factor;
+    gb_float_t  sx = gb_div(dst_rect->w, src_rect->w);
+    gb_float_t  sy = gb_div(dst_rect->h, src_rect->h);
+    gb_matrix_init(&factor, sx, 0, 0, sy, dst_rect->x - gb_mul(src_rect->x, sx), dst_rect->y - gb_mul(src_rect->y, sy));
+    gb_matrix_multiply(&matrix, &factor);
+
+    /* clip the source rect to the device bounds
+     *
+     * the device bounds are mapped to the source space, 
+     * and expanded by one source pixel for keeping the neighbor pixels of the bilinear filter
+     */
+    gb_matrix_t inverse = matrix;
+    tb_check_return(gb_matrix_invert(&inverse));
+    gb_rect_t   bounds;
+    gb_point_t  points[4];
+    gb_float_t  width = gb_long_to_float(gb_bitmap_width(device->bitmap));
+    gb_float_t  height = gb_long_to_float(gb_bitmap_height(device->bitmap));
+    gb_point_make(&points[0], 0, 0);
+    gb_point_make(&points[1], width, 0);
+    gb_point_make(&points[2], width, height);
+    gb_point_make(&points[3], 0, height);
+    gb_matrix_apply_points(&inverse, points, tb_arrayn(points));
+    gb_bounds_make(&bounds, points, tb_arrayn(points));
+    gb_float_t  x0 = tb_max(bounds.x - GB_ONE, src_rect->x);
+    gb_float_t  y0 = tb_max(bounds.y - GB_ONE, src_rect->y);
+    gb_float_t  x1 = tb_min(bounds.x + bounds.w + GB_ONE, src_rect->x + src_rect->w);
+    gb_float_t  y1 = tb_min(bounds.y + bounds.h + GB_ONE, src_rect->y + src_rect->h);
+
+    // outside the device?
+    tb_check_return(x0 < x1 && y0 < y1);
+
+    // fill bitmap
+    gb_rect_t clipped;
+    gb_rect_make(&clipped, x0, y0, x1 - x0, y1 - y0);
+    gb_bitmap_render_fill_bitmap(device, bitmap, &clipped, &matrix);
+}
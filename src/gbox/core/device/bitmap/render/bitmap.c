@@ -0,0 +1,588 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        bitmap.c
+ * @ingroup     core
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "bitmap_bitmap"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "bitmap.h"
+#include "../../../impl/bounds.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bitmap sampler type
+typedef struct __gb_bitmap_render_sampler_t
+{
+    // the source data
+    tb_byte_t const*        sdata;
+
+    // the source row bytes
+    tb_size_t               srow_bytes;
+
+    // the source bytes per-pixel
+    tb_size_t               sbtp;
+
+    // the source pixmap
+    gb_pixmap_ref_t         spixmap;
+
+    // the source bounds: [sx0, sx1) x [sy0, sy1)
+    tb_long_t               sx0;
+    tb_long_t               sy0;
+    tb_long_t               sx1;
+    tb_long_t               sy1;
+
+    // the destination data
+    tb_byte_t*              ddata;
+
+    // the destination row bytes
+    tb_size_t               drow_bytes;
+
+    // the destination bytes per-pixel
+    tb_size_t               dbtp;
+
+    // the opaque pixmap of the destination
+    gb_pixmap_ref_t         opixmap;
+
+    // the alpha pixmap of the destination
+    gb_pixmap_ref_t         apixmap;
+
+    // the blend pixmap of the destination, only for the non source-over mode
+    gb_pixmap_ref_t         bpixmap;
+
+    /* the copied pixmap for copying the source pixels directly
+     *
+     * only for the same pixfmt and the source bitmap has not alpha or it's premultiplied
+     */
+    gb_pixmap_ref_t         cpixmap;
+
+    // copy the source rows directly?
+    tb_bool_t               copy;
+
+    // the paint alpha
+    tb_byte_t               alpha;
+
+    // the source bitmap has alpha?
+    tb_bool_t               has_alpha;
+
+    // the source pixfmt is premultiplied?
+    tb_bool_t               spremultiplied;
+
+    // the destination pixfmt is premultiplied?
+    tb_bool_t               premultiplied;
+
+    // filter bitmap?
+    tb_bool_t               filter;
+
+    // the dither steps of the destination, no dithering if be zero
+    tb_size_t               dither;
+
+    // the palette of the pal8 destination
+    gb_palette_ref_t        palette;
+
+}gb_bitmap_render_sampler_t, *gb_bitmap_render_sampler_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_long_t gb_bitmap_render_clamp(tb_long_t x, tb_long_t minv, tb_long_t maxv)
+{
+    return x < minv? minv : (x > maxv? maxv : x);
+}
+static __tb_inline__ tb_byte_t const* gb_bitmap_render_sampler_at(gb_bitmap_render_sampler_ref_t sampler, tb_long_t x, tb_long_t y)
+{
+    // clamp it to the source bounds
+    x = gb_bitmap_render_clamp(x, sampler->sx0, sampler->sx1 - 1);
+    y = gb_bitmap_render_clamp(y, sampler->sy0, sampler->sy1 - 1);
+
+    // the source pixel
+    return sampler->sdata + y * sampler->srow_bytes + x * sampler->sbtp;
+}
+static __tb_inline__ tb_uint32_t gb_bitmap_render_sampler_lerp(tb_uint32_t p, tb_uint32_t q, tb_size_t f)
+{
+    /* lerp the two channels at once for the 0x00ff00ff mask
+     *
+     * p * (256 - f) + q * f <= 255 * 256, not overflow
+     */
+    tb_uint32_t hp = (p >> 8) & 0x00ff00ff;
+    tb_uint32_t lp = p & 0x00ff00ff;
+    tb_uint32_t hq = (q >> 8) & 0x00ff00ff;
+    tb_uint32_t lq = q & 0x00ff00ff;
+    tb_uint32_t h = ((hp * (256 - f) + hq * f) >> 8) & 0x00ff00ff;
+    tb_uint32_t l = ((lp * (256 - f) + lq * f) >> 8) & 0x00ff00ff;
+    return (h << 8) | l;
+}
+static __tb_inline__ tb_uint32_t gb_bitmap_render_sampler_premul(tb_uint32_t p)
+{
+    // opaque?
+    tb_uint32_t a = p >> 24;
+    tb_check_return_val(a != 0xff, p);
+
+    // c * a / 255 for the r, g, b channels
+    tb_uint32_t l = (p & 0x00ff00ff) * a + 0x00800080;
+    tb_uint32_t g = ((p >> 8) & 0xff) * a + 0x80;
+    l = ((l + ((l >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    g = ((g + (g >> 8)) >> 8) & 0xff;
+    return (a << 24) | (g << 8) | l;
+}
+static __tb_inline__ tb_uint32_t gb_bitmap_render_sampler_fade(tb_uint32_t p, tb_size_t a)
+{
+    // c * a / 255 for the all channels of the premultiplied pixel
+    tb_uint32_t l = (p & 0x00ff00ff) * a + 0x00800080;
+    tb_uint32_t h = ((p >> 8) & 0x00ff00ff) * a + 0x00800080;
+    l = ((l + ((l >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    h = (h + ((h >> 8) & 0x00ff00ff)) & 0xff00ff00;
+    return h | l;
+}
+static __tb_inline__ gb_color_t gb_bitmap_render_sampler_unpremul(tb_uint32_t p)
+{
+    // opaque?
+    gb_color_t color = gb_pixel_color(p);
+    tb_check_return_val(color.a != 0xff, color);
+
+    // transparent?
+    if (!color.a)
+    {
+        color.r = 0;
+        color.g = 0;
+        color.b = 0;
+        return color;
+    }
+
+    // c * 255 / a
+    tb_uint32_t f = (0xff << 16) / color.a;
+    color.r = (tb_byte_t)tb_min((color.r * f + 0x8000) >> 16, 0xff);
+    color.g = (tb_byte_t)tb_min((color.g * f + 0x8000) >> 16, 0xff);
+    color.b = (tb_byte_t)tb_min((color.b * f + 0x8000) >> 16, 0xff);
+    return color;
+}
+static __tb_inline__ gb_color_t gb_bitmap_render_sampler_nearest(gb_bitmap_render_sampler_ref_t sampler, tb_fixed_t u, tb_fixed_t v)
+{
+    return sampler->spixmap->color_get(gb_bitmap_render_sampler_at(sampler, u >> 16, v >> 16));
+}
+static tb_uint32_t gb_bitmap_render_sampler_bilinear_pixel(gb_bitmap_render_sampler_ref_t sampler, tb_fixed_t u, tb_fixed_t v)
+{
+    // move to the center of the source pixel
+    u -= TB_FIXED_HALF;
+    v -= TB_FIXED_HALF;
+
+    // the top-left pixel
+    tb_long_t x = u >> 16;
+    tb_long_t y = v >> 16;
+
+    // the weights
+    tb_size_t fx = (u >> 8) & 0xff;
+    tb_size_t fy = (v >> 8) & 0xff;
+
+    /* the four pixels, lerp the premultiplied pixels directly if the source is premultiplied
+     *
+     * the source pixels with alpha are premultiplied before lerping them,
+     * otherwise the colors of the transparent pixels will bleed into the edges
+     */
+    tb_uint32_t p00;
+    tb_uint32_t p01;
+    tb_uint32_t p10;
+    tb_uint32_t p11;
+    if (sampler->spremultiplied)
+    {
+        gb_pixmap_func_pixel_get_t pixel_get = sampler->spixmap->pixel_get;
+        p00 = pixel_get(gb_bitmap_render_sampler_at(sampler, x, y));
+        p01 = pixel_get(gb_bitmap_render_sampler_at(sampler, x + 1, y));
+        p10 = pixel_get(gb_bitmap_render_sampler_at(sampler, x, y + 1));
+        p11 = pixel_get(gb_bitmap_render_sampler_at(sampler, x + 1, y + 1));
+    }
+    else
+    {
+        gb_pixmap_func_color_get_t color_get = sampler->spixmap->color_get;
+        p00 = gb_color_pixel(color_get(gb_bitmap_render_sampler_at(sampler, x, y)));
+        p01 = gb_color_pixel(color_get(gb_bitmap_render_sampler_at(sampler, x + 1, y)));
+        p10 = gb_color_pixel(color_get(gb_bitmap_render_sampler_at(sampler, x, y + 1)));
+        p11 = gb_color_pixel(color_get(gb_bitmap_render_sampler_at(sampler, x + 1, y + 1)));
+        if (sampler->has_alpha)
+        {
+            p00 = gb_bitmap_render_sampler_premul(p00);
+            p01 = gb_bitmap_render_sampler_premul(p01);
+            p10 = gb_bitmap_render_sampler_premul(p10);
+            p11 = gb_bitmap_render_sampler_premul(p11);
+        }
+    }
+
+    // lerp it
+    return gb_bitmap_render_sampler_lerp(gb_bitmap_render_sampler_lerp(p00, p01, fx), gb_bitmap_render_sampler_lerp(p10, p11, fx), fy);
+}
+static __tb_inline__ gb_color_t gb_bitmap_render_sampler_bilinear(gb_bitmap_render_sampler_ref_t sampler, tb_fixed_t u, tb_fixed_t v)
+{
+    // the pixel
+    tb_uint32_t pixel = gb_bitmap_render_sampler_bilinear_pixel(sampler, u, v);
+
+    // the color, unpremultiply it if the source pixels with alpha have been premultiplied
+    if (sampler->spremultiplied) return sampler->spixmap->color(pixel);
+    return sampler->has_alpha? gb_bitmap_render_sampler_unpremul(pixel) : gb_pixel_color(pixel);
+}
+static tb_void_t gb_bitmap_render_sampler_palette_set(gb_bitmap_render_sampler_ref_t sampler, tb_byte_t* data, gb_color_t color, tb_size_t alpha)
+{
+    // transparent?
+    tb_check_return(alpha >= GB_ALPHA_MINN);
+
+    // blend it with the palette color of the destination index
+    if (!GB_ALPHA_IS_OPAQUE(alpha) && *data < gb_palette_size(sampler->palette))
+    {
+        gb_color_t d = gb_palette_color(sampler->palette, *data);
+        color.r = (tb_byte_t)(d.r + ((((tb_long_t)color.r - d.r) * (tb_long_t)alpha) >> 8));
+        color.g = (tb_byte_t)(d.g + ((((tb_long_t)color.g - d.g) * (tb_long_t)alpha) >> 8));
+        color.b = (tb_byte_t)(d.b + ((((tb_long_t)color.b - d.b) * (tb_long_t)alpha) >> 8));
+    }
+
+    // map it to the nearest palette color
+    *data = (tb_byte_t)gb_palette_index(sampler->palette, color);
+}
+static __tb_inline__ tb_void_t gb_bitmap_render_sampler_color_set(gb_bitmap_render_sampler_ref_t sampler, tb_pointer_t data, gb_color_t color, tb_long_t x, tb_long_t y)
+{
+    // dither it for the low-depth destination
+    if (sampler->dither) color = gb_pixmap_dither_color(color, sampler->dither, x, y);
+
+    // the alpha
+    tb_size_t alpha = sampler->alpha;
+    if (sampler->premultiplied)
+    {
+        // the premultiplied pixel will contain the source alpha, and the source without alpha is opaque
+        if (!sampler->has_alpha) color.a = 0xff;
+    }
+    else if (sampler->has_alpha) 
+    {
+        // fold the source alpha into the alpha, the blended pixel will be opaque like the solid color
+        alpha   = (color.a * (alpha + 1)) >> 8;
+        color.a = 0xff;
+    }
+
+    // pal8?
+    if (sampler->palette) gb_bitmap_render_sampler_palette_set(sampler, (tb_byte_t*)data, color, alpha);
+    // blend it? the blend pixmap takes the premultiplied source with all alpha and the full coverage
+    else if (sampler->bpixmap) 
+    {
+        color.a = (tb_byte_t)(sampler->premultiplied? ((color.a * (alpha + 1)) >> 8) : alpha);
+        sampler->bpixmap->pixel_set(data, sampler->bpixmap->pixel(color), 0xff);
+    }
+    // opaque?
+    else if (GB_ALPHA_IS_OPAQUE(alpha) && (!sampler->premultiplied || color.a == 0xff)) sampler->opixmap->pixel_set(data, sampler->opixmap->pixel(color), 0xff);
+    // alpha?
+    else if (alpha >= GB_ALPHA_MINN) sampler->apixmap->pixel_set(data, sampler->apixmap->pixel(color), (tb_byte_t)alpha);
+}
+static tb_void_t gb_bitmap_render_sampler_done_row(gb_bitmap_render_sampler_ref_t sampler, tb_long_t x, tb_long_t y, tb_size_t count, tb_long_t ox, tb_long_t oy)
+{
+    // check
+    tb_assert(sampler && count);
+
+    // the pixels
+    tb_byte_t*          d = sampler->ddata + y * sampler->drow_bytes + x * sampler->dbtp;
+    tb_byte_t const*    s = gb_bitmap_render_sampler_at(sampler, x - ox, y - oy);
+    tb_size_t           dbtp = sampler->dbtp;
+    tb_size_t           sbtp = sampler->sbtp;
+
+    // copy the source pixels directly?
+    if (sampler->cpixmap)
+    {
+        // copy the whole row
+        if (sampler->copy) tb_memcpy(d, s, count * dbtp);
+        else
+        {
+            // done
+            tb_byte_t                   alpha = sampler->alpha;
+            gb_pixmap_func_pixel_cpy_t  pixel_cpy = sampler->cpixmap->pixel_cpy;
+            while (count--)
+            {
+                pixel_cpy(d, s, alpha);
+                d += dbtp;
+                s += sbtp;
+            }
+        }
+    }
+    else
+    {
+        // done
+        gb_pixmap_func_color_get_t color_get = sampler->spixmap->color_get;
+        while (count--)
+        {
+            gb_bitmap_render_sampler_color_set(sampler, d, color_get(s), x++, y);
+            d += dbtp;
+            s += sbtp;
+        }
+    }
+}
+static tb_void_t gb_bitmap_render_sampler_done_span(gb_bitmap_render_sampler_ref_t sampler, tb_long_t x, tb_long_t y, tb_size_t count, tb_fixed_t u, tb_fixed_t v, tb_fixed_t du, tb_fixed_t dv)
+{
+    // check
+    tb_assert(sampler && count);
+
+    // the destination pixels
+    tb_byte_t*  d = sampler->ddata + y * sampler->drow_bytes + x * sampler->dbtp;
+    tb_size_t   dbtp = sampler->dbtp;
+
+    // filter the premultiplied source pixels and blend them to the same pixfmt directly?
+    if (sampler->filter && sampler->cpixmap && sampler->spremultiplied)
+    {
+        // the blend pixmap takes the source with the paint alpha and the full coverage
+        tb_byte_t                   alpha = sampler->alpha;
+        tb_byte_t                   coverage = sampler->bpixmap? 0xff : alpha;
+        tb_uint32_t                 pixel = 0;
+        gb_pixmap_func_pixel_set_t  pixel_set = sampler->cpixmap->pixel_set;
+        while (count--)
+        {
+            pixel = gb_bitmap_render_sampler_bilinear_pixel(sampler, u, v);
+            if (sampler->bpixmap && alpha != 0xff) pixel = gb_bitmap_render_sampler_fade(pixel, alpha);
+            pixel_set(d, pixel, coverage);
+            d += dbtp;
+            u += du;
+            v += dv;
+        }
+    }
+    // filter it?
+    else if (sampler->filter)
+    {
+        while (count--)
+        {
+            gb_bitmap_render_sampler_color_set(sampler, d, gb_bitmap_render_sampler_bilinear(sampler, u, v), x++, y);
+            d += dbtp;
+            u += du;
+            v += dv;
+        }
+    }
+    // copy the source pixels directly?
+    else if (sampler->cpixmap)
+    {
+        tb_byte_t                   alpha = sampler->alpha;
+        gb_pixmap_func_pixel_cpy_t  pixel_cpy = sampler->cpixmap->pixel_cpy;
+        while (count--)
+        {
+            pixel_cpy(d, gb_bitmap_render_sampler_at(sampler, u >> 16, v >> 16), alpha);
+            d += dbtp;
+            u += du;
+            v += dv;
+        }
+    }
+    else
+    {
+        while (count--)
+        {
+            gb_bitmap_render_sampler_color_set(sampler, d, gb_bitmap_render_sampler_nearest(sampler, u, v), x++, y);
+            d += dbtp;
+            u += du;
+            v += dv;
+        }
+    }
+}
+static tb_bool_t gb_bitmap_render_sampler_init(gb_bitmap_render_sampler_ref_t sampler, gb_bitmap_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t rect)
+{
+    // check
+    tb_assert(sampler && device && device->bitmap && device->base.paint && bitmap && rect);
+
+    // the source bounds
+    tb_long_t sw = (tb_long_t)gb_bitmap_width(bitmap);
+    tb_long_t sh = (tb_long_t)gb_bitmap_height(bitmap);
+    sampler->sx0 = gb_bitmap_render_clamp(gb_floor(rect->x), 0, sw);
+    sampler->sy0 = gb_bitmap_render_clamp(gb_floor(rect->y), 0, sh);
+    sampler->sx1 = gb_bitmap_render_clamp(gb_ceil(rect->x + rect->w), 0, sw);
+    sampler->sy1 = gb_bitmap_render_clamp(gb_ceil(rect->y + rect->h), 0, sh);
+    tb_check_return_val(sampler->sx0 < sampler->sx1 && sampler->sy0 < sampler->sy1, tb_false);
+
+    // the alpha and blend mode
+    tb_size_t blend = gb_paint_blend(device->base.paint);
+    sampler->alpha  = gb_paint_alpha(device->base.paint);
+
+    // blend it in the linear-light color space? only for the source-over mode
+    tb_bool_t linear = ((gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_LINEAR) && blend == GB_PAINT_BLEND_SRC_OVER)? tb_true : tb_false;
+
+    // transparent? only for the source-over mode
+    tb_check_return_val(blend != GB_PAINT_BLEND_SRC_OVER || sampler->alpha >= GB_ALPHA_MINN, tb_false);
+
+    // init the source
+    sampler->sdata      = (tb_byte_t const*)gb_bitmap_data(bitmap);
+    sampler->srow_bytes = gb_bitmap_row_bytes(bitmap);
+    sampler->spixmap    = gb_pixmap(gb_bitmap_pixfmt(bitmap), 0xff);
+    sampler->has_alpha  = gb_bitmap_has_alpha(bitmap);
+    sampler->spremultiplied = GB_PIXFMT_IS_PREMULTIPLIED(gb_bitmap_pixfmt(bitmap))? tb_true : tb_false;
+    tb_assert_and_check_return_val(sampler->sdata && sampler->spixmap && sampler->spixmap->color_get, tb_false);
+
+    // init the destination
+    tb_size_t pixfmt    = gb_bitmap_pixfmt(device->bitmap);
+    sampler->ddata      = (tb_byte_t*)gb_bitmap_data(device->bitmap);
+    sampler->drow_bytes = gb_bitmap_row_bytes(device->bitmap);
+    sampler->opixmap    = gb_pixmap(pixfmt, 0xff);
+    sampler->apixmap    = linear? gb_pixmap_linear(pixfmt, GB_ALPHA_MINN) : gb_pixmap(pixfmt, GB_ALPHA_MINN);
+    sampler->bpixmap    = blend != GB_PAINT_BLEND_SRC_OVER? gb_pixmap_blend(pixfmt, blend, sampler->alpha) : tb_null;
+    sampler->premultiplied = GB_PIXFMT_IS_PREMULTIPLIED(pixfmt)? tb_true : tb_false;
+    tb_assert_and_check_return_val(sampler->ddata && sampler->opixmap && sampler->apixmap, tb_false);
+
+    // this blend mode is not supported for the pixfmt?
+    tb_check_return_val(blend == GB_PAINT_BLEND_SRC_OVER || sampler->bpixmap, tb_false);
+
+    // the pal8 destination need the palette for mapping the source colors
+    sampler->palette = gb_bitmap_palette(device->bitmap);
+    tb_check_return_val(GB_PIXFMT(pixfmt) != GB_PIXFMT(GB_PIXFMT_PAL8) || sampler->palette, tb_false);
+
+    // init the bytes per-pixel
+    sampler->sbtp = sampler->spixmap->btp;
+    sampler->dbtp = sampler->opixmap->btp;
+
+    /* the same pixfmt without the source alpha? copy the source pixels directly
+     *
+     * the premultiplied source pixels with alpha can be blended directly too, 
+     * but the source-over mode need use the alpha pixmap even if the paint is opaque
+     */
+    if (gb_bitmap_pixfmt(bitmap) == pixfmt && gb_bitmap_palette(bitmap) == sampler->palette)
+    {
+        if (!sampler->has_alpha) sampler->cpixmap = linear? gb_pixmap_linear(pixfmt, sampler->alpha) : gb_pixmap_blend(pixfmt, blend, sampler->alpha);
+        else if (sampler->premultiplied) sampler->cpixmap = blend == GB_PAINT_BLEND_SRC_OVER? sampler->apixmap : sampler->bpixmap;
+        else sampler->cpixmap = tb_null;
+    }
+    else sampler->cpixmap = tb_null;
+
+    // copy the source rows directly if the source pixels are opaque and will replace the destination pixels
+    sampler->copy = sampler->cpixmap && (   (blend == GB_PAINT_BLEND_SRC_OVER && !sampler->has_alpha && GB_ALPHA_IS_OPAQUE(sampler->alpha))
+                                        ||  (blend == GB_PAINT_BLEND_SRC && sampler->alpha == 0xff));
+
+    // filter bitmap?
+    sampler->filter = (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_FILTER_BITMAP)? tb_true : tb_false;
+
+    // dither the sampled colors for the low-depth destination
+    sampler->dither = gb_pixmap_dither_steps(sampler->opixmap);
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t gb_bitmap_render_fill_bitmap(gb_bitmap_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t rect, gb_matrix_ref_t matrix)
+{
+    // check
+    tb_assert(device && device->bitmap && bitmap && rect && matrix);
+
+    // init sampler
+    gb_bitmap_render_sampler_t sampler;
+    if (!gb_bitmap_render_sampler_init(&sampler, device, bitmap, rect)) return ;
+
+    // the device width and height
+    tb_long_t width     = (tb_long_t)gb_bitmap_width(device->bitmap);
+    tb_long_t height    = (tb_long_t)gb_bitmap_height(device->bitmap);
+
+    /* translate only with the integer offset? 
+     *
+     * no sampling, only copy the source rows
+     */
+    tb_long_t ox = gb_float_to_long(matrix->tx);
+    tb_long_t oy = gb_float_to_long(matrix->ty);
+    if (    GB_ONE == matrix->sx && GB_ONE == matrix->sy 
+        &&  0 == matrix->kx && 0 == matrix->ky
+        &&  gb_long_to_float(ox) == matrix->tx && gb_long_to_float(oy) == matrix->ty)
+    {
+        // clip the source bounds to the device
+        tb_long_t xb = tb_max(sampler.sx0 + ox, 0);
+        tb_long_t yb = tb_max(sampler.sy0 + oy, 0);
+        tb_long_t xe = tb_min(sampler.sx1 + ox, width);
+        tb_long_t ye = tb_min(sampler.sy1 + oy, height);
+        tb_check_return(xb < xe && yb < ye);
+
+        // done rows
+        for (; yb < ye; yb++) gb_bitmap_render_sampler_done_row(&sampler, xb, yb, xe - xb, ox, oy);
+        return ;
+    }
+
+    // make the device bounds
+    gb_rect_t   bounds;
+    gb_point_t  points[4];
+    gb_point_make(&points[0], gb_long_to_float(sampler.sx0), gb_long_to_float(sampler.sy0));
+    gb_point_make(&points[1], gb_long_to_float(sampler.sx1), gb_long_to_float(sampler.sy0));
+    gb_point_make(&points[2], gb_long_to_float(sampler.sx1), gb_long_to_float(sampler.sy1));
+    gb_point_make(&points[3], gb_long_to_float(sampler.sx0), gb_long_to_float(sampler.sy1));
+    gb_matrix_apply_points(matrix, points, tb_arrayn(points));
+    gb_bounds_make(&bounds, points, tb_arrayn(points));
+
+    // clip the bounds to the device
+    tb_long_t bx0 = gb_bitmap_render_clamp(gb_floor(bounds.x), 0, width);
+    tb_long_t by0 = gb_bitmap_render_clamp(gb_floor(bounds.y), 0, height);
+    tb_long_t bx1 = gb_bitmap_render_clamp(gb_ceil(bounds.x + bounds.w), 0, width);
+    tb_long_t by1 = gb_bitmap_render_clamp(gb_ceil(bounds.y + bounds.h), 0, height);
+    tb_check_return(bx0 < bx1 && by0 < by1);
+
+    // invert matrix: device => source
+    gb_matrix_t inverse = *matrix;
+    if (!gb_matrix_invert(&inverse)) return ;
+
+    /* the inverse mapping for the center of the device pixel (x, y)
+     *
+     * u = isx * (x + 0.5) + ikx * (y + 0.5) + itx
+     * v = iky * (x + 0.5) + isy * (y + 0.5) + ity
+     */
+    tb_hong_t isx = gb_float_to_fixed(inverse.sx);
+    tb_hong_t ikx = gb_float_to_fixed(inverse.kx);
+    tb_hong_t itx = gb_float_to_fixed(inverse.tx);
+    tb_hong_t iky = gb_float_to_fixed(inverse.ky);
+    tb_hong_t isy = gb_float_to_fixed(inverse.sy);
+    tb_hong_t ity = gb_float_to_fixed(inverse.ty);
+
+    // the source bounds
+    tb_hong_t ub = (tb_hong_t)sampler.sx0 << 16;
+    tb_hong_t ue = (tb_hong_t)sampler.sx1 << 16;
+    tb_hong_t vb = (tb_hong_t)sampler.sy0 << 16;
+    tb_hong_t ve = (tb_hong_t)sampler.sy1 << 16;
+
+    /* scale only? 
+     *
+     * u is independent of y and v is independent of x, 
+     * so the span of x only need be clipped once
+     */
+    tb_bool_t   scale = (0 == ikx && 0 == iky);
+    tb_long_t   sxb = bx0;
+    tb_long_t   sxe = bx1;
+    if (scale) gb_bitmap_render_clip_span(itx + (isx >> 1), isx, ub, ue, &sxb, &sxe);
+    tb_check_return(sxb < sxe);
+
+    // done rows
+    tb_long_t y;
+    for (y = by0; y < by1; y++)
+    {
+        // u and v at the center of (0, y)
+        tb_hong_t u = itx + (isx >> 1) + ((ikx * ((y << 1) + 1)) >> 1);
+        tb_hong_t v = ity + (iky >> 1) + ((isy * ((y << 1) + 1)) >> 1);
+
+        // clip the span
+        tb_long_t xb = sxb;
+        tb_long_t xe = sxe;
+        if (!scale) gb_bitmap_render_clip_span(u, isx, ub, ue, &xb, &xe);
+        gb_bitmap_render_clip_span(v, iky, vb, ve, &xb, &xe);
+
+        // done span
+        if (xb < xe) gb_bitmap_render_sampler_done_span(&sampler, xb, y, xe - xb, (tb_fixed_t)(u + isx * xb), (tb_fixed_t)(v + iky * xb), (tb_fixed_t)isx, (tb_fixed_t)iky);
+    }
+}
@@ -38,120 +38,290 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_size_t gb_bitmap_render_stroke_line_generic(gb_bitmap_biltter_ref_t biltter, tb_fixed6_t xb, tb_fixed6_t yb, tb_fixed6_t xe, tb_fixed6_t ye)
+static tb_void_t gb_bitmap_render_stroke_line_walk(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_fixed_t minor, tb_fixed_t slope, tb_size_t count, tb_bool_t xmajor)
 {
-    // round coordinates
+    // check
+    tb_assert(biltter && biltter->pixmap && biltter->pixmap->pixel_set && biltter->done_p && count);
+
+    /* the pixels are dithered or remapped to the palette? walk them by the biltter
+     *
+     * the hairline is only stroked by the solid biltter, see gb_bitmap_render_stroke_only()
+     */
+    tb_long_t   m = tb_fixed_round(minor);
+    tb_long_t   n = 0;
+    if (!biltter->u.solid.direct)
+    {
+        tb_long_t dx = xmajor? 1 : 0;
+        tb_long_t dy = xmajor? 0 : 1;
+        while (1)
+        {
+            // done
+            biltter->done_p(biltter, x, y);
+
+            // end?
+            if (!--count) break;
+
+            // the next minor coordinate, only changed by -1, 0 or 1
+            minor += slope;
+            n = tb_fixed_round(minor);
+
+            // the next pixel
+            x += dx + (n - m) * dy;
+            y += dy + (n - m) * dx;
+            m = n;
+        }
+        return ;
+    }
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // the steps for the major and minor axis
+    tb_long_t                   major_step = xmajor? (tb_long_t)biltter->btp : (tb_long_t)biltter->row_bytes;
+    tb_long_t                   minor_step = xmajor? (tb_long_t)biltter->row_bytes : (tb_long_t)biltter->btp;
+    gb_pixel_t                  pixel = biltter->u.solid.pixel;
+    tb_byte_t                   alpha = biltter->u.solid.alpha;
+    gb_pixmap_func_pixel_set_t  pixel_set = biltter->pixmap->pixel_set;
+
+    // walk the pixel pointer
+    tb_byte_t* p = pixels + y * biltter->row_bytes + x * biltter->btp;
+    while (1)
+    {
+        // done
+        pixel_set(p, pixel, alpha);
+
+        // end?
+        if (!--count) break;
+
+        // the next minor coordinate, only changed by -1, 0 or 1
+        minor += slope;
+        n = tb_fixed_round(minor);
+
+        // the next pixel
+        p += major_step + (n - m) * minor_step;
+        m = n;
+    }
+}
+static tb_void_t gb_bitmap_render_stroke_line_xmajor(gb_bitmap_biltter_ref_t biltter, tb_fixed6_t xb, tb_fixed6_t yb, tb_fixed6_t xe, tb_fixed6_t ye, tb_long_t width, tb_long_t height)
+{
+    // reverse it for xb => xe
+    if (xb > xe)
+    {
+        tb_swap(tb_fixed6_t, xb, xe);
+        tb_swap(tb_fixed6_t, yb, ye);
+    }
+
+    // round the x-coordinates
     tb_long_t ixb = tb_fixed6_round(xb);
-    tb_long_t iyb = tb_fixed6_round(yb);
     tb_long_t ixe = tb_fixed6_round(xe);
-    tb_long_t iye = tb_fixed6_round(ye);
 
-    // horizontal?
-    if (iyb == iye) return 'h';
+    // too short? ignore it
+    tb_check_return(ixb != ixe);
 
-    // vertical?
-    if (ixb == ixe) return 'v';
+    // compute the slope
+    tb_fixed_t slope = tb_fixed6_div(ye - yb, xe - xb);
 
-    // the dx and dy
-    tb_fixed6_t dx = xe - xb;
-    tb_fixed6_t dy = ye - yb;
+    /* compute the more accurate start y-coordinate
+     *
+     * yb + (ixb - xb + 0.5) * dy / dx
+     * => yb + ((0.5 - xb) % 1) * dy / dx
+     */
+    tb_fixed_t start_y = tb_fixed6_to_fixed(yb) + ((slope * ((TB_FIXED6_HALF - xb) & 63)) >> 6);
 
-    /* more horizontal?
-     *                       .
-     *                  .
-     *            .
-     *      .
-     * .
+    /* clip the span [x, e) once for the whole line
+     *
+     * 0 <= x < width
+     * 0 <= round(start_y + (x - ixb) * slope) < height
      */
-    if (tb_fixed6_abs(dx) > tb_fixed6_abs(dy))
+    tb_long_t x = tb_max(ixb, 0);
+    tb_long_t e = tb_min(ixe, width);
+    tb_check_return(x < e);
+    gb_bitmap_render_clip_span((tb_hong_t)start_y + TB_FIXED_HALF - (tb_hong_t)slope * ixb, slope, 0, (tb_hong_t)height << 16, &x, &e);
+    tb_check_return(x < e);
+
+    // the y-coordinate of the first pixel
+    start_y += (tb_fixed_t)((tb_hong_t)slope * (x - ixb));
+
+    // more horizontal? done the horizontal runs
+    if (tb_fixed_abs(slope) <= TB_FIXED_HALF)
     {
-        // reverse it for xb => xe
-        if (xb > xe)
+        tb_long_t b = x;
+        tb_long_t y = tb_fixed_round(start_y);
+        tb_long_t n = 0;
+        while (++x < e)
         {
-            tb_swap(tb_fixed6_t, xb, xe);
-            tb_swap(tb_fixed6_t, yb, ye);
-            tb_swap(tb_fixed6_t, ixb, ixe);
+            // the next y-coordinate
+            start_y += slope;
+            n = tb_fixed_round(start_y);
+
+            // the run is finished?
+            if (n != y)
+            {
+                gb_bitmap_biltter_done_h(biltter, b, y, x - b);
+                b = x;
+                y = n;
+            }
         }
 
-        // too short? ignore it
-        tb_check_return_val(ixb != ixe, 0);
+        // done the last run
+        gb_bitmap_biltter_done_h(biltter, b, y, x - b);
+    }
+    // walk the pixels for the diagonal line
+    else gb_bitmap_render_stroke_line_walk(biltter, x, tb_fixed_round(start_y), start_y, slope, e - x, tb_true);
+}
+static tb_void_t gb_bitmap_render_stroke_line_ymajor(gb_bitmap_biltter_ref_t biltter, tb_fixed6_t xb, tb_fixed6_t yb, tb_fixed6_t xe, tb_fixed6_t ye, tb_long_t width, tb_long_t height)
+{
+    // reverse it for yb => ye
+    if (yb > ye)
+    {
+        tb_swap(tb_fixed6_t, xb, xe);
+        tb_swap(tb_fixed6_t, yb, ye);
+    }
 
-        // compute the slope
-        tb_fixed_t slope = tb_fixed6_div(dy, dx);
+    // round the y-coordinates
+    tb_long_t iyb = tb_fixed6_round(yb);
+    tb_long_t iye = tb_fixed6_round(ye);
 
-        /* compute the more accurate start y-coordinate
-         *
-         * yb + (ixb - xb + 0.5) * dy / dx
-         * => yb + ((0.5 - xb) % 1) * dy / dx
-         */
-        tb_fixed_t start_y = tb_fixed6_to_fixed(yb) + ((slope * ((TB_FIXED6_HALF - xb) & 63)) >> 6);
+    // too short? ignore it
+    tb_check_return(iyb != iye);
 
-        // check
-        tb_assert(ixb < ixe);
+    // compute the slope
+    tb_fixed_t slope = tb_fixed6_div(xe - xb, ye - yb);
 
-        // done
-        do
-        {
-            // done biltter
-            gb_bitmap_biltter_done_p(biltter, ixb, tb_fixed_round(start_y));
+    /* compute the more accurate start x-coordinate
+     *
+     * xb + (iyb - yb + 0.5) * dx / dy
+     * => xb + ((0.5 - yb) % 1) * dx / dy
+     */
+    tb_fixed_t start_x = tb_fixed6_to_fixed(xb) + ((slope * ((TB_FIXED6_HALF - yb) & 63)) >> 6);
 
-            // update the y-coordinate
-            start_y += slope;
-           
-        } while (++ixb < ixe);
-    }
-    /* more vertical?
+    /* clip the span [y, e) once for the whole line
      *
-     *       .
-     *      .
-     *     .
-     *    .
-     *   .
-     *  .
-     * .
+     * 0 <= y < height
+     * 0 <= round(start_x + (y - iyb) * slope) < width
      */
-    else 
+    tb_long_t y = tb_max(iyb, 0);
+    tb_long_t e = tb_min(iye, height);
+    tb_check_return(y < e);
+    gb_bitmap_render_clip_span((tb_hong_t)start_x + TB_FIXED_HALF - (tb_hong_t)slope * iyb, slope, 0, (tb_hong_t)width << 16, &y, &e);
+    tb_check_return(y < e);
+
+    // the x-coordinate of the first pixel
+    start_x += (tb_fixed_t)((tb_hong_t)slope * (y - iyb));
+
+    // more vertical? done the vertical runs
+    if (tb_fixed_abs(slope) <= TB_FIXED_HALF)
     {
-        // reverse it for yb => ye
-        if (yb > ye)
+        tb_long_t b = y;
+        tb_long_t x = tb_fixed_round(start_x);
+        tb_long_t n = 0;
+        while (++y < e)
         {
-            tb_swap(tb_fixed6_t, xb, xe);
-            tb_swap(tb_fixed6_t, yb, ye);
-            tb_swap(tb_fixed6_t, iyb, iye);
+            // the next x-coordinate
+            start_x += slope;
+            n = tb_fixed_round(start_x);
+
+            // the run is finished?
+            if (n != x)
+            {
+                gb_bitmap_biltter_done_v(biltter, x, b, y - b);
+                b = y;
+                x = n;
+            }
         }
 
-        // too short? ignore it
-        tb_check_return_val(iyb != iye, 0);
+        // done the last run
+        gb_bitmap_biltter_done_v(biltter, x, b, y - b);
+    }
+    // walk the pixels for the diagonal line
+    else gb_bitmap_render_stroke_line_walk(biltter, tb_fixed_round(start_x), y, start_x, slope, e - y, tb_false);
+}
+static tb_void_t gb_bitmap_render_stroke_line_antialiasing(gb_bitmap_biltter_ref_t biltter, tb_fixed6_t xb, tb_fixed6_t yb, tb_fixed6_t xe, tb_fixed6_t ye, tb_long_t width, tb_long_t height)
+{
+    // check
+    tb_assert(biltter && biltter->done_a);
+
+    /* more vertical? swap the x and y axis
+     *
+     * the major axis is always the x-axis below
+     */
+    tb_bool_t xmajor = tb_true;
+    if (tb_fixed6_abs(ye - yb) > tb_fixed6_abs(xe - xb))
+    {
+        tb_swap(tb_fixed6_t, xb, yb);
+        tb_swap(tb_fixed6_t, xe, ye);
+        tb_swap(tb_long_t, width, height);
+        xmajor = tb_false;
+    }
+
+    // reverse it for xb => xe
+    if (xb > xe)
+    {
+        tb_swap(tb_fixed6_t, xb, xe);
+        tb_swap(tb_fixed6_t, yb, ye);
+    }
+
+    // empty? ignore it
+    tb_check_return(xb < xe);
+
+    // compute the slope
+    tb_fixed_t slope = tb_fixed6_div(ye - yb, xe - xb);
 
-        // compute the slope
-        tb_fixed_t slope = tb_fixed6_div(dx, dy);
+    /* the pixel centers are at the integer coordinates, the same as the aliased lines
+     *
+     * the column x covers [x - 0.5, x + 0.5) and y(x) = yb + (x - xb) * dy / dx
+     */
+    tb_long_t ixb = tb_fixed6_round(xb);
+    tb_long_t ixe = tb_fixed6_round(xe);
 
-        /* compute the more accurate start x-coordinate
+    // clip the columns [x, e]
+    tb_long_t x = tb_max(ixb, 0);
+    tb_long_t e = tb_min(ixe, width - 1);
+    tb_check_return(x <= e);
+
+    // the y-coordinate of the first column
+    tb_fixed_t y = tb_fixed6_to_fixed(yb) + (tb_fixed_t)(((tb_hong_t)slope * ((x << 6) - xb)) >> 6);
+
+    /* done
+     *
+     * the coverage is blended by the biltter, so the pixels are dithered or remapped to the palette too
+     */
+    tb_long_t   iy = 0;
+    tb_size_t   fy = 0;
+    tb_size_t   weight = 0;
+    tb_size_t   coverage = 0;
+    for (; x <= e; x++, y += slope)
+    {
+        /* the covered length of this column, [0, 64]
          *
-         * xb + (iyb - yb + 0.5) * dx / dy
-         * => xb + ((0.5 - yb) % 1) * dx / dy
+         * only the end columns are covered partially
          */
-        tb_fixed_t start_x = tb_fixed6_to_fixed(xb) + ((slope * ((TB_FIXED6_HALF - yb) & 63)) >> 6);
+        weight = TB_FIXED6_ONE;
+        if (x == ixb) weight = (tb_size_t)(((ixb << 6) + TB_FIXED6_HALF) - xb);
+        if (x == ixe) weight -= (tb_size_t)(((ixe << 6) + TB_FIXED6_HALF) - xe);
+        if (ixb == ixe) weight = (tb_size_t)(xe - xb);
 
-        // check
-        tb_assert(iyb < iye);
+        // the upper row and the fractional distance to it, [0, 256)
+        iy = y >> 16;
+        fy = (y >> 8) & 0xff;
 
-        // done
-        do
+        // the upper row: (1 - fy) * weight
+        if (iy >= 0 && iy < height && (coverage = ((256 - fy) * weight) >> 6))
         {
-            // done biltter
-            gb_bitmap_biltter_done_p(biltter, tb_fixed_round(start_x), iyb);
+            if (xmajor) biltter->done_a(biltter, x, iy, coverage);
+            else biltter->done_a(biltter, iy, x, coverage);
+        }
 
-            // update the x-coordinate
-            start_x += slope;
-           
-        } while (++iyb < iye);
+        // the lower row: fy * weight
+        if (fy && iy + 1 >= 0 && iy + 1 < height && (coverage = (fy * weight) >> 6))
+        {
+            if (xmajor) biltter->done_a(biltter, x, iy + 1, coverage);
+            else biltter->done_a(biltter, iy + 1, x, coverage);
+        }
     }
-
-    // ok
-    return 0;
 }
-static tb_void_t gb_bitmap_render_stroke_line_vertical(gb_bitmap_biltter_ref_t biltter, tb_fixed6_t xb, tb_fixed6_t yb, tb_fixed6_t xe, tb_fixed6_t ye)
+static tb_void_t gb_bitmap_render_stroke_line_vertical(gb_bitmap_biltter_ref_t biltter, tb_fixed6_t xb, tb_fixed6_t yb, tb_fixed6_t xe, tb_fixed6_t ye, tb_long_t width, tb_long_t height)
 {
     // ensure the order
     if (yb > ye) 
@@ -160,10 +330,20 @@ static tb_void_t gb_bitmap_render_stroke_line_vertical(gb_bitmap_biltter_ref_t b
         tb_swap(tb_long_t, yb, ye);
     }
 
+    // the x-coordinate
+    tb_long_t x = tb_fixed6_round(xb);
+    tb_check_return(x >= 0 && x < width);
+
+    // clip the span [y, e)
+    tb_long_t y = tb_fixed6_round(yb);
+    tb_long_t e = y + tb_fixed6_round(ye - yb + TB_FIXED6_ONE);
+    if (y < 0) y = 0;
+    if (e > height) e = height;
+
     // done
-    gb_bitmap_biltter_done_v(biltter, tb_fixed6_round(xb), tb_fixed6_round(yb), tb_fixed6_round(ye - yb + TB_FIXED6_ONE));
+    if (y < e) gb_bitmap_biltter_done_v(biltter, x, y, e - y);
 }
-static tb_void_t gb_bitmap_render_stroke_line_horizontal(gb_bitmap_biltter_ref_t biltter, tb_fixed6_t xb, tb_fixed6_t yb, tb_fixed6_t xe, tb_fixed6_t ye)
+static tb_void_t gb_bitmap_render_stroke_line_horizontal(gb_bitmap_biltter_ref_t biltter, tb_fixed6_t xb, tb_fixed6_t yb, tb_fixed6_t xe, tb_fixed6_t ye, tb_long_t width, tb_long_t height)
 {
     // ensure the order
     if (xb > xe) 
@@ -172,8 +352,18 @@ static tb_void_t gb_bitmap_render_stroke_line_horizontal(gb_bitmap_biltter_ref_t
         tb_swap(tb_long_t, xb, xe);
     }
 
+    // the y-coordinate
+    tb_long_t y = tb_fixed6_round(yb);
+    tb_check_return(y >= 0 && y < height);
+
+    // clip the span [x, e)
+    tb_long_t x = tb_fixed6_round(xb);
+    tb_long_t e = x + tb_fixed6_round(xe - xb + TB_FIXED6_ONE);
+    if (x < 0) x = 0;
+    if (e > width) e = width;
+
     // done
-    gb_bitmap_biltter_done_h(biltter, tb_fixed6_round(xb), tb_fixed6_round(yb), tb_fixed6_round(xe - xb + TB_FIXED6_ONE));
+    if (x < e) gb_bitmap_biltter_done_h(biltter, x, y, e - x);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -182,11 +372,17 @@ static tb_void_t gb_bitmap_render_stroke_line_horizontal(gb_bitmap_biltter_ref_t
 tb_void_t gb_bitmap_render_stroke_lines(gb_bitmap_device_ref_t device, gb_point_ref_t points, tb_size_t count)
 {
     // check
-    tb_assert(device && points && count && !(count & 0x1));
+    tb_assert(device && device->bitmap && points && count && !(count & 0x1));
+
+    // the device bounds
+    tb_long_t width     = (tb_long_t)gb_bitmap_width(device->bitmap);
+    tb_long_t height    = (tb_long_t)gb_bitmap_height(device->bitmap);
+
+    // antialiasing?
+    tb_bool_t antialiasing = gb_bitmap_render_antialiasing(device);
 
     // done
     tb_size_t       i   = 0;
-    tb_size_t       ok  = 0;
     gb_point_ref_t  pb  = tb_null;
     gb_point_ref_t  pe  = tb_null;
     tb_fixed6_t     xb  = 0;
@@ -205,16 +401,34 @@ tb_void_t gb_bitmap_render_stroke_lines(gb_bitmap_device_ref_t device, gb_point_
         xe = gb_float_to_fixed6(pe->x);
         ye = gb_float_to_fixed6(pe->y);
 
-        // done generic line
-        if ((ok = gb_bitmap_render_stroke_line_generic(&device->biltter, xb, yb, xe, ye)))
-        {
-            // check
-            tb_assert(ok == 'h' || ok == 'v');
-
-            // done horizontal line
-            if (ok == 'h') gb_bitmap_render_stroke_line_horizontal(&device->biltter, xb, yb, xe, ye);
-            // done vertical line
-            else gb_bitmap_render_stroke_line_vertical(&device->biltter, xb, yb, xe, ye);
-        }
+        // antialiasing and not on the pixel centers? 
+        if (antialiasing && !(yb == ye && !(yb & 63)) && !(xb == xe && !(xb & 63)))
+            gb_bitmap_render_stroke_line_antialiasing(&device->biltter, xb, yb, xe, ye, width, height);
+        // horizontal?
+        else if (tb_fixed6_round(yb) == tb_fixed6_round(ye)) 
+            gb_bitmap_render_stroke_line_horizontal(&device->biltter, xb, yb, xe, ye, width, height);
+        // vertical?
+        else if (tb_fixed6_round(xb) == tb_fixed6_round(xe)) 
+            gb_bitmap_render_stroke_line_vertical(&device->biltter, xb, yb, xe, ye, width, height);
+        /* more horizontal?
+         *                       .
+         *                  .
+         *            .
+         *      .
+         * .
+         */
+        else if (tb_fixed6_abs(xe - xb) > tb_fixed6_abs(ye - yb))
+            gb_bitmap_render_stroke_line_xmajor(&device->biltter, xb, yb, xe, ye, width, height);
+        /* more vertical?
+         *
+         *       .
+         *      .
+         *     .
+         *    .
+         *   .
+         *  .
+         * .
+         */
+        else gb_bitmap_render_stroke_line_ymajor(&device->biltter, xb, yb, xe, ye, width, height);
     }
 }
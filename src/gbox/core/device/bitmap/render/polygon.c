@@ -42,10 +42,18 @@
 static tb_void_t gb_bitmap_render_fill_raster(tb_long_t lx, tb_long_t rx, tb_long_t yb, tb_long_t ye, tb_cpointer_t priv)
 {
     // check
-    tb_assert(priv && rx >= lx && ye > yb);
+    gb_bitmap_biltter_ref_t biltter = (gb_bitmap_biltter_ref_t)priv;
+    tb_assert(biltter && biltter->bitmap && rx >= lx && ye > yb);
+
+    // clip it to the bitmap, the raster does not clip the polygon
+    lx = tb_max(lx, 0);
+    yb = tb_max(yb, 0);
+    rx = tb_min(rx, (tb_long_t)gb_bitmap_width(biltter->bitmap));
+    ye = tb_min(ye, (tb_long_t)gb_bitmap_height(biltter->bitmap));
+    tb_check_return(rx > lx && ye > yb);
 
     // done biltter
-    gb_bitmap_biltter_done_r((gb_bitmap_biltter_ref_t)priv, lx, yb, rx - lx, ye - yb);
+    gb_bitmap_biltter_done_r(biltter, lx, yb, rx - lx, ye - yb);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -56,8 +64,38 @@ tb_void_t gb_bitmap_render_fill_polygon(gb_bitmap_device_ref_t device, gb_polygo
     // check
     tb_assert(device && device->base.paint);
 
-    // done raster
-    gb_polygon_raster_done(device->raster, polygon, bounds, gb_paint_fill_rule(device->base.paint), gb_bitmap_render_fill_raster, &device->biltter);
+    // done raster, the sparse strip raster may be faster for the many small paths
+    if (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_SPARSE_RASTER)
+        gb_strip_raster_done(device->strip_raster, polygon, bounds, gb_paint_fill_rule(device->base.paint), gb_bitmap_render_fill_raster, &device->biltter);
+    else gb_polygon_raster_done(device->raster, polygon, bounds, gb_paint_fill_rule(device->base.paint), gb_bitmap_render_fill_raster, &device->biltter);
+}
+tb_void_t gb_bitmap_render_fill_mask(gb_bitmap_device_ref_t device, gb_mask_ref_t mask, tb_long_t dx, tb_long_t dy)
+{
+    // check
+    tb_assert(device && device->bitmap && mask);
+
+    // the width and height
+    tb_long_t width     = (tb_long_t)gb_bitmap_width(device->bitmap);
+    tb_long_t height    = (tb_long_t)gb_bitmap_height(device->bitmap);
+
+    // done
+    tb_long_t           xb;
+    tb_long_t           yb;
+    tb_long_t           xe;
+    tb_long_t           ye;
+    gb_mask_span_ref_t  span = mask->spans;
+    gb_mask_span_ref_t  tail = mask->spans + mask->count;
+    for (; span < tail; span++)
+    {
+        // stamp the span at the offset and clip it
+        xb = tb_max(span->x + dx, 0);
+        yb = tb_max(span->y + dy, 0);
+        xe = tb_min(span->x + dx + (tb_long_t)span->w, width);
+        ye = tb_min(span->y + dy + (tb_long_t)span->h, height);
+
+        // fill it
+        if (xe > xb && ye > yb) gb_bitmap_biltter_done_r(&device->biltter, xb, yb, xe - xb, ye - yb);
+    }
 }
 tb_void_t gb_bitmap_render_stroke_polygon(gb_bitmap_device_ref_t device, gb_polygon_ref_t polygon)
 {
@@ -48,6 +48,15 @@ __tb_extern_c_enter__
  */
 tb_void_t           gb_bitmap_render_fill_polygon(gb_bitmap_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds);
 
+/* fill the cached mask of polygon
+ *
+ * @param device    the device
+ * @param mask      the mask
+ * @param dx        the x-offset of the mask
+ * @param dy        the y-offset of the mask
+ */
+tb_void_t           gb_bitmap_render_fill_mask(gb_bitmap_device_ref_t device, gb_mask_ref_t mask, tb_long_t dx, tb_long_t dy);
+
 /* stroke polygon
  *
  * @param device    the device
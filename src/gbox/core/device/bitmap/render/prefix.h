@@ -31,6 +31,64 @@
 #include "../prefix.h"
 #include "../device.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+static __tb_inline__ tb_hong_t gb_bitmap_render_floor_div(tb_hong_t n, tb_hong_t d)
+{
+    // check
+    tb_assert(d > 0);
+
+    // floor(n / d)
+    return n >= 0? n / d : -((-n + d - 1) / d);
+}
+static __tb_inline__ tb_hong_t gb_bitmap_render_ceil_div(tb_hong_t n, tb_hong_t d)
+{
+    // ceil(n / d)
+    return -gb_bitmap_render_floor_div(-n, d);
+}
+static __tb_inline__ tb_void_t gb_bitmap_render_clip_span(tb_hong_t a, tb_hong_t b, tb_hong_t lo, tb_hong_t hi, tb_long_t* xb, tb_long_t* xe)
+{
+    // check
+    tb_assert(xb && xe);
+
+    /* narrow the span [xb, xe) for lo <= a + b * x < hi
+     *
+     * b > 0: ceil((lo - a) / b) <= x < ceil((hi - a) / b)
+     * b < 0: floor((a - hi) / -b) < x <= floor((a - lo) / -b)
+     */
+    tb_hong_t l;
+    tb_hong_t r;
+    if (b > 0)
+    {
+        l = gb_bitmap_render_ceil_div(lo - a, b);
+        r = gb_bitmap_render_ceil_div(hi - a, b);
+    }
+    else if (b < 0)
+    {
+        l = gb_bitmap_render_floor_div(a - hi, -b) + 1;
+        r = gb_bitmap_render_floor_div(a - lo, -b) + 1;
+    }
+    else 
+    {
+        // all or nothing
+        if (a < lo || a >= hi) *xe = *xb;
+        return ;
+    }
+
+    // narrow it
+    if (l > *xb) *xb = (tb_long_t)tb_min(l, (tb_hong_t)*xe);
+    if (r < *xe) *xe = (tb_long_t)tb_max(r, (tb_hong_t)*xb);
+}
+static __tb_inline__ tb_bool_t gb_bitmap_render_antialiasing(gb_bitmap_device_ref_t device)
+{
+    // check
+    tb_assert(device && device->base.paint);
+
+    // antialiasing? the coverage is blended by the biltter, .e.g the dithered or the palette pixels
+    return (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_ANTIALIASING) && device->biltter.done_a;
+}
+
 #endif
 
 
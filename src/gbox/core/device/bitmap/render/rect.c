@@ -43,6 +43,23 @@ tb_void_t gb_bitmap_render_fill_rect(gb_bitmap_device_ref_t device, gb_rect_ref_
     // check
     tb_assert(device && rect);
 
+    // the device size
+    tb_long_t width     = (tb_long_t)gb_bitmap_width(device->bitmap);
+    tb_long_t height    = (tb_long_t)gb_bitmap_height(device->bitmap);
+
+    // the rect
+    tb_long_t x         = gb_float_to_long(rect->x);
+    tb_long_t y         = gb_float_to_long(rect->y);
+    tb_long_t w         = gb_float_to_long(rect->w);
+    tb_long_t h         = gb_float_to_long(rect->h);
+
+    // clip it to the device, the biltter does not check the pixels range
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > width) w = width - x;
+    if (y + h > height) h = height - y;
+    tb_check_return(w > 0 && h > 0);
+
     // done biltter
-    gb_bitmap_biltter_done_r(&device->biltter, gb_float_to_long(rect->x), gb_float_to_long(rect->y), gb_float_to_long(rect->w), gb_float_to_long(rect->h));
+    gb_bitmap_biltter_done_r(&device->biltter, x, y, w, h);
 }
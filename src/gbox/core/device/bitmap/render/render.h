@@ -30,9 +30,11 @@
  */
 #include "prefix.h"
 #include "rect.h"
+#include "round_rect.h"
 #include "lines.h"
 #include "points.h"
 #include "polygon.h"
+#include "bitmap.h"
 
 #endif
 
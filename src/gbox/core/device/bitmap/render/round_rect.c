@@ -0,0 +1,310 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        round_rect.c
+ * @ingroup     core
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "bitmap_round_rect"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "round_rect.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the sub-rows bits of each row for the antialiasing coverage
+#define GB_BITMAP_RENDER_ROUND_RECT_SUBROWS_BITS    (3)
+
+// the sub-rows count of each row for the antialiasing coverage
+#define GB_BITMAP_RENDER_ROUND_RECT_SUBROWS         (1 << GB_BITMAP_RENDER_ROUND_RECT_SUBROWS_BITS)
+
+// the maximum coordinate, the coordinates and their differences need be in the range of the 16.16 fixed-point
+#define GB_BITMAP_RENDER_ROUND_RECT_MAXC            (16384)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the fixed round rect type
+typedef struct __gb_bitmap_render_round_rect_t
+{
+    // the bounds: [x0, x1) x [y0, y1)
+    tb_fixed_t              x0;
+    tb_fixed_t              y0;
+    tb_fixed_t              x1;
+    tb_fixed_t              y1;
+
+    // the x-radius of the corners
+    tb_fixed_t              rx[GB_RECT_CORNER_MAXN];
+
+    // the y-radius of the corners
+    tb_fixed_t              ry[GB_RECT_CORNER_MAXN];
+
+}gb_bitmap_render_round_rect_t, *gb_bitmap_render_round_rect_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_uint32_t gb_bitmap_render_round_rect_isqrt(tb_hize_t x)
+{
+    // the highest bit of the result
+    tb_hize_t b = (tb_hize_t)1 << 62;
+    while (b > x) b >>= 2;
+
+    // compute it bit by bit
+    tb_hize_t r = 0;
+    while (b)
+    {
+        if (x >= r + b)
+        {
+            x -= r + b;
+            r = (r >> 1) + b;
+        }
+        else r >>= 1;
+        b >>= 2;
+    }
+
+    // ok
+    return (tb_uint32_t)r;
+}
+static tb_fixed_t gb_bitmap_render_round_rect_inset(tb_fixed_t rx, tb_fixed_t ry, tb_fixed_t dy)
+{
+    // check
+    tb_assert(ry > 0 && dy >= 0 && dy <= ry);
+
+    /* the corner arc: (dx / rx)^2 + (dy / ry)^2 = 1 
+     *
+     * dx = rx * sqrt((ry - dy) * (ry + dy)) / ry
+     */
+    tb_hize_t s = gb_bitmap_render_round_rect_isqrt((tb_hize_t)(ry - dy) * (tb_hize_t)(ry + dy));
+    return rx - (tb_fixed_t)(((tb_hize_t)rx * s) / (tb_hize_t)ry);
+}
+static tb_bool_t gb_bitmap_render_round_rect_row(gb_bitmap_render_round_rect_ref_t rect, tb_fixed_t y, tb_fixed_t* l, tb_fixed_t* r)
+{
+    // check
+    tb_assert(rect && l && r);
+
+    // outside?
+    tb_check_return_val(y >= rect->y0 && y < rect->y1, tb_false);
+
+    // the left side, inset it at the left-top or left-bottom corner
+    tb_fixed_t yt = rect->y0 + rect->ry[GB_RECT_CORNER_LT];
+    tb_fixed_t yb = rect->y1 - rect->ry[GB_RECT_CORNER_LB];
+    *l = rect->x0;
+    if (y < yt) *l += gb_bitmap_render_round_rect_inset(rect->rx[GB_RECT_CORNER_LT], rect->ry[GB_RECT_CORNER_LT], yt - y);
+    else if (y > yb) *l += gb_bitmap_render_round_rect_inset(rect->rx[GB_RECT_CORNER_LB], rect->ry[GB_RECT_CORNER_LB], y - yb);
+
+    // the right side, inset it at the right-top or right-bottom corner
+    yt = rect->y0 + rect->ry[GB_RECT_CORNER_RT];
+    yb = rect->y1 - rect->ry[GB_RECT_CORNER_RB];
+    *r = rect->x1;
+    if (y < yt) *r -= gb_bitmap_render_round_rect_inset(rect->rx[GB_RECT_CORNER_RT], rect->ry[GB_RECT_CORNER_RT], yt - y);
+    else if (y > yb) *r -= gb_bitmap_render_round_rect_inset(rect->rx[GB_RECT_CORNER_RB], rect->ry[GB_RECT_CORNER_RB], y - yb);
+
+    // not empty?
+    return *l < *r;
+}
+static tb_void_t gb_bitmap_render_round_rect_fill(gb_bitmap_biltter_ref_t biltter, gb_bitmap_render_round_rect_ref_t rect, tb_long_t width, tb_long_t height)
+{
+    // check
+    tb_assert(biltter && rect);
+
+    // the rows [y, e), the pixel centers are at the half coordinates, the same as the polygon raster
+    tb_long_t y = tb_max(tb_fixed_round(rect->y0), 0);
+    tb_long_t e = tb_min(tb_fixed_round(rect->y1), height);
+
+    /* done the spans of the rows
+     *
+     * the same spans of the adjacent rows are merged to one rect, .e.g the middle of the round rect
+     */
+    tb_long_t   b = y;
+    tb_long_t   lx = 0;
+    tb_long_t   rx = 0;
+    tb_long_t   xl = 0;
+    tb_long_t   xr = 0;
+    tb_fixed_t  l = 0;
+    tb_fixed_t  r = 0;
+    for (; y < e; y++)
+    {
+        // the span [xl, xr) of this row
+        xl = xr = 0;
+        if (gb_bitmap_render_round_rect_row(rect, (y << 16) + TB_FIXED_HALF, &l, &r))
+        {
+            xl = tb_max(tb_fixed_round(l), 0);
+            xr = tb_min(tb_fixed_round(r), width);
+            if (xl >= xr) xl = xr = 0;
+        }
+
+        // the span is changed? done the previous rows
+        if (xl != lx || xr != rx)
+        {
+            if (lx < rx) gb_bitmap_biltter_done_r(biltter, lx, b, rx - lx, y - b);
+            b   = y;
+            lx  = xl;
+            rx  = xr;
+        }
+    }
+
+    // done the last rows
+    if (lx < rx) gb_bitmap_biltter_done_r(biltter, lx, b, rx - lx, y - b);
+}
+static tb_void_t gb_bitmap_render_round_rect_fill_antialiasing(gb_bitmap_biltter_ref_t biltter, gb_bitmap_render_round_rect_ref_t rect, tb_long_t width, tb_long_t height)
+{
+    // check
+    tb_assert(biltter && biltter->done_a && rect);
+
+    // the covered rows [y, e)
+    tb_long_t y = tb_max(rect->y0 >> 16, 0);
+    tb_long_t e = tb_min((rect->y1 + TB_FIXED_ONE - 1) >> 16, height);
+
+    // done
+    tb_size_t   i = 0;
+    tb_size_t   n = 0;
+    tb_long_t   x = 0;
+    tb_long_t   xb = 0;
+    tb_long_t   xe = 0;
+    tb_long_t   fl = 0;
+    tb_long_t   fr = 0;
+    tb_fixed_t  ls[GB_BITMAP_RENDER_ROUND_RECT_SUBROWS];
+    tb_fixed_t  rs[GB_BITMAP_RENDER_ROUND_RECT_SUBROWS];
+    for (; y < e; y++)
+    {
+        /* the spans of the sub-rows
+         *
+         * the sub-row i is sampled at y + (2i + 1) / 2n
+         */
+        tb_fixed_t lmin = TB_MAXS32;
+        tb_fixed_t lmax = TB_MINS32;
+        tb_fixed_t rmin = TB_MAXS32;
+        tb_fixed_t rmax = TB_MINS32;
+        for (i = 0, n = 0; i < GB_BITMAP_RENDER_ROUND_RECT_SUBROWS; i++)
+        {
+            tb_fixed_t sy = (y << 16) + (tb_fixed_t)(((i << 1) + 1) << (15 - GB_BITMAP_RENDER_ROUND_RECT_SUBROWS_BITS));
+            if (gb_bitmap_render_round_rect_row(rect, sy, &ls[i], &rs[i]))
+            {
+                if (ls[i] < lmin) lmin = ls[i];
+                if (ls[i] > lmax) lmax = ls[i];
+                if (rs[i] < rmin) rmin = rs[i];
+                if (rs[i] > rmax) rmax = rs[i];
+                n++;
+            }
+            else ls[i] = rs[i] = 0;
+        }
+
+        // empty row?
+        tb_check_continue(n);
+
+        /* the fully covered span [fl, fr) of this row
+         *
+         * only the pixels out of it need compute the coverage
+         */
+        fl = (lmax + TB_FIXED_ONE - 1) >> 16;
+        fr = rmin >> 16;
+        if (n < GB_BITMAP_RENDER_ROUND_RECT_SUBROWS || fl >= fr) fl = fr = (rmax + TB_FIXED_ONE - 1) >> 16;
+
+        // done the fully covered span
+        xb = tb_max(fl, 0);
+        xe = tb_min(fr, width);
+        if (xb < xe) gb_bitmap_biltter_done_h(biltter, xb, y, xe - xb);
+
+        /* done the partially covered pixels: [lmin, fl) and [fr, rmax)
+         *
+         * the coverage is blended by the biltter, so the pixels are dithered or remapped to the palette too
+         */
+        for (x = tb_max(lmin >> 16, 0); x < tb_min((rmax + TB_FIXED_ONE - 1) >> 16, width); x++)
+        {
+            // skip the fully covered span
+            if (x >= fl && x < fr) 
+            {
+                x = fr - 1;
+                continue ;
+            }
+
+            // the covered length of the sub-rows, [0, 65536 * n]
+            tb_fixed_t  px0 = x << 16;
+            tb_fixed_t  px1 = px0 + TB_FIXED_ONE;
+            tb_size_t   coverage = 0;
+            for (i = 0; i < GB_BITMAP_RENDER_ROUND_RECT_SUBROWS; i++)
+            {
+                tb_fixed_t l = tb_max(ls[i], px0);
+                tb_fixed_t r = tb_min(rs[i], px1);
+                if (l < r) coverage += (tb_size_t)(r - l);
+            }
+
+            // the coverage: [0, 256]
+            coverage >>= 8 + GB_BITMAP_RENDER_ROUND_RECT_SUBROWS_BITS;
+            if (coverage) biltter->done_a(biltter, x, y, tb_min(coverage, 256));
+        }
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_bitmap_render_fill_round_rect(gb_bitmap_device_ref_t device, gb_round_rect_ref_t rect)
+{
+    // check
+    tb_assert(device && device->bitmap && rect);
+
+    // the device bounds
+    tb_long_t width     = (tb_long_t)gb_bitmap_width(device->bitmap);
+    tb_long_t height    = (tb_long_t)gb_bitmap_height(device->bitmap);
+
+    // too large for the fixed-point? fill the polygon of it instead
+    gb_float_t maxc = gb_long_to_float(GB_BITMAP_RENDER_ROUND_RECT_MAXC);
+    tb_check_return_val(    width <= GB_BITMAP_RENDER_ROUND_RECT_MAXC
+                        &&  height <= GB_BITMAP_RENDER_ROUND_RECT_MAXC
+                        &&  rect->bounds.x > -maxc && rect->bounds.x + rect->bounds.w < maxc
+                        &&  rect->bounds.y > -maxc && rect->bounds.y + rect->bounds.h < maxc, tb_false);
+
+    // make the fixed round rect
+    gb_bitmap_render_round_rect_t fixed;
+    fixed.x0 = gb_float_to_fixed(rect->bounds.x);
+    fixed.y0 = gb_float_to_fixed(rect->bounds.y);
+    fixed.x1 = gb_float_to_fixed(rect->bounds.x + rect->bounds.w);
+    fixed.y1 = gb_float_to_fixed(rect->bounds.y + rect->bounds.h);
+    tb_check_return_val(fixed.x0 < fixed.x1 && fixed.y0 < fixed.y1, tb_true);
+
+    // make the radius of the corners, no more than the half of the bounds
+    tb_size_t i = 0;
+    for (i = 0; i < GB_RECT_CORNER_MAXN; i++)
+    {
+        fixed.rx[i] = tb_min(gb_float_to_fixed(rect->radius[i].x), (fixed.x1 - fixed.x0) >> 1);
+        fixed.ry[i] = tb_min(gb_float_to_fixed(rect->radius[i].y), (fixed.y1 - fixed.y0) >> 1);
+        if (fixed.rx[i] <= 0 || fixed.ry[i] <= 0) fixed.rx[i] = fixed.ry[i] = 0;
+    }
+
+    // fill it
+    if (gb_bitmap_render_antialiasing(device)) gb_bitmap_render_round_rect_fill_antialiasing(&device->biltter, &fixed, width, height);
+    else gb_bitmap_render_round_rect_fill(&device->biltter, &fixed, width, height);
+
+    // ok
+    return tb_true;
+}
@@ -0,0 +1,56 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        round_rect.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_BITMAP_RENDER_ROUND_RECT_H
+#define GB_CORE_DEVICE_BITMAP_RENDER_ROUND_RECT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interface
+ */
+
+/* fill round rect, the circle and ellipse are filled as the round rect too
+ *
+ * @param device    the device
+ * @param rect      the round rect in the device coordinates
+ *
+ * @return          tb_false if it is too large for the fixed-point, need fill the polygon of it
+ */
+tb_bool_t           gb_bitmap_render_fill_round_rect(gb_bitmap_device_ref_t device, gb_round_rect_ref_t rect);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -43,6 +43,13 @@
 // testing gl v1 interfaces
 //#define GB_DEVICE_GL_TEST_v1
 
+// the maximum memory size of the tessellator cache
+#ifdef __gb_small__
+#   define GB_DEVICE_GL_TESSELLATIONS_MAXN  (256 << 10)
+#else
+#   define GB_DEVICE_GL_TESSELLATIONS_MAXN  (1 << 20)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
  */
@@ -279,6 +286,9 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
         // init tessellator mode
         gb_tessellator_mode_set(impl->tessellator, GB_TESSELLATOR_MODE_CONVEX);
 
+        // init tessellator cache, the static polygons will be tessellated only once
+        gb_tessellator_cache_set(impl->tessellator, GB_DEVICE_GL_TESSELLATIONS_MAXN);
+
         // init version 
         if (!impl->version)
         {
@@ -35,6 +35,7 @@
 #include "../shader.h"
 #include "../device.h"
 #include "../bitmap.h"
+#include "../palette.h"
 #include "../pixmap.h"
 #include "../../platform/platform.h"
 
@@ -115,6 +116,42 @@ typedef struct __gb_device_impl_t
      */
     tb_void_t               (*draw_polygon)(struct __gb_device_impl_t* device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds);
 
+    /*! draw rects
+     *
+     * @param device        the device
+     * @param rects         the rects
+     * @param count         the rects count
+     * @param bounds        the bounds of all rects
+     */
+    tb_void_t               (*draw_rects)(struct __gb_device_impl_t* device, gb_rect_ref_t rects, tb_size_t count, gb_rect_ref_t bounds);
+
+    /*! draw circles
+     *
+     * @param device        the device
+     * @param circles       the circles
+     * @param count         the circles count
+     * @param bounds        the bounds of all circles
+     */
+    tb_void_t               (*draw_circles)(struct __gb_device_impl_t* device, gb_circle_ref_t circles, tb_size_t count, gb_rect_ref_t bounds);
+
+    /*! draw the instances of path
+     *
+     * @param device        the device
+     * @param path          the path
+     * @param matrices      the matrices of all instances, applied before the device matrix
+     * @param count         the instances count
+     */
+    tb_void_t               (*draw_path_instances)(struct __gb_device_impl_t* device, gb_path_ref_t path, gb_matrix_ref_t matrices, tb_size_t count);
+
+    /*! draw bitmap
+     *
+     * @param device        the device
+     * @param bitmap        the bitmap
+     * @param src_rect      the source rect of the bitmap
+     * @param dst_rect      the destination rect
+     */
+    tb_void_t               (*draw_bitmap)(struct __gb_device_impl_t* device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect);
+
     /*! init linear gradient shader
      *
      * @param device        the device
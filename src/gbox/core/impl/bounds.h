@@ -83,6 +83,76 @@ static __tb_inline__ tb_void_t  gb_bounds_make(gb_rect_ref_t bounds, gb_point_re
     bounds->h = y1 - y0;
 }
 
+/* make bounds from the rects
+ *
+ * @param bounds                the bounds
+ * @param rects                 the rects 
+ * @param count                 the rects count
+ */
+static __tb_inline__ tb_void_t  gb_bounds_make_for_rects(gb_rect_ref_t bounds, gb_rect_ref_t rects, tb_size_t count)
+{
+    // check
+    tb_assert(bounds && rects && count);
+
+    // done
+    gb_float_t x0 = rects->x;
+    gb_float_t y0 = rects->y;
+    gb_float_t x1 = x0 + rects->w;
+    gb_float_t y1 = y0 + rects->h;
+    while (--count)
+    {
+        // next rect
+        rects++;
+
+        // make minimum and maximum point
+        if (rects->x < x0) x0 = rects->x;
+        if (rects->y < y0) y0 = rects->y;
+        if (rects->x + rects->w > x1) x1 = rects->x + rects->w;
+        if (rects->y + rects->h > y1) y1 = rects->y + rects->h;
+    }
+
+    // make bounds
+    bounds->x = x0;
+    bounds->y = y0;
+    bounds->w = x1 - x0;
+    bounds->h = y1 - y0;
+}
+
+/* make bounds from the circles
+ *
+ * @param bounds                the bounds
+ * @param circles               the circles 
+ * @param count                 the circles count
+ */
+static __tb_inline__ tb_void_t  gb_bounds_make_for_circles(gb_rect_ref_t bounds, gb_circle_ref_t circles, tb_size_t count)
+{
+    // check
+    tb_assert(bounds && circles && count);
+
+    // done
+    gb_float_t x0 = circles->c.x - circles->r;
+    gb_float_t y0 = circles->c.y - circles->r;
+    gb_float_t x1 = circles->c.x + circles->r;
+    gb_float_t y1 = circles->c.y + circles->r;
+    while (--count)
+    {
+        // next circle
+        circles++;
+
+        // make minimum and maximum point
+        if (circles->c.x - circles->r < x0) x0 = circles->c.x - circles->r;
+        if (circles->c.y - circles->r < y0) y0 = circles->c.y - circles->r;
+        if (circles->c.x + circles->r > x1) x1 = circles->c.x + circles->r;
+        if (circles->c.y + circles->r > y1) y1 = circles->c.y + circles->r;
+    }
+
+    // make bounds
+    bounds->x = x0;
+    bounds->y = y0;
+    bounds->w = x1 - x0;
+    bounds->h = y1 - y0;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
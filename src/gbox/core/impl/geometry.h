@@ -36,6 +36,40 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/* make the closed convex polygon of the rect
+ *
+ * the last point is the same as the first point
+ *
+ * @param polygon               the polygon, the points and counts must be able to store five points and two counts
+ * @param rect                  the rect
+ */
+static __tb_inline__ tb_void_t  gb_geometry_make_rect_polygon(gb_polygon_ref_t polygon, gb_rect_ref_t rect)
+{
+    // check
+    tb_assert(polygon && polygon->points && polygon->counts && rect);
+
+    // make points
+    gb_point_ref_t points = polygon->points;
+    points[0].x = rect->x;
+    points[0].y = rect->y;
+    points[1].x = rect->x + rect->w;
+    points[1].y = rect->y;
+    points[2].x = rect->x + rect->w;
+    points[2].y = rect->y + rect->h;
+    points[3].x = rect->x;
+    points[3].y = rect->y + rect->h;
+    points[4] = points[0];
+
+    // make counts
+    polygon->counts[0]  = 5;
+    polygon->counts[1]  = 0;
+    polygon->convex     = tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,496 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        mask_cache.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "mask_cache"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "mask_cache.h"
+#include "bounds.h"
+#include "../path.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the buckets count, must be power of 2
+#ifdef __gb_small__
+#   define GB_MASK_CACHE_BUCKET_MAXN        (64)
+#else
+#   define GB_MASK_CACHE_BUCKET_MAXN        (256)
+#endif
+
+// the subpixel bits of the translation, the masks are shared in 1/16 pixel
+#define GB_MASK_CACHE_SUBPIXEL_BITS         (4)
+
+// the spans grow
+#define GB_MASK_CACHE_SPANS_GROW            (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the mask cache entry state enum
+typedef enum __gb_mask_cache_state_e
+{
+    GB_MASK_CACHE_STATE_SEEN        = 0     //< only requested once, the mask has not been made 
+,   GB_MASK_CACHE_STATE_MASK        = 1     //< the mask has been made
+,   GB_MASK_CACHE_STATE_LARGE       = 2     //< the mask is too large to be cached
+
+}gb_mask_cache_state_e;
+
+// the mask cache entry type
+typedef struct __gb_mask_cache_entry_t
+{
+    // the list entry for lru
+    tb_list_entry_t                     entry;
+
+    // the next entry at the same bucket
+    struct __gb_mask_cache_entry_t*     next;
+
+    // the hash
+    tb_size_t                           hash;
+
+    // the path version
+    tb_size_t                           version;
+
+    // the linear part of the matrix
+    gb_float_t                          sx;
+    gb_float_t                          kx;
+    gb_float_t                          ky;
+    gb_float_t                          sy;
+
+    // the subpixel offset
+    tb_uint8_t                          fx;
+    tb_uint8_t                          fy;
+
+    // the rule
+    tb_uint8_t                          rule;
+
+    // the state
+    tb_uint8_t                          state;
+
+    // the mask, the spans are allocated after this entry
+    gb_mask_t                           mask;
+
+}gb_mask_cache_entry_t, *gb_mask_cache_entry_ref_t;
+
+// the mask cache impl type
+typedef struct __gb_mask_cache_impl_t
+{
+    // the maximum memory size
+    tb_size_t                           maxn;
+
+    // the current memory size
+    tb_size_t                           size;
+
+    // the lru list, the head is the most recently used entry
+    tb_list_entry_head_t                lru;
+
+    // the buckets
+    gb_mask_cache_entry_ref_t           buckets[GB_MASK_CACHE_BUCKET_MAXN];
+
+    // the spans for making mask
+    gb_mask_span_ref_t                  spans;
+
+    // the spans count
+    tb_size_t                           spans_size;
+
+    // the spans maxn
+    tb_size_t                           spans_maxn;
+
+    // the spans have been failed to grow?
+    tb_bool_t                           spans_failed;
+
+    // the points for making mask
+    gb_point_ref_t                      points;
+
+    // the points maxn
+    tb_size_t                           points_maxn;
+
+}gb_mask_cache_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_size_t gb_mask_cache_hash(gb_mask_cache_entry_ref_t key)
+{
+    // the linear part of the matrix
+    gb_float_t linear[] = {key->sx, key->kx, key->ky, key->sy};
+
+    // done fnv-1a
+    tb_size_t           i = 0;
+    tb_uint32_t         hash = 2166136261u;
+    tb_byte_t const*    p = (tb_byte_t const*)linear;
+    for (i = 0; i < sizeof(linear); i++) hash = (hash ^ p[i]) * 16777619u;
+    hash = (hash ^ (tb_uint32_t)key->version) * 16777619u;
+    hash = (hash ^ key->fx) * 16777619u;
+    hash = (hash ^ key->fy) * 16777619u;
+    hash = (hash ^ key->rule) * 16777619u;
+
+    // ok
+    return (tb_size_t)hash;
+}
+static tb_size_t gb_mask_cache_entry_size(gb_mask_cache_entry_ref_t entry)
+{
+    // the memory size of the entry and its spans
+    return sizeof(gb_mask_cache_entry_t) + entry->mask.count * sizeof(gb_mask_span_t);
+}
+static tb_void_t gb_mask_cache_entry_exit(gb_mask_cache_impl_t* impl, gb_mask_cache_entry_ref_t entry)
+{
+    // check
+    tb_assert(impl && entry);
+
+    // remove it from the bucket
+    gb_mask_cache_entry_ref_t* pentry = &impl->buckets[entry->hash & (GB_MASK_CACHE_BUCKET_MAXN - 1)];
+    while (*pentry && *pentry != entry) pentry = &(*pentry)->next;
+    tb_assert(*pentry == entry);
+    if (*pentry) *pentry = entry->next;
+
+    // remove it from the lru list
+    tb_list_entry_remove(&impl->lru, &entry->entry);
+
+    // update the memory size
+    tb_assert(impl->size >= gb_mask_cache_entry_size(entry));
+    impl->size -= gb_mask_cache_entry_size(entry);
+
+    // exit it
+    tb_free(entry);
+}
+static tb_void_t gb_mask_cache_reserve(gb_mask_cache_impl_t* impl, tb_size_t size)
+{
+    // check
+    tb_assert(impl);
+
+    // remove the least recently used entries until the given size is enough
+    while (impl->size + size > impl->maxn && tb_list_entry_size(&impl->lru))
+    {
+        // the last entry
+        gb_mask_cache_entry_ref_t entry = (gb_mask_cache_entry_ref_t)tb_list_entry(&impl->lru, tb_list_entry_last(&impl->lru));
+        tb_assert(entry);
+
+        // exit it
+        gb_mask_cache_entry_exit(impl, entry);
+    }
+}
+static gb_mask_cache_entry_ref_t gb_mask_cache_entry_init(gb_mask_cache_impl_t* impl, gb_mask_cache_entry_ref_t key, gb_mask_span_ref_t spans, tb_size_t count)
+{
+    // check
+    tb_assert(impl && key);
+
+    // the memory size
+    tb_size_t size = sizeof(gb_mask_cache_entry_t) + count * sizeof(gb_mask_span_t);
+
+    // remove the old entries if the memory is not enough
+    gb_mask_cache_reserve(impl, size);
+
+    // make entry
+    gb_mask_cache_entry_ref_t entry = (gb_mask_cache_entry_ref_t)tb_malloc(size);
+    tb_assert_and_check_return_val(entry, tb_null);
+
+    // init entry
+    *entry = *key;
+    entry->mask.spans = count? (gb_mask_span_ref_t)(entry + 1) : tb_null;
+    entry->mask.count = count;
+    if (count) tb_memcpy(entry->mask.spans, spans, count * sizeof(gb_mask_span_t));
+
+    // insert it to the bucket
+    gb_mask_cache_entry_ref_t* bucket = &impl->buckets[entry->hash & (GB_MASK_CACHE_BUCKET_MAXN - 1)];
+    entry->next = *bucket;
+    *bucket = entry;
+
+    // insert it to the head of the lru list
+    tb_list_entry_insert_head(&impl->lru, &entry->entry);
+
+    // update the memory size
+    impl->size += size;
+
+    // ok
+    return entry;
+}
+static tb_void_t gb_mask_cache_raster(tb_long_t lx, tb_long_t rx, tb_long_t yb, tb_long_t ye, tb_cpointer_t priv)
+{
+    // check
+    gb_mask_cache_impl_t* impl = (gb_mask_cache_impl_t*)priv;
+    tb_assert(impl && rx >= lx && ye > yb);
+
+    // empty or failed?
+    tb_check_return(rx > lx && !impl->spans_failed);
+
+    // grow the spans
+    if (impl->spans_size >= impl->spans_maxn)
+    {
+        // @note keep the old spans if failed, they will be freed when exiting the cache
+        tb_size_t           maxn = impl->spans_size + GB_MASK_CACHE_SPANS_GROW;
+        gb_mask_span_ref_t  spans = impl->spans? tb_ralloc_type(impl->spans, maxn, gb_mask_span_t) : tb_nalloc_type(maxn, gb_mask_span_t);
+        if (!spans)
+        {
+            // the mask will be incomplete, mark it as failed
+            impl->spans_failed = tb_true;
+            return ;
+        }
+        impl->spans         = spans;
+        impl->spans_maxn    = maxn;
+    }
+
+    // append span
+    gb_mask_span_ref_t span = impl->spans + impl->spans_size++;
+    span->x = (tb_int32_t)lx;
+    span->y = (tb_int32_t)yb;
+    span->w = (tb_uint32_t)(rx - lx);
+    span->h = (tb_uint32_t)(ye - yb);
+}
+static tb_bool_t gb_mask_cache_make(gb_mask_cache_impl_t* impl, gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_matrix_ref_t matrix, tb_size_t rule)
+{
+    // check
+    tb_assert(impl && raster && polygon && polygon->points && polygon->counts && matrix);
+
+    // clear spans
+    impl->spans_size    = 0;
+    impl->spans_failed  = tb_false;
+
+    // the points count of all contours
+    tb_size_t       size = 0;
+    tb_uint16_t*    counts = polygon->counts;
+    while (*counts) size += *counts++;
+
+    // no points?
+    tb_check_return_val(size, tb_false);
+
+    // grow the points, all points must be transformed, otherwise the counts will describe the missing points
+    if (size > impl->points_maxn)
+    {
+        // @note keep the old points if failed, they will be freed when exiting the cache
+        gb_point_ref_t points = impl->points? tb_ralloc_type(impl->points, size, gb_point_t) : tb_nalloc_type(size, gb_point_t);
+        tb_check_return_val(points, tb_false);
+        impl->points        = points;
+        impl->points_maxn   = size;
+    }
+
+    // apply matrix to the points of all contours
+    tb_size_t i = 0;
+    for (i = 0; i < size; i++) gb_point_apply2(polygon->points + i, impl->points + i, matrix);
+
+    // make the transformed polygon and bounds
+    gb_rect_t       bounds;
+    gb_polygon_t    transformed = {impl->points, polygon->counts, polygon->convex};
+    gb_bounds_make(&bounds, transformed.points, size);
+
+    // rasterize it to the spans
+    gb_polygon_raster_done(raster, &transformed, &bounds, rule, gb_mask_cache_raster, impl);
+
+    // the spans are incomplete? not cache it
+    return !impl->spans_failed;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_mask_cache_ref_t gb_mask_cache_init(tb_size_t maxn)
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    gb_mask_cache_impl_t*   impl = tb_null;
+    do
+    {
+        // make cache
+        impl = tb_malloc0_type(gb_mask_cache_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init maxn
+        impl->maxn = maxn;
+
+        // init lru
+        tb_list_entry_init(&impl->lru, gb_mask_cache_entry_t, entry, tb_null);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_mask_cache_exit((gb_mask_cache_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_mask_cache_ref_t)impl;
+}
+tb_void_t gb_mask_cache_exit(gb_mask_cache_ref_t cache)
+{
+    // check
+    gb_mask_cache_impl_t* impl = (gb_mask_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // clear it
+    gb_mask_cache_clear(cache);
+
+    // exit spans
+    if (impl->spans) tb_free(impl->spans);
+    impl->spans = tb_null;
+
+    // exit points
+    if (impl->points) tb_free(impl->points);
+    impl->points = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_mask_cache_clear(gb_mask_cache_ref_t cache)
+{
+    // check
+    gb_mask_cache_impl_t* impl = (gb_mask_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // exit all entries
+    tb_size_t i = 0;
+    for (i = 0; i < GB_MASK_CACHE_BUCKET_MAXN; i++)
+    {
+        gb_mask_cache_entry_ref_t entry = impl->buckets[i];
+        while (entry)
+        {
+            gb_mask_cache_entry_ref_t next = entry->next;
+            tb_free(entry);
+            entry = next;
+        }
+        impl->buckets[i] = tb_null;
+    }
+
+    // clear lru
+    tb_list_entry_clear(&impl->lru);
+
+    // clear the memory size
+    impl->size = 0;
+}
+gb_mask_ref_t gb_mask_cache_get(gb_mask_cache_ref_t cache, gb_polygon_raster_ref_t raster, gb_path_ref_t path, gb_matrix_ref_t matrix, tb_size_t rule, tb_long_t* dx, tb_long_t* dy)
+{
+    // check
+    gb_mask_cache_impl_t* impl = (gb_mask_cache_impl_t*)cache;
+    tb_assert_and_check_return_val(impl && raster && path && matrix && dx && dy, tb_null);
+
+    // no memory for caching?
+    tb_check_return_val(impl->maxn, tb_null);
+
+    // the polygon
+    gb_polygon_ref_t polygon = gb_path_polygon(path);
+    tb_check_return_val(polygon && polygon->points && polygon->counts, tb_null);
+
+    /* split the translation to the integer offset and the subpixel offset
+     *
+     * the integer offset is applied when the mask is stamped, 
+     * so the same mask is reused for all instances with the nearest subpixel offset
+     */
+    tb_long_t   ix = gb_floor(matrix->tx);
+    tb_long_t   iy = gb_floor(matrix->ty);
+    tb_long_t   fx = gb_round(gb_lsh(matrix->tx - gb_long_to_float(ix), GB_MASK_CACHE_SUBPIXEL_BITS));
+    tb_long_t   fy = gb_round(gb_lsh(matrix->ty - gb_long_to_float(iy), GB_MASK_CACHE_SUBPIXEL_BITS));
+    fx = tb_max(fx, 0);
+    fy = tb_max(fy, 0);
+    if (fx >= (1 << GB_MASK_CACHE_SUBPIXEL_BITS)) { ix++; fx = 0; }
+    if (fy >= (1 << GB_MASK_CACHE_SUBPIXEL_BITS)) { iy++; fy = 0; }
+
+    // make key
+    gb_mask_cache_entry_t key;
+    tb_memset(&key, 0, sizeof(key));
+    key.version = gb_path_version(path);
+    key.sx      = matrix->sx;
+    key.kx      = matrix->kx;
+    key.ky      = matrix->ky;
+    key.sy      = matrix->sy;
+    key.fx      = (tb_uint8_t)fx;
+    key.fy      = (tb_uint8_t)fy;
+    key.rule    = (tb_uint8_t)rule;
+    key.state   = GB_MASK_CACHE_STATE_SEEN;
+    key.hash    = gb_mask_cache_hash(&key);
+
+    // find the entry
+    gb_mask_cache_entry_ref_t entry = impl->buckets[key.hash & (GB_MASK_CACHE_BUCKET_MAXN - 1)];
+    while (entry)
+    {
+        if (    entry->hash == key.hash
+            &&  entry->version == key.version
+            &&  entry->sx == key.sx && entry->kx == key.kx && entry->ky == key.ky && entry->sy == key.sy
+            &&  entry->fx == key.fx && entry->fy == key.fy && entry->rule == key.rule)
+            break;
+        entry = entry->next;
+    }
+
+    // the first time? only mark it as seen
+    if (!entry)
+    {
+        gb_mask_cache_entry_init(impl, &key, tb_null, 0);
+        return tb_null;
+    }
+
+    // the mask is too large?
+    tb_check_return_val(entry->state != GB_MASK_CACHE_STATE_LARGE, tb_null);
+
+    // the mask has been made? move it to the head of the lru list
+    if (entry->state == GB_MASK_CACHE_STATE_MASK)
+    {
+        tb_list_entry_moveto_head(&impl->lru, &entry->entry);
+        *dx = ix;
+        *dy = iy;
+        return &entry->mask;
+    }
+
+    // remove the seen entry, it will be replaced with the mask
+    gb_mask_cache_entry_exit(impl, entry);
+
+    // make the matrix at the subpixel offset
+    gb_matrix_t applied = *matrix;
+    applied.tx = gb_div(gb_long_to_float(fx), gb_long_to_float(1 << GB_MASK_CACHE_SUBPIXEL_BITS));
+    applied.ty = gb_div(gb_long_to_float(fy), gb_long_to_float(1 << GB_MASK_CACHE_SUBPIXEL_BITS));
+
+    // make the spans
+    if (!gb_mask_cache_make(impl, raster, polygon, &applied, rule)) return tb_null;
+
+    // too large? only mark it
+    tb_size_t count = impl->spans_size;
+    if (count * sizeof(gb_mask_span_t) > (impl->maxn >> 2))
+    {
+        key.state = GB_MASK_CACHE_STATE_LARGE;
+        gb_mask_cache_entry_init(impl, &key, tb_null, 0);
+        return tb_null;
+    }
+
+    // cache the mask
+    key.state = GB_MASK_CACHE_STATE_MASK;
+    entry = gb_mask_cache_entry_init(impl, &key, impl->spans, count);
+    tb_check_return_val(entry, tb_null);
+
+    // ok
+    *dx = ix;
+    *dy = iy;
+    return &entry->mask;
+}
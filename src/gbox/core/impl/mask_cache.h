@@ -0,0 +1,122 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        mask_cache.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_MASK_CACHE_H
+#define GB_CORE_IMPL_MASK_CACHE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "polygon_raster.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the mask span type, the rows: [y, y + h) and the columns: [x, x + w)
+typedef struct __gb_mask_span_t
+{
+    // the x-coordinate
+    tb_int32_t              x;
+
+    // the y-coordinate
+    tb_int32_t              y;
+
+    // the width
+    tb_uint32_t             w;
+
+    // the height
+    tb_uint32_t             h;
+
+}gb_mask_span_t, *gb_mask_span_ref_t;
+
+// the mask type
+typedef struct __gb_mask_t
+{
+    // the spans
+    gb_mask_span_ref_t      spans;
+
+    // the spans count
+    tb_size_t               count;
+
+}gb_mask_t, *gb_mask_ref_t;
+
+// the mask cache ref type
+typedef struct{}*           gb_mask_cache_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the mask cache
+ *
+ * cache: (path version, linear part of matrix, subpixel offset, rule) => the rasterized spans
+ *
+ * @param maxn              the maximum memory size of all cached masks
+ *
+ * @return                  the mask cache
+ */
+gb_mask_cache_ref_t         gb_mask_cache_init(tb_size_t maxn);
+
+/* exit the mask cache
+ *
+ * @param cache             the mask cache
+ */
+tb_void_t                   gb_mask_cache_exit(gb_mask_cache_ref_t cache);
+
+/* clear the mask cache
+ *
+ * @param cache             the mask cache
+ */
+tb_void_t                   gb_mask_cache_clear(gb_mask_cache_ref_t cache);
+
+/* get the mask of the filled path 
+ *
+ * the mask is only made at the second time the same key is requested
+ * and the least recently used masks will be removed if the memory is not enough
+ *
+ * @param cache             the mask cache
+ * @param raster            the polygon raster for making mask
+ * @param path              the path
+ * @param matrix            the matrix
+ * @param rule              the raster rule
+ * @param dx                the integer x-offset for stamping the mask 
+ * @param dy                the integer y-offset for stamping the mask
+ *
+ * @return                  the mask, tb_null if it is not cached now
+ */
+gb_mask_ref_t               gb_mask_cache_get(gb_mask_cache_ref_t cache, gb_polygon_raster_ref_t raster, gb_path_ref_t path, gb_matrix_ref_t matrix, tb_size_t rule, tb_long_t* dx, tb_long_t* dy);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
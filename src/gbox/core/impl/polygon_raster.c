@@ -45,41 +45,31 @@
 #   define GB_POLYGON_RASTER_EDGES_GROW     (2048)
 #endif
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * types
- */
-
-// the polygon raster edge type
-typedef struct __gb_polygon_raster_edge_t
-{
-    /* the winding for rule
-     *
-     *   . <= -1
-     *     .
-     *       . 
-     *         .
-     *            .  
-     *              .
-     *            => 1
-     *
-     * 1:  top => bottom
-     * -1: bottom => top
-     */
-    tb_int8_t       winding     : 2;
-
-    // the index of next edge at the edge pool 
-    tb_uint16_t     next;
-
-    // the bottom y-coordinate
-    tb_int16_t      y_bottom;
+// the edge rows grow
+#define GB_POLYGON_RASTER_ROWS_GROW         (256)
 
-    // the x-coordinate of the active edge
-    tb_fixed_t      x;
+/* the bytes of all arrays for each edge
+ *
+ * the 4-bytes arrays: 
+ *
+ * edges: x, slope, y_top, y_bottom
+ * edge table
+ * active edges: x, slope, y_bottom
+ * temporary active edges: x, slope, y_bottom
+ * orders: 2 
+ *
+ * the 1-byte arrays: the windings of the edges, active edges and temporary active edges
+ */
+#define GB_POLYGON_RASTER_EDGE_BYTES        (13 * 4 + 3)
 
-    // the slope of the edge: dx / dy 
-    tb_fixed_t      slope;
+/* the average moves of the insertion sort for each active edge, 
+ * the active edges will be sorted by the radix sort if the order is broken too much
+ */
+#define GB_POLYGON_RASTER_SORT_MOVES        (4)
 
-}gb_polygon_raster_edge_t, *gb_polygon_raster_edge_ref_t;
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
 
 /* the polygon raster type
  *
@@ -98,9 +88,11 @@ typedef struct __gb_polygon_raster_edge_t
  *      10          .   .
  *      11            .
  *
- * edge_table[0]: e1 e2
- * edge_table[4]: e3
- * edge_table[7]: e4
+ * edge_table: e1 e2 e3 e4, be sorted by the top y-coordinate using the counting sort
+ *
+ * edge_rows[0]: 2
+ * edge_rows[4]: 3
+ * edge_rows[7]: 4
  *
  * 2. scan the edge table  
  *     (y)
@@ -153,31 +145,97 @@ typedef struct __gb_polygon_raster_edge_t
  *
  * active_edges: e4 e3
  *
- * active_edges: be sorted by x in ascending
+ * active_edges: be sorted by x in ascending, 
+ *               the insertion sort is almost linear if the order is nearly preserved, 
+ *               otherwise they will be sorted by the radix sort
  *
+ * the edges and active edges are the struct of arrays for scanning them sequentially
  */
 typedef struct __gb_polygon_raster_impl_t
 {
-    // the edge pool, tail: 0, index: > 0
-    gb_polygon_raster_edge_ref_t    edge_pool;
+    // the data of all edge arrays
+    tb_byte_t*                      edges_data;
 
-    // the edge pool size
-    tb_size_t                       edge_pool_size;
+    // the edges size
+    tb_size_t                       edges_size;
    
-    // the edge pool maxn
-    tb_size_t                       edge_pool_maxn;
-    
-    // the edge table
-    tb_uint16_t*                    edge_table;
+    // the edges maxn
+    tb_size_t                       edges_maxn;
 
-    // the edge table base for the y-coordinate
-    tb_long_t                       edge_table_base;
+    // the x-coordinates of the edges at the center of the top row
+    tb_fixed_t*                     edges_x;
 
-    // the edge table maxn
-    tb_size_t                       edge_table_maxn;
+    // the slopes of the edges: dx / dy 
+    tb_fixed_t*                     edges_slope;
 
-    // the active edges
-    tb_uint16_t                     active_edges;
+    // the top y-coordinates of the edges
+    tb_int32_t*                     edges_y_top;
+
+    // the bottom y-coordinates of the edges
+    tb_int32_t*                     edges_y_bottom;
+
+    /* the windings of the edges for rule
+     *
+     *   . <= -1
+     *     .
+     *       . 
+     *         .
+     *            .  
+     *              .
+     *            => 1
+     *
+     * 1:  top => bottom
+     * -1: bottom => top
+     */
+    tb_int8_t*                      edges_winding;
+
+    // the edge table, the edge indices sorted by the top y-coordinate
+    tb_uint32_t*                    edge_table;
+
+    // the end offsets of the edge table for each row
+    tb_uint32_t*                    edge_rows;
+
+    // the edge rows maxn
+    tb_size_t                       edge_rows_maxn;
+
+    // the active edges size
+    tb_size_t                       active_size;
+
+    // the active edges have been sorted?
+    tb_bool_t                       active_sorted;
+
+    // the x-coordinates of the active edges
+    tb_fixed_t*                     active_x;
+
+    // the slopes of the active edges
+    tb_fixed_t*                     active_slope;
+
+    // the bottom y-coordinates of the active edges
+    tb_int32_t*                     active_y_bottom;
+
+    // the windings of the active edges
+    tb_int8_t*                      active_winding;
+
+    // the x-coordinates of the temporary active edges for the radix sort
+    tb_fixed_t*                     temps_x;
+
+    // the slopes of the temporary active edges for the radix sort
+    tb_fixed_t*                     temps_slope;
+
+    // the bottom y-coordinates of the temporary active edges for the radix sort
+    tb_int32_t*                     temps_y_bottom;
+
+    // the windings of the temporary active edges for the radix sort
+    tb_int8_t*                      temps_winding;
+
+    // the orders of the active edges for the radix sort
+    tb_uint32_t*                    orders;
+
+    // the temporary orders of the active edges for the radix sort
+    tb_uint32_t*                    orders_temp;
+
+    // the histograms of the radix sort
+    tb_uint32_t                     histograms[4][256];
 
     // the top of the polygon bounds
     tb_long_t                       top;
@@ -190,109 +248,126 @@ typedef struct __gb_polygon_raster_impl_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_bool_t gb_polygon_raster_edge_pool_init(gb_polygon_raster_impl_t* impl)
+static tb_bool_t gb_polygon_raster_edges_init(gb_polygon_raster_impl_t* impl, tb_size_t maxn)
 {
     // check
-    tb_assert(impl);
+    tb_assert(impl && maxn);
 
-    // init the edge pool
-    if (!impl->edge_pool) impl->edge_pool = tb_nalloc_type(GB_POLYGON_RASTER_EDGES_GROW, gb_polygon_raster_edge_t);
-    tb_assert_and_check_return_val(impl->edge_pool, tb_false);
+    // grow the edges
+    if (maxn > impl->edges_maxn)
+    {
+        // make the edges data
+        maxn = maxn + GB_POLYGON_RASTER_EDGES_GROW;
+        if (impl->edges_data) tb_free(impl->edges_data);
+        impl->edges_data = tb_nalloc_type(maxn * GB_POLYGON_RASTER_EDGE_BYTES, tb_byte_t);
+        impl->edges_maxn = 0;
+        tb_assert_and_check_return_val(impl->edges_data, tb_false);
+
+        // init the 4-bytes arrays
+        tb_uint32_t* data       = (tb_uint32_t*)impl->edges_data;
+        impl->edges_x           = (tb_fixed_t*)data;    data += maxn;
+        impl->edges_slope       = (tb_fixed_t*)data;    data += maxn;
+        impl->edges_y_top       = (tb_int32_t*)data;    data += maxn;
+        impl->edges_y_bottom    = (tb_int32_t*)data;    data += maxn;
+        impl->edge_table        = data;                 data += maxn;
+        impl->active_x          = (tb_fixed_t*)data;    data += maxn;
+        impl->active_slope      = (tb_fixed_t*)data;    data += maxn;
+        impl->active_y_bottom   = (tb_int32_t*)data;    data += maxn;
+        impl->temps_x           = (tb_fixed_t*)data;    data += maxn;
+        impl->temps_slope       = (tb_fixed_t*)data;    data += maxn;
+        impl->temps_y_bottom    = (tb_int32_t*)data;    data += maxn;
+        impl->orders            = data;                 data += maxn;
+        impl->orders_temp       = data;                 data += maxn;
+
+        // init the 1-byte arrays
+        tb_int8_t* windings     = (tb_int8_t*)data;
+        impl->edges_winding     = windings;             windings += maxn;
+        impl->active_winding    = windings;             windings += maxn;
+        impl->temps_winding     = windings;             windings += maxn;
+
+        // update the edges maxn
+        impl->edges_maxn = maxn;
+    }
 
-    // init the edge pool size
-    impl->edge_pool_size = 0;
+    // clear the edges and active edges
+    impl->edges_size    = 0;
+    impl->active_size   = 0;
+    impl->active_sorted = tb_true;
 
     // ok
     return tb_true;
 }
-static tb_void_t gb_polygon_raster_edge_pool_exit(gb_polygon_raster_impl_t* impl)
+static tb_void_t gb_polygon_raster_edges_exit(gb_polygon_raster_impl_t* impl)
 {
     // check
     tb_assert(impl);
 
-    // exit the edge pool
-    if (impl->edge_pool) tb_free(impl->edge_pool);
-    impl->edge_pool = tb_null;
+    // exit the edges data
+    if (impl->edges_data) tb_free(impl->edges_data);
+    impl->edges_data = tb_null;
+    impl->edges_maxn = 0;
 }
-static tb_uint16_t gb_polygon_raster_edge_pool_aloc(gb_polygon_raster_impl_t* impl)
+static tb_bool_t gb_polygon_raster_edge_rows_init(gb_polygon_raster_impl_t* impl, tb_size_t rows_size)
 {
     // check
-    tb_assert(impl && impl->edge_pool);
+    tb_assert(impl && rows_size);
 
-    // the new index
-    tb_size_t index = ++impl->edge_pool_size;
-    tb_assert(index < TB_MAXU16);
-
-    // grow the edge pool
-    if (index >= impl->edge_pool_maxn)
+    // grow the edge rows
+    if (rows_size > impl->edge_rows_maxn)
     {
-        impl->edge_pool_maxn = index + GB_POLYGON_RASTER_EDGES_GROW;
-        impl->edge_pool = tb_ralloc_type(impl->edge_pool, impl->edge_pool_maxn, gb_polygon_raster_edge_t);
-        tb_assert_and_check_return_val(impl->edge_pool, 0);
+        impl->edge_rows_maxn = rows_size + GB_POLYGON_RASTER_ROWS_GROW;
+        if (impl->edge_rows) tb_free(impl->edge_rows);
+        impl->edge_rows = tb_nalloc_type(impl->edge_rows_maxn, tb_uint32_t);
+        tb_assert_and_check_return_val(impl->edge_rows, tb_false);
     }
 
-    // make a new edge from the edge pool
-    return (tb_uint16_t)index;
-}
-static tb_bool_t gb_polygon_raster_edge_table_init(gb_polygon_raster_impl_t* impl, tb_long_t table_base, tb_size_t table_size)
-{
-    // check
-    tb_assert(impl && table_size);
-
-    // init the edge table
-    if (!impl->edge_table)
-    {
-        impl->edge_table_maxn = table_size;
-        impl->edge_table = tb_nalloc_type(impl->edge_table_maxn, tb_uint16_t);
-    }
-    else if (table_size > impl->edge_table_maxn)
-    {
-        impl->edge_table_maxn = table_size;
-        impl->edge_table = tb_ralloc_type(impl->edge_table, impl->edge_table_maxn, tb_uint16_t);
-    }
-    tb_assert_and_check_return_val(impl->edge_table && table_size <= TB_MAXU16, tb_false);
-
-    // clear the edge table
-    tb_memset(impl->edge_table, 0, table_size * sizeof(tb_uint16_t));
-
-    // init the edge table base
-    impl->edge_table_base = table_base;
+    // clear the edge rows
+    tb_memset(impl->edge_rows, 0, rows_size * sizeof(tb_uint32_t));
 
     // ok
     return tb_true;
 }
-static tb_void_t gb_polygon_raster_edge_table_exit(gb_polygon_raster_impl_t* impl)
+static tb_void_t gb_polygon_raster_edge_rows_exit(gb_polygon_raster_impl_t* impl)
 {
     // check
     tb_assert(impl);
 
-    // exit the edge table
-    if (impl->edge_table) tb_free(impl->edge_table);
-    impl->edge_table = tb_null;
+    // exit the edge rows
+    if (impl->edge_rows) tb_free(impl->edge_rows);
+    impl->edge_rows = tb_null;
+    impl->edge_rows_maxn = 0;
 }
 static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
 {
     // empty polygon?
     tb_check_return_val(!gb_near0(bounds->w) && !gb_near0(bounds->h), tb_false);
 
-    // init the edge pool
-    if (!gb_polygon_raster_edge_pool_init(impl)) return tb_false; 
+    // the edges count is not larger than the points count
+    tb_size_t       maxn    = 0;
+    tb_uint16_t*    counts  = polygon->counts;
+    while (*counts) maxn += *counts++;
+    tb_check_return_val(maxn, tb_false);
 
-    // init the edge table
-    if (!gb_polygon_raster_edge_table_init(impl, gb_round(bounds->y), gb_round(bounds->h) + 1)) return tb_false;
+    // init the edges
+    if (!gb_polygon_raster_edges_init(impl, maxn)) return tb_false; 
  
-    // make the edge table
+    // make the edges
     gb_point_t          pb;
     gb_point_t          pe;
-    tb_bool_t           first       = tb_true;
-    tb_long_t           top         = 0;
-    tb_long_t           bottom      = 0;
-    tb_uint16_t         index       = 0;
-    tb_long_t           table_index = 0;
-    gb_point_ref_t      points      = polygon->points;
-    tb_uint16_t*        counts      = polygon->counts;
-    tb_uint16_t         count       = *counts++;
-    tb_uint16_t*        edge_table  = impl->edge_table;
+    tb_bool_t           first           = tb_true;
+    tb_long_t           top             = 0;
+    tb_long_t           bottom          = 0;
+    tb_uint16_t         index           = 0;
+    tb_size_t           edge_index      = 0;
+    gb_point_ref_t      points          = polygon->points;
+    tb_uint16_t         count           = 0;
+    tb_fixed_t*         edges_x         = impl->edges_x;
+    tb_fixed_t*         edges_slope     = impl->edges_slope;
+    tb_int32_t*         edges_y_top     = impl->edges_y_top;
+    tb_int32_t*         edges_y_bottom  = impl->edges_y_bottom;
+    tb_int8_t*          edges_winding   = impl->edges_winding;
+    counts  = polygon->counts;
+    count   = *counts++;
     while (index < count)
     {
         // the point
@@ -318,15 +393,12 @@ static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* imp
                 tb_fixed6_t dx = xe - xb;
                 tb_fixed6_t dy = ye - yb;
 
-                // make a new edge from the edge pool
-                tb_uint16_t edge_index = gb_polygon_raster_edge_pool_aloc(impl);
-                tb_assert(edge_index);
-
-                // the edge
-                gb_polygon_raster_edge_ref_t edge = impl->edge_pool + edge_index;
+                // make a new edge
+                edge_index = impl->edges_size++;
+                tb_assert(edge_index < impl->edges_maxn);
 
                 // init the winding
-                edge->winding = 1;
+                edges_winding[edge_index] = 1;
 
                 // sort the points of the edge by the y-coordinate
                 if (yb > ye)
@@ -337,7 +409,7 @@ static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* imp
                     tb_swap(tb_long_t, iyb, iye);
 
                     // reverse the winding
-                    edge->winding = -1;
+                    edges_winding[edge_index] = -1;
                 }
 
                 // compute the accurate bounds of the y-coordinate
@@ -357,31 +429,18 @@ static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* imp
                 tb_assert(iyb < iye);
 
                 // compute the slope 
-                edge->slope = tb_fixed6_div(dx, dy);
+                edges_slope[edge_index] = tb_fixed6_div(dx, dy);
 
                 /* compute the more accurate start x-coordinate
                  *
                  * xb + (iyb - yb + 0.5) * dx / dy
                  * => xb + ((0.5 - yb) % 1) * dx / dy
                  */
-                edge->x = tb_fixed6_to_fixed(xb) + ((edge->slope * ((TB_FIXED6_HALF - yb) & 63)) >> 6);
+                edges_x[edge_index] = tb_fixed6_to_fixed(xb) + ((edges_slope[edge_index] * ((TB_FIXED6_HALF - yb) & 63)) >> 6);
 
-                // init bottom y-coordinate
-                edge->y_bottom = (tb_int16_t)(iye - 1);
-                tb_assert(iye - 1 > TB_MINS16 && iye - 1 <= TB_MAXS16);
-
-                // the table index
-                table_index = iyb - impl->edge_table_base;
-                tb_assert(table_index >= 0 && table_index < impl->edge_table_maxn);
-                
-                /* insert edge to the head of the edge table
-                 *
-                 * table[index]: => edge => edge => .. => 0
-                 *              |
-                 *            insert
-                 */
-                edge->next = edge_table[table_index];
-                edge_table[table_index] = edge_index;
+                // init the top and bottom y-coordinate
+                edges_y_top[edge_index]     = (tb_int32_t)iyb;
+                edges_y_bottom[edge_index]  = (tb_int32_t)(iye - 1);
             }
         }
 
@@ -400,37 +459,222 @@ static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* imp
         }
     }
 
+    // no edges?
+    tb_size_t edges_size = impl->edges_size;
+    tb_check_return_val(edges_size, tb_false);
+
     // update top and bottom of the polygon
     impl->top     = top;
     impl->bottom  = bottom;
 
+    // init the edge rows
+    tb_size_t rows_size = (tb_size_t)(bottom - top);
+    if (!gb_polygon_raster_edge_rows_init(impl, rows_size)) return tb_false;
+
+    /* make the edge table using the counting sort by the top y-coordinate
+     *
+     * edge_rows[y - top]: the end offset of the edges at the edge table for this row
+     */
+    tb_size_t       i;
+    tb_uint32_t     offset      = 0;
+    tb_uint32_t     rows_count  = 0;
+    tb_uint32_t*    edge_rows   = impl->edge_rows;
+    tb_uint32_t*    edge_table  = impl->edge_table;
+    for (i = 0; i < edges_size; i++) edge_rows[edges_y_top[i] - top]++;
+    for (i = 0; i < rows_size; i++)
+    {
+        rows_count      = edge_rows[i];
+        edge_rows[i]    = offset;
+        offset          += rows_count;
+    }
+    for (i = 0; i < edges_size; i++) edge_table[edge_rows[edges_y_top[i] - top]++] = (tb_uint32_t)i;
+
     // ok
     return tb_true;
 }
-static tb_void_t gb_polygon_raster_active_scan_line_convex(gb_polygon_raster_impl_t* impl, tb_long_t y, gb_polygon_raster_func_t func, tb_cpointer_t priv)
+static __tb_inline__ tb_void_t gb_polygon_raster_active_append(gb_polygon_raster_impl_t* impl, tb_long_t y)
 {
     // check
-    tb_assert(impl && impl->edge_pool && func);
+    tb_assert(impl && impl->edge_rows && y >= impl->top && y < impl->bottom);
+
+    // the edges of this row at the edge table
+    tb_size_t       row     = (tb_size_t)(y - impl->top);
+    tb_uint32_t     offset  = row? impl->edge_rows[row - 1] : 0;
+    tb_uint32_t     tail    = impl->edge_rows[row];
+    tb_check_return(offset < tail);
+
+    // append them to the tail of the active edges
+    tb_uint32_t     index   = 0;
+    tb_size_t       size    = impl->active_size;
+    tb_uint32_t*    table   = impl->edge_table;
+    for (; offset < tail; offset++, size++)
+    {
+        // the edge index
+        index = table[offset];
+
+        // append it
+        impl->active_x[size]        = impl->edges_x[index];
+        impl->active_slope[size]    = impl->edges_slope[index];
+        impl->active_y_bottom[size] = impl->edges_y_bottom[index];
+        impl->active_winding[size]  = impl->edges_winding[index];
+    }
 
-    // the edge index
-    tb_uint16_t index = impl->active_edges; 
-    tb_check_return(index);
+    // update the active edges size
+    tb_assert(size <= impl->edges_maxn);
+    impl->active_size   = size;
+    impl->active_sorted = tb_false;
+}
+static tb_void_t gb_polygon_raster_active_radix_sort(gb_polygon_raster_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->active_size);
+
+    // make the histograms of the x-coordinates
+    tb_size_t       i;
+    tb_size_t       j;
+    tb_uint32_t     key;
+    tb_size_t       size        = impl->active_size;
+    tb_fixed_t*     active_x    = impl->active_x;
+    tb_memset(impl->histograms, 0, sizeof(impl->histograms));
+    for (i = 0; i < size; i++)
+    {
+        // the biased x-coordinate for sorting it as unsigned key
+        key = (tb_uint32_t)active_x[i] ^ 0x80000000;
+        for (j = 0; j < 4; j++, key >>= 8) impl->histograms[j][key & 0xff]++;
+    }
 
-    // the edge
-    gb_polygon_raster_edge_ref_t edge = impl->edge_pool + index; 
+    // init the orders
+    tb_uint32_t* src = impl->orders;
+    tb_uint32_t* dst = impl->orders_temp;
+    for (i = 0; i < size; i++) src[i] = (tb_uint32_t)i;
+
+    // sort the orders using the lsd radix sort
+    tb_size_t       shift;
+    tb_uint32_t     offset;
+    tb_uint32_t     count;
+    tb_uint32_t*    histogram;
+    for (j = 0, shift = 0; j < 4; j++, shift += 8)
+    {
+        // all keys have the same digit? skip it
+        histogram = impl->histograms[j];
+        if (histogram[(((tb_uint32_t)active_x[src[0]] ^ 0x80000000) >> shift) & 0xff] == size) continue;
 
-    // the next edge index
-    tb_uint16_t index_next = edge->next; 
-    tb_check_return(index_next);
+        // make the offsets of the digits
+        for (i = 0, offset = 0; i < 256; i++)
+        {
+            count           = histogram[i];
+            histogram[i]    = offset;
+            offset          += count;
+        }
 
-    // the next edge
-    gb_polygon_raster_edge_ref_t edge_next = impl->edge_pool + index_next; 
+        // scatter the orders by this digit
+        for (i = 0; i < size; i++)
+        {
+            key = ((tb_uint32_t)active_x[src[i]] ^ 0x80000000) >> shift;
+            dst[histogram[key & 0xff]++] = src[i];
+        }
+
+        // swap the orders
+        tb_swap(tb_uint32_t*, src, dst);
+    }
 
+    // gather the active edges to the temporary active edges by the orders
+    tb_uint32_t order;
+    for (i = 0; i < size; i++)
+    {
+        order = src[i];
+        impl->temps_x[i]        = active_x[order];
+        impl->temps_slope[i]    = impl->active_slope[order];
+        impl->temps_y_bottom[i] = impl->active_y_bottom[order];
+        impl->temps_winding[i]  = impl->active_winding[order];
+    }
+
+    // swap the active edges and the temporary active edges
+    tb_swap(tb_fixed_t*, impl->active_x, impl->temps_x);
+    tb_swap(tb_fixed_t*, impl->active_slope, impl->temps_slope);
+    tb_swap(tb_int32_t*, impl->active_y_bottom, impl->temps_y_bottom);
+    tb_swap(tb_int8_t*, impl->active_winding, impl->temps_winding);
+}
+static tb_void_t gb_polygon_raster_active_sort(gb_polygon_raster_impl_t* impl)
+{
     // check
-    tb_assert(edge->x < edge_next->x || tb_fixed_abs(edge->x - edge_next->x) <= TB_FIXED_HALF);
+    tb_assert(impl);
+
+    // the active edges
+    tb_size_t       size            = impl->active_size;
+    tb_fixed_t*     active_x        = impl->active_x;
+    tb_fixed_t*     active_slope    = impl->active_slope;
+    tb_int32_t*     active_y_bottom = impl->active_y_bottom;
+    tb_int8_t*      active_winding  = impl->active_winding;
+    tb_assert(!impl->active_sorted);
+
+    // sorted now
+    impl->active_sorted = tb_true;
+    tb_check_return(size > 1);
+
+    /* sort them by x and slope in ascending using the insertion sort, 
+     * it is almost linear if the order is nearly preserved from the previous line
+     */
+    tb_size_t       i;
+    tb_size_t       j;
+    tb_fixed_t      x;
+    tb_fixed_t      slope;
+    tb_int32_t      y_bottom;
+    tb_int8_t       winding;
+    tb_size_t       moves       = 0;
+    tb_size_t       moves_maxn  = size * GB_POLYGON_RASTER_SORT_MOVES;
+    for (i = 1; i < size; i++)
+    {
+        // in order?
+        x       = active_x[i];
+        slope   = active_slope[i];
+        if (active_x[i - 1] < x || (active_x[i - 1] == x && active_slope[i - 1] <= slope)) continue;
+
+        // the order is broken too much? sort them using the radix sort
+        if (moves > moves_maxn) break;
+
+        // insert this edge to the sorted active edges
+        y_bottom    = active_y_bottom[i];
+        winding     = active_winding[i];
+        for (j = i; j && (active_x[j - 1] > x || (active_x[j - 1] == x && active_slope[j - 1] > slope)); j--, moves++)
+        {
+            active_x[j]         = active_x[j - 1];
+            active_slope[j]     = active_slope[j - 1];
+            active_y_bottom[j]  = active_y_bottom[j - 1];
+            active_winding[j]   = active_winding[j - 1];
+        }
+        active_x[j]         = x;
+        active_slope[j]     = slope;
+        active_y_bottom[j]  = y_bottom;
+        active_winding[j]   = winding;
+    }
+
+    // not finished? sort them using the radix sort
+    if (i < size) gb_polygon_raster_active_radix_sort(impl);
+}
+static tb_bool_t gb_polygon_raster_active_scan_line_convex(gb_polygon_raster_impl_t* impl, tb_long_t y, gb_polygon_raster_func_t func, tb_cpointer_t priv, tb_long_t* pnext)
+{
+    // check
+    tb_assert(impl && func && pnext);
+
+    // only one edge?
+    tb_check_return_val(impl->active_size > 1, tb_false);
+
+    // the edges
+    tb_fixed_t*     active_x        = impl->active_x;
+    tb_fixed_t*     active_slope    = impl->active_slope;
+    tb_int32_t*     active_y_bottom = impl->active_y_bottom;
+
+    // check
+    tb_assert(active_x[0] < active_x[1] || tb_fixed_abs(active_x[0] - active_x[1]) <= TB_FIXED_HALF);
 
     // trace
-    tb_trace_d("y: %ld, %{fixed} => %{fixed}", y, edge->x, edge_next->x);
+    tb_trace_d("y: %ld, %{fixed} => %{fixed}", y, active_x[0], active_x[1]);
+
+    // the span
+    tb_long_t   lx      = tb_fixed_round(active_x[0]);
+    tb_long_t   rx      = tb_fixed_round(active_x[1]);
+    tb_bool_t   region  = tb_false;
 
     // init the end y-coordinate for the only one line
     tb_long_t ye = y + 1;
@@ -441,65 +685,63 @@ static tb_void_t gb_polygon_raster_active_scan_line_convex(gb_polygon_raster_imp
      * |    |
      * |    |
      */
-    if (tb_fixed_abs(edge->slope) <= TB_FIXED_NEAR0 && tb_fixed_abs(edge_next->slope) <= TB_FIXED_NEAR0)        
+    if (tb_fixed_abs(active_slope[0]) <= TB_FIXED_NEAR0 && tb_fixed_abs(active_slope[1]) <= TB_FIXED_NEAR0)        
     {
         // get the min and max edge for the y-bottom
-        gb_polygon_raster_edge_ref_t    edge_min    = edge; 
-        gb_polygon_raster_edge_ref_t    edge_max    = edge_next; 
-        tb_uint16_t                     index_max   = index_next;
-        if (edge_min->y_bottom > edge_max->y_bottom)
-        {
-            edge_min    = edge_next; 
-            edge_max    = edge; 
-            index_max   = index;
-        }
+        tb_size_t edge_min = 0;
+        tb_size_t edge_max = 1;
+        if (active_y_bottom[edge_min] > active_y_bottom[edge_max]) tb_swap(tb_size_t, edge_min, edge_max);
 
         // compute the ye
-        ye = edge_min->y_bottom + 1;
-
-        // clear the active edges, only two edges
-        impl->active_edges = 0;
+        tb_long_t end = active_y_bottom[edge_min] + 1;
 
-        // re-insert the max edge to the edge table using the new top-y coordinate
-        if (ye < edge_max->y_bottom)
+        // no new edges in the rows: (y, end)?
+        tb_uint32_t* edge_rows = impl->edge_rows;
+        if (edge_rows[end - 1 - impl->top] == edge_rows[y - impl->top])
         {
-            // check
-            tb_assert(ye >= impl->edge_table_base && ye - impl->edge_table_base < impl->edge_table_maxn);
-
-            /* re-insert to the edge table using the new top-y coordinate
-             *
-             * table[index]: => edge => edge => .. => 0
-             *              |
-             *            insert
-             */
-            edge_max->next = impl->edge_table[ye - impl->edge_table_base];
-            impl->edge_table[ye - impl->edge_table_base] = index_max;
+            // scan the rect region
+            ye      = end;
+            region  = tb_true;
+
+            // only keep the max edge for the next rows if it is not finished, the x-coordinate is not changed for the vertical edge
+            if (ye <= active_y_bottom[edge_max])
+            {
+                active_x[0]                 = active_x[edge_max];
+                active_slope[0]             = active_slope[edge_max];
+                active_y_bottom[0]          = active_y_bottom[edge_max];
+                impl->active_winding[0]     = impl->active_winding[edge_max];
+                impl->active_size           = 1;
+            }
+            else impl->active_size = 0;
+
+            // the next row
+            *pnext = ye;
         }
     }
 
     // done it
-    func(tb_fixed_round(edge->x), tb_fixed_round(edge_next->x), y, ye, priv);
+    func(lx, rx, y, ye, priv);
+
+    // is rect region?
+    return region;
 }
 static tb_void_t gb_polygon_raster_active_scan_line_concave(gb_polygon_raster_impl_t* impl, tb_long_t y, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
 {
     // check
-    tb_assert(impl && impl->edge_pool && func);
+    tb_assert(impl && func);
 
     // done
-    tb_long_t                       done            = 0;
-    tb_long_t                       winding         = 0; 
-    tb_uint16_t                     index           = impl->active_edges; 
-    tb_uint16_t                     index_next      = 0; 
-    gb_polygon_raster_edge_ref_t    edge            = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_next       = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_cache      = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_cache_next = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_pool       = impl->edge_pool;
-    while (index) 
+    tb_size_t       index           = 0;
+    tb_long_t       done            = 0;
+    tb_long_t       winding         = 0; 
+    tb_long_t       cache_lx        = 0;
+    tb_long_t       cache_rx        = 0;
+    tb_bool_t       cache           = tb_false;
+    tb_size_t       size            = impl->active_size;
+    tb_fixed_t*     active_x        = impl->active_x;
+    tb_int8_t*      active_winding  = impl->active_winding;
+    for (index = 0; index + 1 < size; index++)
     { 
-        // the edge
-        edge = edge_pool + index; 
-
         /* compute the winding
          *   
          *    /\
@@ -509,17 +751,10 @@ static tb_void_t gb_polygon_raster_active_scan_line_concave(gb_polygon_raster_im
          *    |            |
          *                \/
          */
-        winding += edge->winding; 
-
-        // the next edge index
-        index_next = edge->next; 
-        tb_check_break(index_next);
-
-        // the next edge
-        edge_next = edge_pool + index_next; 
+        winding += active_winding[index]; 
 
         // check
-        tb_assert(edge->x <= edge_next->x);
+        tb_assert(active_x[index] <= active_x[index + 1]);
 
         // compute the rule
         switch (rule)
@@ -570,70 +805,68 @@ static tb_void_t gb_polygon_raster_active_scan_line_concave(gb_polygon_raster_im
         }
 
         // trace
-        tb_trace_d("y: %ld, winding: %ld, %{fixed} => %{fixed}", y, winding, edge->x, edge_next->x);
+        tb_trace_d("y: %ld, winding: %ld, %{fixed} => %{fixed}", y, winding, active_x[index], active_x[index + 1]);
 
-#if 0
-        // done it for winding?
-        if (done) func(tb_fixed_round(edge->x), tb_fixed_round(edge_next->x), y, y + 1, priv);
-#else
         // cache the conjoint edges and done them together
         if (done)
         {
             // no edge cache?
-            if (!edge_cache && !edge_cache_next) 
+            if (!cache) 
             {
                 // init edge cache
-                edge_cache = edge;
-                edge_cache_next = edge_next;
+                cache_lx    = tb_fixed_round(active_x[index]);
+                cache_rx    = tb_fixed_round(active_x[index + 1]);
+                cache       = tb_true;
             }
             // is conjoint? merge it
-            else if (edge_cache_next && tb_fixed_round(edge_cache_next->x) == tb_fixed_round(edge->x))
+            else if (cache_rx == tb_fixed_round(active_x[index]))
             {
                 // merge the edges to the edge cache
-                edge_cache_next = edge_next;
+                cache_rx = tb_fixed_round(active_x[index + 1]);
             }
             else
             {
-                // check
-                tb_assert(edge_cache && edge_cache_next);
-
                 // done edge cache
-                func(tb_fixed_round(edge_cache->x), tb_fixed_round(edge_cache_next->x), y, y + 1, priv);
+                func(cache_lx, cache_rx, y, y + 1, priv);
 
                 // update edge cache
-                edge_cache = edge;
-                edge_cache_next = edge_next;
+                cache_lx = tb_fixed_round(active_x[index]);
+                cache_rx = tb_fixed_round(active_x[index + 1]);
             }
         }
-#endif
-
-        // the next edge index
-        index = index_next; 
     }
 
     // done the left edge cache
-    if (edge_cache && edge_cache_next) func(tb_fixed_round(edge_cache->x), tb_fixed_round(edge_cache_next->x), y, y + 1, priv);
+    if (cache) func(cache_lx, cache_rx, y, y + 1, priv);
 }
-static tb_void_t gb_polygon_raster_active_scan_next(gb_polygon_raster_impl_t* impl, tb_long_t y, tb_size_t* porder)
+static __tb_inline_force__ tb_void_t gb_polygon_raster_active_scan_next(gb_polygon_raster_impl_t* impl, tb_long_t y)
 {
     // check
-    tb_assert(impl && impl->edge_pool && impl->edge_table && y <= impl->bottom);
+    tb_assert(impl && y <= impl->bottom);
 
     // done
-    tb_size_t                       first = 1;
-    tb_size_t                       order = 1;
-    tb_fixed_t                      x_prev = 0;
-    tb_uint16_t                     index_prev = 0;
-    tb_uint16_t                     index = impl->active_edges;
-    gb_polygon_raster_edge_ref_t    edge = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_prev = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_pool = impl->edge_pool;
-    tb_uint16_t                     active_edges = impl->active_edges;
-    while (index)
+    tb_size_t       index           = 0;
+    tb_size_t       size            = impl->active_size;
+    tb_size_t       active_size     = 0;
+    tb_fixed_t*     active_x        = impl->active_x;
+    tb_fixed_t*     active_slope    = impl->active_slope;
+    tb_int32_t*     active_y_bottom = impl->active_y_bottom;
+    tb_int8_t*      active_winding  = impl->active_winding;
+
+    // update the x-coordinates of the leading edges which are not finished in place
+    tb_bool_t       sorted          = tb_true;
+    for (; index < size && active_y_bottom[index] >= y + 1; index++) 
     {
-        // the edge
-        edge = edge_pool + index;
+        // update the x-coordinate
+        active_x[index] += active_slope[index];
+
+        // the order is broken? 
+        if (index && (active_x[index - 1] > active_x[index] || (active_x[index - 1] == active_x[index] && active_slope[index - 1] > active_slope[index]))) sorted = tb_false;
+    }
 
+    // remove the finished edges and update the left edges
+    for (active_size = index; index < size; index++)
+    {
         /* remove edge from the active edges if (y >= edge->y_bottom)
          *            
          *             .
@@ -645,311 +878,54 @@ static tb_void_t gb_polygon_raster_active_scan_next(gb_polygon_raster_impl_t* im
          *          .   .   
          *            .      <- bottom
          */
-        if (edge->y_bottom < y + 1)
-        {
-            // the next edge index
-            index = edge->next;
-
-            // remove this edge from head
-            if (!index_prev) active_edges = index;
-            else 
-            {
-                // the previous edge 
-                edge_prev = edge_pool + index_prev;
-
-                // remove this edge from the body
-                edge_prev->next = index;
-            }
-
-            // continue 
-            continue;
-        }
-
-        // update the x-coordinate
-        edge->x += edge->slope;
-
-        // is order?
-        if (porder)
-        {
-            if (first) first = 0;
-            else if (order && edge->x < x_prev) order = 0;
-        }
-
-        // update the previous x-coordinate
-        x_prev = edge->x;
-
-        // update the previous edge index
-        index_prev = index;
-
-        // update the edge index
-        index = edge->next;
-    }
-
-    // save order
-    if (porder) *porder = order; 
-
-    // update the active edges 
-    impl->active_edges = active_edges;
-}
-static tb_void_t gb_polygon_raster_active_append(gb_polygon_raster_impl_t* impl, tb_uint16_t index)
-{
-    // check
-    tb_assert(impl && impl->edge_pool);
-
-    // done
-    tb_uint16_t                     next = 0;
-    gb_polygon_raster_edge_ref_t    edge = tb_null;
-    gb_polygon_raster_edge_ref_t    edge_pool = impl->edge_pool;
-    tb_uint16_t                     active_edges = impl->active_edges;
-    while (index)
-    {
-        // the edge
-        edge = edge_pool + index;
-
-        // save the next edge index
-        next = edge->next;
-
-        // insert the edge to the head of the active edges
-        edge->next = active_edges;
-        active_edges = index;
-
-        // the next edge index
-        index = next;
-    }
-
-    // update the active edges 
-    impl->active_edges = active_edges;
-}
-static tb_void_t gb_polygon_raster_active_sorted_insert(gb_polygon_raster_impl_t* impl, tb_uint16_t edge_index)
-{
-    // check
-    tb_assert(impl && impl->edge_pool && edge_index);
-
-    // the edge pool
-    gb_polygon_raster_edge_ref_t edge_pool = impl->edge_pool;
-
-    // the edge
-    gb_polygon_raster_edge_ref_t edge = edge_pool + edge_index;
-
-    // insert edge to the active edges by x in ascending
-    edge->next = 0;
-    if (!impl->active_edges) impl->active_edges = edge_index;
-    else 
-    {
-        // find an inserted position
-        gb_polygon_raster_edge_ref_t    edge_prev       = tb_null;
-        gb_polygon_raster_edge_ref_t    edge_active     = tb_null;
-        tb_uint16_t                     index_active    = impl->active_edges;
-        while (index_active)
-        {
-            // the active edge
-            edge_active = edge_pool + index_active;
-
-            // check
-            tb_assert(edge_index != index_active);
-
-            /* is this?
-             *
-             * x: 1 2 3     5 6
-             *               |
-             *             4 or 5
-             */
-            if (edge->x <= edge_active->x) 
-            {
-                /* same vertex?
-                 *
-                 *
-                 * x: 1 2 3     5 6
-                 *               |   .
-                 *               5    .
-                 *             .       .
-                 *           .          .
-                 *         .          active_edge
-                 *       .
-                 *     edge
-                 *
-                 * x: 1 2 3   5         6
-                 *                 .    |
-                 *                  .   5
-                 *                   .    .
-                 *                    .     .
-                 *          active_edge       .
-                 *                              . 
-                 *                                .  
-                 *                                  .
-                 *                                   edge
-                 *
-                 *  x: 1 2 3   5         6
-                 *                 .    |
-                 *                .     5
-                 *              .    .
-                 *            .     .
-                 *  active_edge    .
-                 *                . 
-                 *               .  
-                 *              .
-                 *             edge
-                 *
-                 *
-                 * x: 1 2 3     5 6
-                 *               |   .
-                 *               5      .
-                 *                 .       .
-                 *                   .       active_edge 
-                 *                     .           
-                 *                       .
-                 *                         .
-                 *                           .
-                 *                             .
-                 *                               .
-                 *                                 .
-                 *                                 edge
-                 */
-                if (edge->x == edge_active->x)
-                {
-                    /* the edge is at the left-hand of the active edge?
-                     * 
-                     * x: 1 2 3     5 6    <- active_edges
-                     *               |   .
-                     *               5    .
-                     *             .       .
-                     *           .          .
-                     *         .        active_edge
-                     *       .
-                     *     edge
-                     *
-                     * if (edge->dx / edge->dy < active->dx / active->dy)?
-                     */
-                    if (edge->slope < edge_active->slope) break;
-                }
-                else break;
-            }
-            
-            // the previous active edge
-            edge_prev = edge_active;
+        tb_check_continue(active_y_bottom[index] >= y + 1);
 
-            // the next active edge index
-            index_active = edge_prev->next;
-        }
+        // update the x-coordinate and keep this edge
+        active_x[active_size]           = active_x[index] + active_slope[index];
+        active_slope[active_size]       = active_slope[index];
+        active_y_bottom[active_size]    = active_y_bottom[index];
+        active_winding[active_size]     = active_winding[index];
 
-        // insert edge to the active edges: edge_prev -> edge -> edge_active
-        if (!edge_prev)
-        {
-            // insert to the head
-            edge->next          = impl->active_edges;
-            impl->active_edges  = edge_index;
-        }
-        else
-        {
-            // insert to the body
-            edge->next      = index_active;
-            edge_prev->next = edge_index;
-        }
+        // the order is broken? 
+        if (active_size && (active_x[active_size - 1] > active_x[active_size] || (active_x[active_size - 1] == active_x[active_size] && active_slope[active_size - 1] > active_slope[active_size]))) sorted = tb_false;
+        active_size++;
     }
-}
-static tb_void_t gb_polygon_raster_active_sorted_append(gb_polygon_raster_impl_t* impl, tb_uint16_t edge_index)
-{
-    // check
-    tb_assert(impl && impl->edge_pool);
-
-    // done
-    tb_uint16_t                     index_next = 0;
-    gb_polygon_raster_edge_ref_t    edge = tb_null;
-    gb_polygon_raster_edge_ref_t    edge_pool = impl->edge_pool;
-    while (edge_index)
-    {
-        // the edge
-        edge = edge_pool + edge_index;
-
-        // save the next edge index
-        index_next = edge->next;
-
-        // insert the edge to the active edges
-        gb_polygon_raster_active_sorted_insert(impl, edge_index);
 
-        // the next edge index
-        edge_index = index_next;
-    }
-}
-static tb_void_t gb_polygon_raster_active_sort(gb_polygon_raster_impl_t* impl)
-{
-    // check
-    tb_assert(impl && impl->edge_pool);
-
-    // done
-    tb_uint16_t                     index       = impl->active_edges;
-    tb_uint16_t                     index_next  = 0;
-    gb_polygon_raster_edge_ref_t    edge        = tb_null;
-    gb_polygon_raster_edge_ref_t    edge_next   = tb_null;
-    gb_polygon_raster_edge_t        edge_tmp;
-    gb_polygon_raster_edge_ref_t    edge_pool   = impl->edge_pool;
-    while (index)
-    {
-        // the edge
-        edge = edge_pool + index;
-
-        // the next edge index
-        index_next = edge->next;
-        while (index_next)
-        {
-            // the next edge
-            edge_next = edge_pool + index_next;
-
-            // need sort? swap them
-            if (edge->x > edge_next->x || (edge->x == edge_next->x && edge->slope > edge_next->slope))
-            {
-                // save the edge
-                edge_tmp = *edge;
-
-                // swap the edge
-                *edge = *edge_next;
-
-                // restore the next index
-                edge->next = edge_tmp.next;
-                edge_tmp.next = edge_next->next;
-
-                // swap the next edge
-                *edge_next = edge_tmp;
-            }
-        
-            // the next edge index
-            index_next = edge_next->next;
-        }
-
-        // the next edge index
-        index = edge->next;
-    }
+    // update the active edges size
+    impl->active_size   = active_size;
+    impl->active_sorted = sorted;
 }
 static tb_void_t gb_polygon_raster_done_convex(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, gb_polygon_raster_func_t func, tb_cpointer_t priv)
 {
     // check
     tb_assert(impl && polygon && polygon->convex && bounds);
 
-    // init the active edges
-    impl->active_edges = 0;
-
     // make the edge table
     if (!gb_polygon_raster_edge_table_make(impl, polygon, bounds)) return ;
 
     // done scan
     tb_long_t       y;
+    tb_long_t       next        = 0;
     tb_long_t       top         = impl->top; 
     tb_long_t       bottom      = impl->bottom; 
-    tb_long_t       base        = impl->edge_table_base; 
-    tb_uint16_t*    edge_table  = impl->edge_table;
     for (y = top; y < bottom; y++)
     {
-        // append edges to the sorted active edges by x in ascending
-        gb_polygon_raster_active_sorted_append(impl, edge_table[y - base]); 
+        // append edges to the active edges and sort them by x in ascending
+        gb_polygon_raster_active_append(impl, y); 
+        if (!impl->active_sorted) gb_polygon_raster_active_sort(impl); 
 
-        // scan line from the active edges
-        gb_polygon_raster_active_scan_line_convex(impl, y, func, priv); 
+        // scan line from the active edges, skip to the next row if the rect region has been scanned
+        if (gb_polygon_raster_active_scan_line_convex(impl, y, func, priv, &next)) 
+        {
+            y = next - 1;
+            continue;
+        }
 
         // end?
         tb_check_break(y < bottom - 1);
 
         // scan the next line from the active edges
-        gb_polygon_raster_active_scan_next(impl, y, tb_null); 
+        gb_polygon_raster_active_scan_next(impl, y); 
     }
 }
 static tb_void_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
@@ -957,31 +933,18 @@ static tb_void_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl,
     // check
     tb_assert(impl && polygon && !polygon->convex && bounds);
 
-    // init the active edges
-    impl->active_edges = 0;
-
     // make the edge table
     if (!gb_polygon_raster_edge_table_make(impl, polygon, bounds)) return ;
 
     // done scan
     tb_long_t       y;
-    tb_size_t       order       = 1; 
     tb_long_t       top         = impl->top; 
     tb_long_t       bottom      = impl->bottom; 
-    tb_long_t       base        = impl->edge_table_base; 
-    tb_uint16_t*    edge_table  = impl->edge_table;
     for (y = top; y < bottom; y++)
     {
-        // order? append edges to the sorted active edges by x in ascending
-        if (order) gb_polygon_raster_active_sorted_append(impl, edge_table[y - base]); 
-        else
-        {
-            // append edges to the active edges from the edge table
-            gb_polygon_raster_active_append(impl, edge_table[y - base]); 
-
-            // sort by x in ascending at the active edges
-            gb_polygon_raster_active_sort(impl); 
-        }
+        // append edges to the active edges and sort them by x in ascending
+        gb_polygon_raster_active_append(impl, y); 
+        if (!impl->active_sorted) gb_polygon_raster_active_sort(impl); 
 
         // scan line from the active edges
         gb_polygon_raster_active_scan_line_concave(impl, y, rule, func, priv); 
@@ -990,7 +953,7 @@ static tb_void_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl,
         tb_check_break(y < bottom - 1);
 
         // scan the next line from the active edges
-        gb_polygon_raster_active_scan_next(impl, y, &order); 
+        gb_polygon_raster_active_scan_next(impl, y); 
     }
 }
 
@@ -1008,11 +971,11 @@ tb_void_t gb_polygon_raster_exit(gb_polygon_raster_ref_t raster)
     gb_polygon_raster_impl_t* impl = (gb_polygon_raster_impl_t*)raster;
     tb_assert_and_check_return(impl);
 
-    // exit the edge table
-    gb_polygon_raster_edge_table_exit(impl);
+    // exit the edge rows
+    gb_polygon_raster_edge_rows_exit(impl);
 
-    // exit the edge pool
-    gb_polygon_raster_edge_pool_exit(impl);
+    // exit the edges
+    gb_polygon_raster_edges_exit(impl);
 
     // exit it
     tb_free(impl);
@@ -0,0 +1,770 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        strip_raster.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "strip_raster"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "strip_raster.h"
+
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the edges grow
+#ifdef __gb_small__
+#   define GB_STRIP_RASTER_EDGES_GROW           (256)
+#else
+#   define GB_STRIP_RASTER_EDGES_GROW           (1024)
+#endif
+
+// the crossings grow
+#ifdef __gb_small__
+#   define GB_STRIP_RASTER_CROSSINGS_GROW       (1024)
+#else
+#   define GB_STRIP_RASTER_CROSSINGS_GROW       (4096)
+#endif
+
+// the rows grow
+#define GB_STRIP_RASTER_ROWS_GROW               (256)
+
+// sort the crossings of one row using the insertion sort if the count is not larger than it
+#define GB_STRIP_RASTER_INSERT_SORT_MAXN        (32)
+
+/* make the crossing key
+ *
+ * x: 31 bits | winding: 1 bit
+ *
+ * so the crossings of one row are sorted by the x-coordinate in ascending, 
+ * and the lowest bit of x is replaced by the winding, it will not change the rounded x-coordinate
+ */
+#define gb_strip_raster_key(x, winding)         ((((tb_uint32_t)(x) ^ 0x80000000) & ~1) | ((winding) > 0))
+
+// the x-coordinate of the crossing key
+#define gb_strip_raster_key_x(key)              ((tb_fixed_t)(((key) & ~1) ^ 0x80000000))
+
+// the winding of the crossing key
+#define gb_strip_raster_key_winding(key)        (((key) & 1)? 1 : -1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the strip raster edge type
+typedef struct __gb_strip_raster_edge_t
+{
+    // the x-coordinate at the center of the top row
+    tb_fixed_t                  x;
+
+    // the slope of the edge: dx / dy 
+    tb_fixed_t                  slope;
+
+    // the top row
+    tb_int32_t                  top;
+
+    // the bottom row, exclusive
+    tb_int32_t                  bottom;
+
+    // the winding, 1: top => bottom, -1: bottom => top
+    tb_int32_t                  winding;
+
+}gb_strip_raster_edge_t, *gb_strip_raster_edge_ref_t;
+
+/* the strip raster type
+ *
+ * 1. make the edges and count the crossings of each row 
+ *     (y)
+ *      0                   . 
+ *      1                 x   x         rows[1]: 2
+ *      2               x       x       rows[2]: 2
+ *      3             x           x     rows[3]: 2
+ *      4           .               . 
+ *
+ * 2. put the crossings of all edges to the buckets of their rows directly
+ *
+ * 3. sort the few crossings of each row by the x-coordinate and sweep them by the rule
+ *
+ * 4. merge the same spans of the adjacent rows 
+ *
+ * there are no edge table and active edges, so the setup cost is proportional to the crossings
+ */
+typedef struct __gb_strip_raster_impl_t
+{
+    // the edges
+    gb_strip_raster_edge_ref_t  edges;
+
+    // the edges size
+    tb_size_t                   edges_size;
+
+    // the edges maxn
+    tb_size_t                   edges_maxn;
+
+    // the crossings
+    tb_uint32_t*                crossings;
+
+    // the crossings size
+    tb_size_t                   crossings_size;
+
+    // the crossings maxn
+    tb_size_t                   crossings_maxn;
+
+    // the offsets of the crossings for each row
+    tb_uint32_t*                rows;
+
+    // the rows size
+    tb_size_t                   rows_size;
+
+    // the rows maxn
+    tb_size_t                   rows_maxn;
+
+    // the top row
+    tb_long_t                   top;
+
+    // the temporary crossings for the radix sort of the rows with many crossings
+    tb_uint32_t*                temps;
+
+    // the temporary crossings maxn
+    tb_size_t                   temps_maxn;
+
+    // the histograms of the radix sort
+    tb_uint32_t                 histograms[4][256];
+
+}gb_strip_raster_impl_t;
+
+// the strip raster emitter type
+typedef struct __gb_strip_raster_emitter_t
+{
+    // the raster func
+    gb_polygon_raster_func_t    func;
+
+    // the private data
+    tb_cpointer_t               priv;
+
+    // the pending span: [lx, rx) x [yb, ye) 
+    tb_long_t                   lx;
+    tb_long_t                   rx;
+    tb_long_t                   yb;
+    tb_long_t                   ye;
+
+    // the first span of the current row
+    tb_long_t                   first_lx;
+    tb_long_t                   first_rx;
+
+    // the spans count of the current row
+    tb_size_t                   count;
+
+}gb_strip_raster_emitter_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static gb_strip_raster_edge_ref_t gb_strip_raster_edges_aloc(gb_strip_raster_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // grow the edges
+    if (impl->edges_size >= impl->edges_maxn)
+    {
+        impl->edges_maxn = impl->edges_size + GB_STRIP_RASTER_EDGES_GROW;
+        if (!impl->edges) impl->edges = tb_nalloc_type(impl->edges_maxn, gb_strip_raster_edge_t);
+        else impl->edges = tb_ralloc_type(impl->edges, impl->edges_maxn, gb_strip_raster_edge_t);
+        tb_assert_and_check_return_val(impl->edges, tb_null);
+    }
+
+    // make a new edge
+    return impl->edges + impl->edges_size++;
+}
+static tb_bool_t gb_strip_raster_edges_make(gb_strip_raster_impl_t* impl, gb_polygon_ref_t polygon)
+{
+    // check
+    tb_assert(impl && polygon && polygon->points && polygon->counts);
+
+    // clear the edges
+    impl->edges_size        = 0;
+    impl->crossings_size    = 0;
+
+    // make the edges
+    gb_point_t                  pb;
+    gb_point_t                  pe;
+    tb_long_t                   top         = 0;
+    tb_long_t                   bottom      = 0;
+    tb_uint16_t                 index       = 0;
+    gb_strip_raster_edge_ref_t  edge        = tb_null;
+    gb_point_ref_t              points      = polygon->points;
+    tb_uint16_t*                counts      = polygon->counts;
+    tb_uint16_t                 count       = *counts++;
+    while (index < count)
+    {
+        // the point
+        pe = *points++;
+
+        // exists edge?
+        if (index)
+        {
+            // get the integer y-coordinates
+            tb_long_t iyb = gb_round(pb.y);
+            tb_long_t iye = gb_round(pe.y);
+
+            // not horizontal edge?
+            if (iyb != iye)
+            {
+                // get the fixed-point coordinates
+                tb_fixed6_t xb = gb_float_to_fixed6(pb.x);
+                tb_fixed6_t yb = gb_float_to_fixed6(pb.y);
+                tb_fixed6_t xe = gb_float_to_fixed6(pe.x);
+                tb_fixed6_t ye = gb_float_to_fixed6(pe.y);
+
+                // make a new edge
+                edge = gb_strip_raster_edges_aloc(impl);
+                tb_assert_and_check_return_val(edge, tb_false);
+
+                // init the winding
+                edge->winding = 1;
+
+                // sort the points of the edge by the y-coordinate
+                if (yb > ye)
+                {
+                    // reverse the edge points
+                    tb_swap(tb_fixed6_t, xb, xe);
+                    tb_swap(tb_fixed6_t, yb, ye);
+                    tb_swap(tb_long_t, iyb, iye);
+
+                    // reverse the winding
+                    edge->winding = -1;
+                }
+
+                // check
+                tb_assert(iyb < iye);
+
+                // compute the slope, the same as the polygon raster
+                edge->slope = tb_fixed6_div(xe - xb, ye - yb);
+
+                // compute the x-coordinate at the center of the top row
+                edge->x = tb_fixed6_to_fixed(xb) + ((edge->slope * ((TB_FIXED6_HALF - yb) & 63)) >> 6);
+
+                // init the rows: [top, bottom)
+                edge->top       = (tb_int32_t)iyb;
+                edge->bottom    = (tb_int32_t)iye;
+
+                // compute the rows of the polygon
+                if (impl->edges_size == 1)
+                {
+                    top     = iyb;
+                    bottom  = iye;
+                }
+                else
+                {
+                    if (iyb < top)    top = iyb;
+                    if (iye > bottom) bottom = iye;
+                }
+
+                // update the crossings size
+                impl->crossings_size += iye - iyb;
+            }
+        }
+
+        // save the previous point
+        pb = pe;
+        
+        // next point
+        index++;
+
+        // next polygon
+        if (index == count) 
+        {
+            // next
+            count = *counts++;
+            index = 0;
+        }
+    }
+
+    // save the rows
+    impl->top       = top;
+    impl->rows_size = (tb_size_t)(bottom - top);
+
+    // ok?
+    return impl->crossings_size > 1;
+}
+static tb_bool_t gb_strip_raster_crossings_make(gb_strip_raster_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->edges && impl->rows_size);
+
+    // grow the crossings
+    if (impl->crossings_size > impl->crossings_maxn)
+    {
+        impl->crossings_maxn = impl->crossings_size + GB_STRIP_RASTER_CROSSINGS_GROW;
+        if (impl->crossings) tb_free(impl->crossings);
+        impl->crossings = tb_nalloc_type(impl->crossings_maxn, tb_uint32_t);
+        tb_assert_and_check_return_val(impl->crossings, tb_false);
+    }
+
+    // grow the rows, rows[rows_size] is the end offset of the last row
+    if (impl->rows_size + 1 > impl->rows_maxn)
+    {
+        impl->rows_maxn = impl->rows_size + 1 + GB_STRIP_RASTER_ROWS_GROW;
+        if (impl->rows) tb_free(impl->rows);
+        impl->rows = tb_nalloc_type(impl->rows_maxn, tb_uint32_t);
+        tb_assert_and_check_return_val(impl->rows, tb_false);
+    }
+
+    // the edges and rows
+    tb_long_t                   top         = impl->top;
+    tb_uint32_t*                rows        = impl->rows;
+    tb_size_t                   rows_size   = impl->rows_size;
+    gb_strip_raster_edge_ref_t  edge        = impl->edges;
+    gb_strip_raster_edge_ref_t  tail        = impl->edges + impl->edges_size;
+
+    /* mark the delta counts of the crossings at the top and bottom rows of all edges
+     *
+     * rows[top - top]++, rows[bottom - top]--
+     */
+    tb_memset(rows, 0, (rows_size + 1) * sizeof(tb_uint32_t));
+    for (; edge < tail; edge++)
+    {
+        rows[edge->top - top]++;
+        rows[edge->bottom - top]--;
+    }
+
+    // make the start offsets of the crossings for each row
+    tb_size_t   i;
+    tb_uint32_t count   = 0;
+    tb_uint32_t offset  = 0;
+    for (i = 0; i < rows_size; i++)
+    {
+        count   += rows[i];
+        rows[i] = offset;
+        offset  += count;
+    }
+    rows[rows_size] = offset;
+
+    // check
+    tb_assert(offset == impl->crossings_size);
+
+    // put the crossings of all edges to their rows, the rows[i] will be the end offset of this row
+    tb_fixed_t      x;
+    tb_fixed_t      slope;
+    tb_uint32_t*    row;
+    tb_uint32_t*    row_tail;
+    tb_uint32_t*    crossings = impl->crossings;
+    for (edge = impl->edges; edge < tail; edge++)
+    {
+        x           = edge->x;
+        slope       = edge->slope;
+        row         = rows + (edge->top - top);
+        row_tail    = rows + (edge->bottom - top);
+        if (edge->winding > 0)
+        {
+            for (; row < row_tail; row++, x += slope) 
+                crossings[(*row)++] = gb_strip_raster_key(x, 1);
+        }
+        else
+        {
+            for (; row < row_tail; row++, x += slope) 
+                crossings[(*row)++] = gb_strip_raster_key(x, -1);
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_strip_raster_crossings_sort(gb_strip_raster_impl_t* impl, tb_uint32_t* crossings, tb_size_t size)
+{
+    // check
+    tb_assert(impl && crossings);
+
+    // few crossings? sort them using the insertion sort
+    tb_size_t       i;
+    tb_size_t       j;
+    tb_uint32_t     key;
+    if (size <= GB_STRIP_RASTER_INSERT_SORT_MAXN)
+    {
+        for (i = 1; i < size; i++)
+        {
+            key = crossings[i];
+            for (j = i; j && crossings[j - 1] > key; j--)
+                crossings[j] = crossings[j - 1];
+            crossings[j] = key;
+        }
+        return tb_true;
+    }
+
+    // grow the temporary crossings
+    if (size > impl->temps_maxn)
+    {
+        impl->temps_maxn = size + GB_STRIP_RASTER_CROSSINGS_GROW;
+        if (impl->temps) tb_free(impl->temps);
+        impl->temps = tb_nalloc_type(impl->temps_maxn, tb_uint32_t);
+        tb_assert_and_check_return_val(impl->temps, tb_false);
+    }
+
+    // make the histograms of all digits
+    tb_memset(impl->histograms, 0, sizeof(impl->histograms));
+    for (i = 0; i < size; i++)
+    {
+        key = crossings[i];
+        for (j = 0; j < 4; j++, key >>= 8) impl->histograms[j][key & 0xff]++;
+    }
+
+    // sort them using the lsd radix sort
+    tb_size_t       shift;
+    tb_uint32_t     offset;
+    tb_uint32_t     count;
+    tb_uint32_t*    histogram;
+    tb_uint32_t*    src = crossings;
+    tb_uint32_t*    dst = impl->temps;
+    for (j = 0, shift = 0; j < 4; j++, shift += 8)
+    {
+        // all keys have the same digit? skip it
+        histogram = impl->histograms[j];
+        if (histogram[(src[0] >> shift) & 0xff] == size) continue;
+
+        // make the offsets of the digits
+        for (i = 0, offset = 0; i < 256; i++)
+        {
+            count           = histogram[i];
+            histogram[i]    = offset;
+            offset          += count;
+        }
+
+        // scatter the keys by this digit
+        for (i = 0; i < size; i++)
+        {
+            key = src[i];
+            dst[histogram[(key >> shift) & 0xff]++] = key;
+        }
+
+        // swap the buffers
+        tb_swap(tb_uint32_t*, src, dst);
+    }
+
+    // copy the sorted keys back
+    if (src != crossings) tb_memcpy(crossings, src, size * sizeof(tb_uint32_t));
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_strip_raster_emitter_flush(gb_strip_raster_emitter_t* emitter)
+{
+    // check
+    tb_assert(emitter && emitter->func);
+
+    // done the pending span
+    if (emitter->ye > emitter->yb) emitter->func(emitter->lx, emitter->rx, emitter->yb, emitter->ye, emitter->priv);
+
+    // clear it
+    emitter->yb = emitter->ye;
+}
+static tb_void_t gb_strip_raster_emitter_span(gb_strip_raster_emitter_t* emitter, tb_long_t y, tb_long_t lx, tb_long_t rx)
+{
+    // check
+    tb_assert(emitter && emitter->func);
+
+    // empty span?
+    tb_check_return(rx > lx);
+
+    // done it
+    switch (emitter->count++)
+    {
+    case 0:
+        {
+            // save the first span of this row, may be merged to the pending span
+            emitter->first_lx = lx;
+            emitter->first_rx = rx;
+        }
+        break;
+    case 1:
+        {
+            // done the pending span first
+            gb_strip_raster_emitter_flush(emitter);
+
+            // done the first and second spans of this row
+            emitter->func(emitter->first_lx, emitter->first_rx, y, y + 1, emitter->priv);
+            emitter->func(lx, rx, y, y + 1, emitter->priv);
+        }
+        break;
+    default:
+        emitter->func(lx, rx, y, y + 1, emitter->priv);
+        break;
+    }
+}
+static tb_void_t gb_strip_raster_emitter_line(gb_strip_raster_emitter_t* emitter, tb_long_t y)
+{
+    // check
+    tb_assert(emitter);
+
+    // only one span at this row?
+    if (emitter->count == 1)
+    {
+        /* the same span as the previous row? merge it to the pending span
+         *
+         * |    | 
+         * |    |
+         * |    |
+         */
+        if (emitter->ye > emitter->yb && emitter->ye == y && emitter->lx == emitter->first_lx && emitter->rx == emitter->first_rx) emitter->ye++;
+        else
+        {
+            // done the pending span
+            gb_strip_raster_emitter_flush(emitter);
+
+            // pend this span
+            emitter->lx = emitter->first_lx;
+            emitter->rx = emitter->first_rx;
+            emitter->yb = y;
+            emitter->ye = y + 1;
+        }
+    }
+
+    // clear the spans count for the next row
+    emitter->count = 0;
+}
+static tb_void_t gb_strip_raster_scan_convex(gb_strip_raster_impl_t* impl, gb_strip_raster_emitter_t* emitter)
+{
+    // check
+    tb_assert(impl && impl->crossings && impl->rows && emitter);
+
+    // done
+    tb_size_t       i;
+    tb_long_t       y           = impl->top;
+    tb_uint32_t     offset      = 0;
+    tb_uint32_t     size        = 0;
+    tb_uint32_t     lx          = 0;
+    tb_uint32_t     rx          = 0;
+    tb_uint32_t*    rows        = impl->rows;
+    tb_size_t       rows_size   = impl->rows_size;
+    tb_uint32_t*    crossings   = impl->crossings;
+    tb_uint32_t*    crossing    = tb_null;
+    for (i = 0; i < rows_size; i++, y++)
+    {
+        // the crossings of this row, rows[i] is the end offset of this row now
+        offset      = i? rows[i - 1] : 0;
+        size        = rows[i] - offset;
+        crossing    = crossings + offset;
+        tb_check_continue(size > 1);
+
+        // sort them, only two crossings for the most rows
+        if (size == 2)
+        {
+            lx = tb_min(crossing[0], crossing[1]);
+            rx = tb_max(crossing[0], crossing[1]);
+        }
+        else if (gb_strip_raster_crossings_sort(impl, crossing, size))
+        {
+            lx = crossing[0];
+            rx = crossing[1];
+        }
+        else break;
+
+        // only use the first two crossings like the polygon raster
+        gb_strip_raster_emitter_span(emitter, y, tb_fixed_round(gb_strip_raster_key_x(lx)), tb_fixed_round(gb_strip_raster_key_x(rx)));
+        gb_strip_raster_emitter_line(emitter, y);
+    }
+}
+static tb_void_t gb_strip_raster_scan_concave(gb_strip_raster_impl_t* impl, tb_size_t rule, gb_strip_raster_emitter_t* emitter)
+{
+    // check
+    tb_assert(impl && impl->crossings && impl->rows && emitter);
+
+    // done
+    tb_size_t       i;
+    tb_long_t       done        = 0;
+    tb_long_t       winding     = 0;
+    tb_long_t       lx          = 0;
+    tb_long_t       rx          = 0;
+    tb_long_t       cache_lx    = 0;
+    tb_long_t       cache_rx    = 0;
+    tb_bool_t       cache       = tb_false;
+    tb_long_t       y           = impl->top;
+    tb_uint32_t     offset      = 0;
+    tb_uint32_t*    rows        = impl->rows;
+    tb_size_t       rows_size   = impl->rows_size;
+    tb_uint32_t*    crossings   = impl->crossings;
+    tb_uint32_t*    crossing    = tb_null;
+    tb_uint32_t*    tail        = tb_null;
+
+    /* the rule mask
+     *
+     * odd:         winding & 1
+     * non-zero:    winding & ~0
+     */
+    tb_long_t       mask        = 0;
+    switch (rule)
+    {
+    case GB_POLYGON_RASTER_RULE_ODD:
+        mask = 1;
+        break;
+    case GB_POLYGON_RASTER_RULE_NONZERO:
+        mask = -1;
+        break;
+    default:
+        {
+            // trace
+            tb_trace_e("unknown rule: %lu", rule);
+        }
+        return ;
+    }
+
+    // done scan
+    for (i = 0; i < rows_size; i++, y++)
+    {
+        // the crossings of this row, rows[i] is the end offset of this row now
+        offset      = i? rows[i - 1] : 0;
+        crossing    = crossings + offset;
+        tail        = crossings + rows[i];
+        tb_check_continue(tail - crossing > 1);
+
+        // sort them, only two crossings for the most rows
+        if (tail - crossing == 2)
+        {
+            if (crossing[0] > crossing[1]) tb_swap(tb_uint32_t, crossing[0], crossing[1]);
+        }
+        else if (!gb_strip_raster_crossings_sort(impl, crossing, tail - crossing)) break;
+
+        // sweep the crossings of this row
+        winding = 0;
+        cache   = tb_false;
+        for (; crossing + 1 < tail; crossing++)
+        {
+            // compute the winding
+            winding += gb_strip_raster_key_winding(*crossing);
+
+            // compute the rule
+            done = winding & mask;
+            tb_check_continue(done);
+
+            // the span
+            lx = tb_fixed_round(gb_strip_raster_key_x(crossing[0]));
+            rx = tb_fixed_round(gb_strip_raster_key_x(crossing[1]));
+
+            // is conjoint? merge it
+            if (cache && cache_rx == lx) cache_rx = rx;
+            else
+            {
+                // done the cached span
+                if (cache) gb_strip_raster_emitter_span(emitter, y, cache_lx, cache_rx);
+
+                // cache this span
+                cache_lx    = lx;
+                cache_rx    = rx;
+                cache       = tb_true;
+            }
+        }
+
+        // done the left cached span
+        if (cache) gb_strip_raster_emitter_span(emitter, y, cache_lx, cache_rx);
+
+        // end this row
+        gb_strip_raster_emitter_line(emitter, y);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_strip_raster_ref_t gb_strip_raster_init()
+{
+    // init it
+    return (gb_strip_raster_ref_t)tb_malloc0_type(gb_strip_raster_impl_t);
+}
+tb_void_t gb_strip_raster_exit(gb_strip_raster_ref_t raster)
+{
+    // check
+    gb_strip_raster_impl_t* impl = (gb_strip_raster_impl_t*)raster;
+    tb_assert_and_check_return(impl);
+
+    // exit the edges
+    if (impl->edges) tb_free(impl->edges);
+    impl->edges = tb_null;
+
+    // exit the crossings
+    if (impl->crossings) tb_free(impl->crossings);
+    impl->crossings = tb_null;
+
+    // exit the rows
+    if (impl->rows) tb_free(impl->rows);
+    impl->rows = tb_null;
+
+    // exit the temporary crossings
+    if (impl->temps) tb_free(impl->temps);
+    impl->temps = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_strip_raster_done(gb_strip_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
+{
+    // check
+    gb_strip_raster_impl_t* impl = (gb_strip_raster_impl_t*)raster;
+    tb_assert_and_check_return(impl && polygon && polygon->points && polygon->counts && bounds && func);
+
+    // empty polygon?
+    tb_check_return(!gb_near0(bounds->w) && !gb_near0(bounds->h));
+
+    // init the emitter
+    gb_strip_raster_emitter_t emitter;
+    tb_memset(&emitter, 0, sizeof(emitter));
+    emitter.func = func;
+    emitter.priv = priv;
+
+    // is convex polygon for each contour?
+    if (polygon->convex)
+    {
+        // done
+        tb_size_t       index               = 0;
+        gb_point_ref_t  points              = polygon->points;
+        tb_uint16_t*    counts              = polygon->counts;
+        tb_uint16_t     contour_counts[2]   = {0, 0};
+        gb_polygon_t    contour             = {tb_null, contour_counts, tb_true};
+        while ((contour_counts[0] = *counts++))
+        {
+            // init the polygon for this contour
+            contour.points = points + index;
+
+            // done raster for the convex contour
+            if (gb_strip_raster_edges_make(impl, &contour) && gb_strip_raster_crossings_make(impl)) 
+                gb_strip_raster_scan_convex(impl, &emitter);
+
+            // update the contour index
+            index += contour_counts[0];
+        }
+    }
+    else
+    {
+        // done raster for the concave polygon
+        if (gb_strip_raster_edges_make(impl, polygon) && gb_strip_raster_crossings_make(impl))
+            gb_strip_raster_scan_concave(impl, rule, &emitter);
+    }
+
+    // done the left pending span
+    gb_strip_raster_emitter_flush(&emitter);
+}
@@ -63,7 +63,7 @@ typedef struct __gb_paint_impl_t
     tb_uint32_t         mode    : 4;
 
     // the paint flag
-    tb_uint32_t         flag    : 4;
+    tb_uint32_t         flag    : 8;
 
     // the stroke cap
     tb_uint32_t         cap     : 4;
@@ -74,6 +74,9 @@ typedef struct __gb_paint_impl_t
     // the fill rule
     tb_uint32_t         rule    : 1;
 
+    // the blend mode
+    tb_uint32_t         blend   : 5;
+
     // the paint color
     gb_color_t          color;
 
@@ -149,6 +152,7 @@ tb_void_t gb_paint_clear(gb_paint_ref_t paint)
     impl->cap           = GB_PAINT_DEFAULT_CAP;
     impl->join          = GB_PAINT_DEFAULT_JOIN;
     impl->rule          = GB_PAINT_DEFAULT_RULE;
+    impl->blend         = GB_PAINT_BLEND_SRC_OVER;
     impl->width         = GB_PAINT_DEFAULT_WIDTH;
     impl->color         = GB_COLOR_DEFAULT;
     impl->alpha         = GB_PAINT_DEFAULT_ALPHA;
@@ -214,6 +218,24 @@ tb_void_t gb_paint_flag_set(gb_paint_ref_t paint, tb_size_t flag)
     // done
     impl->flag = flag;
 }
+tb_size_t gb_paint_blend(gb_paint_ref_t paint)
+{
+    // check
+    gb_paint_impl_t* impl = (gb_paint_impl_t*)paint;
+    tb_assert_and_check_return_val(impl, GB_PAINT_BLEND_SRC_OVER);
+
+    // the blend mode
+    return impl->blend;
+}
+tb_void_t gb_paint_blend_set(gb_paint_ref_t paint, tb_size_t blend)
+{
+    // check
+    gb_paint_impl_t* impl = (gb_paint_impl_t*)paint;
+    tb_assert_and_check_return(impl && blend < GB_PAINT_BLEND_MAXN);
+
+    // done
+    impl->blend = (tb_uint32_t)blend;
+}
 gb_color_t gb_paint_color(gb_paint_ref_t paint)
 {
     // check
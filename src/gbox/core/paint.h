@@ -56,9 +56,38 @@ typedef enum __gb_paint_flag_e
     GB_PAINT_FLAG_NONE          = 0 //!< none
 ,   GB_PAINT_FLAG_ANTIALIASING  = 1 //!< antialiasing
 ,   GB_PAINT_FLAG_FILTER_BITMAP = 2 //!< filter bitmap
+,   GB_PAINT_FLAG_LINEAR        = 4 //!< blend in the linear-light color space, only for the source-over mode and the argb8888/xrgb8888 pixfmts
+,   GB_PAINT_FLAG_SPARSE_RASTER = 8 //!< fill the polygons using the sparse strip raster, faster for the many small paths with many edges
 
 }gb_paint_flag_e;
 
+/*! the paint blend mode enum
+ *
+ * the porter-duff and separable blend modes, S: the source, D: the destination
+ */
+typedef enum __gb_paint_blend_e
+{
+    GB_PAINT_BLEND_SRC_OVER     = 0     //!< S + D * (1 - sa), the default mode
+,   GB_PAINT_BLEND_CLEAR        = 1     //!< 0
+,   GB_PAINT_BLEND_SRC          = 2     //!< S
+,   GB_PAINT_BLEND_DST          = 3     //!< D
+,   GB_PAINT_BLEND_DST_OVER     = 4     //!< D + S * (1 - da)
+,   GB_PAINT_BLEND_SRC_IN       = 5     //!< S * da
+,   GB_PAINT_BLEND_DST_IN       = 6     //!< D * sa
+,   GB_PAINT_BLEND_SRC_OUT      = 7     //!< S * (1 - da)
+,   GB_PAINT_BLEND_DST_OUT      = 8     //!< D * (1 - sa)
+,   GB_PAINT_BLEND_SRC_ATOP     = 9     //!< S * da + D * (1 - sa)
+,   GB_PAINT_BLEND_DST_ATOP     = 10    //!< D * sa + S * (1 - da)
+,   GB_PAINT_BLEND_XOR          = 11    //!< S * (1 - da) + D * (1 - sa)
+,   GB_PAINT_BLEND_PLUS         = 12    //!< min(S + D, 1)
+,   GB_PAINT_BLEND_MULTIPLY     = 13    //!< S * (1 - da) + D * (1 - sa) + S * D
+,   GB_PAINT_BLEND_SCREEN       = 14    //!< S + D - S * D
+,   GB_PAINT_BLEND_DARKEN       = 15    //!< S + D - max(S * da, D * sa)
+,   GB_PAINT_BLEND_LIGHTEN      = 16    //!< S + D - min(S * da, D * sa)
+,   GB_PAINT_BLEND_MAXN         = 17
+
+}gb_paint_blend_e;
+
 /// the paint stroke cap enum
 typedef enum __gb_paint_stroke_cap_e
 {
@@ -144,6 +173,21 @@ tb_size_t           gb_paint_flag(gb_paint_ref_t paint);
  */
 tb_void_t           gb_paint_flag_set(gb_paint_ref_t paint, tb_size_t flag);
 
+/*! the paint blend mode
+ *
+ * @param paint     the paint
+ *
+ * @return          the blend mode
+ */
+tb_size_t           gb_paint_blend(gb_paint_ref_t paint);
+
+/*! set the paint blend mode
+ *
+ * @param paint     the paint
+ * @param blend     the blend mode
+ */
+tb_void_t           gb_paint_blend_set(gb_paint_ref_t paint, tb_size_t blend);
+
 /*! the paint color
  *
  * @param paint     the paint 
@@ -0,0 +1,555 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        palette.c
+ * @ingroup     core
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "palette"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "palette.h"
+#include "bitmap.h"
+#include "pixmap.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the cells count of the rgb555 cube
+#define GB_PALETTE_CUBE_MAXN            (32768)
+
+// the cell index of the rgb555 cube
+#define GB_PALETTE_CUBE(r, g, b)        (((r) << 10) | ((g) << 5) | (b))
+
+// the maximum row bands count for making the histogram concurrently
+#ifdef __gb_small__
+#   define GB_PALETTE_BANDS_MAXN        (4)
+#else
+#   define GB_PALETTE_BANDS_MAXN        (8)
+#endif
+
+/* the minimum pixels count of the row band
+ *
+ * every band has its own histogram with 32768 cells, 
+ * so the small bitmap is only quantized in the current thread
+ */
+#define GB_PALETTE_BAND_PIXELS_MINN     (1 << 18)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the palette impl type
+typedef struct __gb_palette_impl_t
+{
+    // the colors
+    gb_color_t              colors[GB_PALETTE_MAXN];
+
+    // the colors count
+    tb_size_t               count;
+
+    // the inverse color map: rgb555 => index
+    tb_byte_t               indices[GB_PALETTE_CUBE_MAXN];
+
+}gb_palette_impl_t;
+
+// the histogram cell type of the quantizer
+typedef struct __gb_palette_cell_t
+{
+    // the pixels count
+    tb_hize_t               count;
+
+    // the sum of the r, g, b components
+    tb_hize_t               sum[3];
+
+}gb_palette_cell_t;
+
+// the box type of the quantizer, the rgb555 bounds: [min, max]
+typedef struct __gb_palette_box_t
+{
+    // the min bounds
+    tb_size_t               min[3];
+
+    // the max bounds
+    tb_size_t               max[3];
+
+    // the pixels count
+    tb_hize_t               count;
+
+}gb_palette_box_t;
+
+// the row band type of the quantizer
+typedef struct __gb_palette_band_t
+{
+    // the histogram cells of this band
+    gb_palette_cell_t*          cells;
+
+    // the bitmap
+    gb_bitmap_ref_t             bitmap;
+
+    // the color getter
+    gb_pixmap_func_color_get_t  color_get;
+
+    // the bytes per pixel
+    tb_size_t                   btp;
+
+    // the head row
+    tb_size_t                   head;
+
+    // the tail row
+    tb_size_t                   tail;
+
+    // the semaphore for notifying the waiting thread
+    tb_semaphore_ref_t          semaphore;
+
+}gb_palette_band_t, *gb_palette_band_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_palette_band_done(gb_palette_band_ref_t band)
+{
+    // check
+    tb_assert(band && band->cells && band->bitmap && band->color_get);
+
+    // the pixels
+    tb_byte_t const* pixels = (tb_byte_t const*)gb_bitmap_data(band->bitmap);
+    tb_assert(pixels);
+
+    // make the rgb555 histogram of the rows [head, tail)
+    tb_size_t                   x = 0;
+    tb_size_t                   y = 0;
+    tb_size_t                   btp = band->btp;
+    tb_size_t                   width = gb_bitmap_width(band->bitmap);
+    tb_size_t                   row_bytes = gb_bitmap_row_bytes(band->bitmap);
+    gb_palette_cell_t*          cells = band->cells;
+    gb_pixmap_func_color_get_t  color_get = band->color_get;
+    for (y = band->head; y < band->tail; y++)
+    {
+        tb_byte_t const* p = pixels + y * row_bytes;
+        for (x = 0; x < width; x++, p += btp)
+        {
+            gb_color_t          color = color_get(p);
+            gb_palette_cell_t*  cell = cells + GB_PALETTE_CUBE(color.r >> 3, color.g >> 3, color.b >> 3);
+            cell->count++;
+            cell->sum[0] += color.r;
+            cell->sum[1] += color.g;
+            cell->sum[2] += color.b;
+        }
+    }
+}
+static tb_void_t gb_palette_band_task(tb_thread_pool_worker_ref_t pool_worker, tb_cpointer_t priv)
+{
+    // check
+    gb_palette_band_ref_t band = (gb_palette_band_ref_t)priv;
+    tb_assert(band && band->semaphore);
+
+    // done band
+    gb_palette_band_done(band);
+
+    // notify the waiting thread
+    tb_semaphore_post(band->semaphore, 1);
+}
+static tb_void_t gb_palette_make_histogram(gb_bitmap_ref_t bitmap, gb_pixmap_ref_t pixmap, gb_palette_cell_t* cells)
+{
+    // check
+    tb_assert(bitmap && pixmap && pixmap->color_get && cells);
+
+    // the bands count
+    tb_size_t width         = gb_bitmap_width(bitmap);
+    tb_size_t height        = gb_bitmap_height(bitmap);
+    tb_size_t bands_count   = tb_min(tb_processor_count(), GB_PALETTE_BANDS_MAXN);
+    bands_count = tb_min(bands_count, (width * height) / GB_PALETTE_BAND_PIXELS_MINN);
+    bands_count = tb_max(bands_count, 1);
+
+    // the thread pool and the semaphore for waiting the bands
+    tb_thread_pool_ref_t    pool = bands_count > 1? tb_thread_pool() : tb_null;
+    tb_semaphore_ref_t      semaphore = pool? tb_semaphore_init(0) : tb_null;
+    if (!semaphore) bands_count = 1;
+
+    /* init bands
+     *
+     * the first band makes the histogram into the given cells directly,
+     * the other bands have their own cells and the bands failed to make cells are dropped
+     */
+    tb_size_t           i = 0;
+    gb_palette_band_t   bands[GB_PALETTE_BANDS_MAXN];
+    tb_memset(bands, 0, sizeof(bands));
+    bands[0].cells = cells;
+    for (i = 1; i < bands_count; i++)
+    {
+        bands[i].cells = tb_nalloc0_type(GB_PALETTE_CUBE_MAXN, gb_palette_cell_t);
+        tb_check_break(bands[i].cells);
+    }
+    bands_count = i;
+
+    // split the rows to the bands
+    for (i = 0; i < bands_count; i++)
+    {
+        bands[i].bitmap     = bitmap;
+        bands[i].color_get  = pixmap->color_get;
+        bands[i].btp        = pixmap->btp;
+        bands[i].head       = (height * i) / bands_count;
+        bands[i].tail       = (height * (i + 1)) / bands_count;
+        bands[i].semaphore  = semaphore;
+    }
+
+    // post the other bands to the thread pool
+    tb_size_t posted = 0;
+    tb_bool_t inlined[GB_PALETTE_BANDS_MAXN] = {0};
+    for (i = 1; i < bands_count; i++)
+    {
+        if (tb_thread_pool_task_post(pool, "palette", gb_palette_band_task, tb_null, &bands[i], tb_false)) posted++;
+        else inlined[i] = tb_true;
+    }
+
+    // done the first band and the bands which were not posted in the current thread
+    gb_palette_band_done(&bands[0]);
+    for (i = 1; i < bands_count; i++)
+        if (inlined[i]) gb_palette_band_done(&bands[i]);
+
+    // wait the posted bands
+    while (posted)
+    {
+        if (tb_semaphore_wait(semaphore, -1) > 0) posted--;
+    }
+
+    // sum the histograms of the other bands
+    tb_size_t j = 0;
+    for (i = 1; i < bands_count; i++)
+    {
+        gb_palette_cell_t const* band_cells = bands[i].cells;
+        for (j = 0; j < GB_PALETTE_CUBE_MAXN; j++)
+        {
+            cells[j].count  += band_cells[j].count;
+            cells[j].sum[0] += band_cells[j].sum[0];
+            cells[j].sum[1] += band_cells[j].sum[1];
+            cells[j].sum[2] += band_cells[j].sum[2];
+        }
+        tb_free(bands[i].cells);
+    }
+
+    // exit semaphore
+    if (semaphore) tb_semaphore_exit(semaphore);
+}
+static tb_void_t gb_palette_make_indices(gb_palette_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->count);
+
+    // done
+    tb_size_t r = 0;
+    tb_size_t g = 0;
+    tb_size_t b = 0;
+    tb_size_t i = 0;
+    for (r = 0; r < 32; r++)
+    {
+        for (g = 0; g < 32; g++)
+        {
+            for (b = 0; b < 32; b++)
+            {
+                // the center color of this cell
+                tb_long_t cr = (tb_long_t)(r << 3) + 4;
+                tb_long_t cg = (tb_long_t)(g << 3) + 4;
+                tb_long_t cb = (tb_long_t)(b << 3) + 4;
+
+                // find the nearest color
+                tb_size_t best = 0;
+                tb_size_t mind = (tb_size_t)-1;
+                for (i = 0; i < impl->count && mind; i++)
+                {
+                    tb_long_t dr = (tb_long_t)impl->colors[i].r - cr;
+                    tb_long_t dg = (tb_long_t)impl->colors[i].g - cg;
+                    tb_long_t db = (tb_long_t)impl->colors[i].b - cb;
+                    tb_size_t d = (tb_size_t)(dr * dr + dg * dg + db * db);
+                    if (d < mind)
+                    {
+                        mind = d;
+                        best = i;
+                    }
+                }
+
+                // save it
+                impl->indices[GB_PALETTE_CUBE(r, g, b)] = (tb_byte_t)best;
+            }
+        }
+    }
+}
+static tb_void_t gb_palette_box_shrink(gb_palette_box_t* box, gb_palette_cell_t const* cells)
+{
+    // check
+    tb_assert(box && cells);
+
+    // the bounds of the non-empty cells
+    tb_size_t   min[3] = {31, 31, 31};
+    tb_size_t   max[3] = {0, 0, 0};
+    tb_hize_t   count = 0;
+    tb_size_t   c[3];
+    for (c[0] = box->min[0]; c[0] <= box->max[0]; c[0]++)
+    {
+        for (c[1] = box->min[1]; c[1] <= box->max[1]; c[1]++)
+        {
+            for (c[2] = box->min[2]; c[2] <= box->max[2]; c[2]++)
+            {
+                // empty?
+                gb_palette_cell_t const* cell = cells + GB_PALETTE_CUBE(c[0], c[1], c[2]);
+                tb_check_continue(cell->count);
+
+                // update bounds
+                tb_size_t i = 0;
+                for (i = 0; i < 3; i++)
+                {
+                    if (c[i] < min[i]) min[i] = c[i];
+                    if (c[i] > max[i]) max[i] = c[i];
+                }
+                count += cell->count;
+            }
+        }
+    }
+
+    // update box
+    tb_memcpy(box->min, min, sizeof(min));
+    tb_memcpy(box->max, max, sizeof(max));
+    box->count = count;
+}
+static tb_bool_t gb_palette_box_split(gb_palette_box_t* box, gb_palette_box_t* other, gb_palette_cell_t const* cells)
+{
+    // check
+    tb_assert(box && other && cells);
+
+    // the longest axis
+    tb_size_t i = 0;
+    tb_size_t axis = 0;
+    for (i = 1; i < 3; i++)
+    {
+        if (box->max[i] - box->min[i] > box->max[axis] - box->min[axis]) axis = i;
+    }
+
+    // only one cell? not splittable
+    tb_check_return_val(box->max[axis] > box->min[axis], tb_false);
+
+    // make the histogram along this axis
+    tb_hize_t   slices[32] = {0};
+    tb_size_t   c[3];
+    for (c[0] = box->min[0]; c[0] <= box->max[0]; c[0]++)
+    {
+        for (c[1] = box->min[1]; c[1] <= box->max[1]; c[1]++)
+        {
+            for (c[2] = box->min[2]; c[2] <= box->max[2]; c[2]++)
+                slices[c[axis]] += cells[GB_PALETTE_CUBE(c[0], c[1], c[2])].count;
+        }
+    }
+
+    /* find the median slice
+     *
+     * the min and max slices are not empty after shrinking, 
+     * so both boxes are not empty if the median slice is less than the max slice
+     */
+    tb_size_t   median = box->min[axis];
+    tb_hize_t   count = slices[median];
+    while ((count << 1) < box->count && median + 1 < box->max[axis]) count += slices[++median];
+
+    // split it: [min, median] and [median + 1, max]
+    *other = *box;
+    box->max[axis]      = median;
+    other->min[axis]    = median + 1;
+
+    // shrink them
+    gb_palette_box_shrink(box, cells);
+    gb_palette_box_shrink(other, cells);
+
+    // ok
+    return tb_true;
+}
+static gb_color_t gb_palette_box_color(gb_palette_box_t const* box, gb_palette_cell_t const* cells)
+{
+    // check
+    tb_assert(box && box->count && cells);
+
+    // the sum of the components
+    tb_hize_t   sum[3] = {0, 0, 0};
+    tb_size_t   c[3];
+    for (c[0] = box->min[0]; c[0] <= box->max[0]; c[0]++)
+    {
+        for (c[1] = box->min[1]; c[1] <= box->max[1]; c[1]++)
+        {
+            for (c[2] = box->min[2]; c[2] <= box->max[2]; c[2]++)
+            {
+                gb_palette_cell_t const* cell = cells + GB_PALETTE_CUBE(c[0], c[1], c[2]);
+                sum[0] += cell->sum[0];
+                sum[1] += cell->sum[1];
+                sum[2] += cell->sum[2];
+            }
+        }
+    }
+
+    // the average color
+    gb_color_t color;
+    color.r = (tb_byte_t)((sum[0] + (box->count >> 1)) / box->count);
+    color.g = (tb_byte_t)((sum[1] + (box->count >> 1)) / box->count);
+    color.b = (tb_byte_t)((sum[2] + (box->count >> 1)) / box->count);
+    color.a = 0xff;
+    return color;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_palette_ref_t gb_palette_init(gb_color_t const* colors, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(colors && count && count <= GB_PALETTE_MAXN, tb_null);
+
+    // make palette
+    gb_palette_impl_t* impl = tb_malloc0_type(gb_palette_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init colors
+    tb_memcpy(impl->colors, colors, count * sizeof(gb_color_t));
+    impl->count = count;
+
+    // make the inverse color map
+    gb_palette_make_indices(impl);
+
+    // ok
+    return (gb_palette_ref_t)impl;
+}
+gb_palette_ref_t gb_palette_init_from_bitmap(gb_bitmap_ref_t bitmap, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(bitmap && count && count <= GB_PALETTE_MAXN, tb_null);
+
+    // done
+    gb_palette_ref_t    palette = tb_null;
+    gb_palette_cell_t*  cells = tb_null;
+    do
+    {
+        // the pixmap, the pal8 bitmap has not the color_get()
+        tb_size_t       pixfmt = gb_bitmap_pixfmt(bitmap);
+        gb_pixmap_ref_t pixmap = gb_pixmap(pixfmt, 0xff);
+        tb_assert_and_check_break(pixmap && pixmap->color_get && GB_PIXFMT(pixfmt) != GB_PIXFMT(GB_PIXFMT_PAL8));
+
+        // check pixels
+        tb_assert_and_check_break(gb_bitmap_data(bitmap));
+
+        // make cells
+        cells = tb_nalloc0_type(GB_PALETTE_CUBE_MAXN, gb_palette_cell_t);
+        tb_assert_and_check_break(cells);
+
+        // make the rgb555 histogram by the row bands concurrently
+        gb_palette_make_histogram(bitmap, pixmap, cells);
+
+        // init the first box with all cells
+        gb_palette_box_t    boxes[GB_PALETTE_MAXN];
+        tb_size_t           boxes_count = 1;
+        boxes[0].min[0] = boxes[0].min[1] = boxes[0].min[2] = 0;
+        boxes[0].max[0] = boxes[0].max[1] = boxes[0].max[2] = 31;
+        gb_palette_box_shrink(&boxes[0], cells);
+        tb_assert_and_check_break(boxes[0].count);
+
+        /* split the most populous box at its median until the colors are enough 
+         *
+         * the boxes with only one cell are not splittable and will be skipped
+         */
+        tb_size_t           i = 0;
+        tb_bool_t           splittable[GB_PALETTE_MAXN];
+        splittable[0] = tb_true;
+        while (boxes_count < count)
+        {
+            // find the most populous box
+            tb_size_t best = boxes_count;
+            for (i = 0; i < boxes_count; i++)
+            {
+                if (splittable[i] && (best == boxes_count || boxes[i].count > boxes[best].count)) best = i;
+            }
+
+            // no more splittable boxes?
+            tb_check_break(best < boxes_count);
+
+            // split it
+            if (gb_palette_box_split(&boxes[best], &boxes[boxes_count], cells))
+                splittable[boxes_count++] = tb_true;
+            else splittable[best] = tb_false;
+        }
+
+        // make colors
+        gb_color_t colors[GB_PALETTE_MAXN];
+        for (i = 0; i < boxes_count; i++) colors[i] = gb_palette_box_color(&boxes[i], cells);
+
+        // trace
+        tb_trace_d("quantize: %lux%lu => %lu colors", gb_bitmap_width(bitmap), gb_bitmap_height(bitmap), boxes_count);
+
+        // init palette
+        palette = gb_palette_init(colors, boxes_count);
+
+    } while (0);
+
+    // exit cells
+    if (cells) tb_free(cells);
+    cells = tb_null;
+
+    // ok?
+    return palette;
+}
+tb_void_t gb_palette_exit(gb_palette_ref_t palette)
+{
+    // check
+    gb_palette_impl_t* impl = (gb_palette_impl_t*)palette;
+    tb_assert_and_check_return(impl);
+
+    // exit it
+    tb_free(impl);
+}
+tb_size_t gb_palette_size(gb_palette_ref_t palette)
+{
+    // check
+    gb_palette_impl_t* impl = (gb_palette_impl_t*)palette;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the colors count
+    return impl->count;
+}
+gb_color_t gb_palette_color(gb_palette_ref_t palette, tb_size_t index)
+{
+    // check
+    gb_palette_impl_t* impl = (gb_palette_impl_t*)palette;
+    tb_assert_and_check_return_val(impl && index < impl->count, GB_COLOR_DEFAULT);
+
+    // the color
+    return impl->colors[index];
+}
+tb_size_t gb_palette_index(gb_palette_ref_t palette, gb_color_t color)
+{
+    // check
+    gb_palette_impl_t* impl = (gb_palette_impl_t*)palette;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the nearest color index
+    return impl->indices[GB_PALETTE_CUBE(color.r >> 3, color.g >> 3, color.b >> 3)];
+}
@@ -0,0 +1,107 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        palette.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_PALETTE_H
+#define GB_CORE_PALETTE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the palette maximum count
+#define GB_PALETTE_MAXN         (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init palette 
+ *
+ * the inverse color map of the rgb555 cube will be made once for this palette, 
+ * so the color => index lookup is O(1) for filling and blending the pal8 pixels
+ *
+ * @param colors    the colors
+ * @param count     the colors count, must be in [1, GB_PALETTE_MAXN]
+ *
+ * @return          the palette
+ */
+gb_palette_ref_t    gb_palette_init(gb_color_t const* colors, tb_size_t count);
+
+/*! init palette from the bitmap using the median-cut quantizer
+ *
+ * @param bitmap    the bitmap, the pal8 bitmap is not supported
+ * @param count     the maximum colors count, must be in [1, GB_PALETTE_MAXN]
+ *
+ * @return          the palette
+ */
+gb_palette_ref_t    gb_palette_init_from_bitmap(gb_bitmap_ref_t bitmap, tb_size_t count);
+
+/*! exit palette 
+ *
+ * @param palette   the palette
+ */
+tb_void_t           gb_palette_exit(gb_palette_ref_t palette);
+
+/*! the palette colors count
+ *
+ * @param palette   the palette
+ *
+ * @return          the colors count
+ */
+tb_size_t           gb_palette_size(gb_palette_ref_t palette);
+
+/*! the palette color
+ *
+ * @param palette   the palette
+ * @param index     the color index
+ *
+ * @return          the color
+ */
+gb_color_t          gb_palette_color(gb_palette_ref_t palette, tb_size_t index);
+
+/*! the index of the nearest palette color
+ *
+ * @param palette   the palette
+ * @param color     the color, the alpha will be ignored
+ *
+ * @return          the color index
+ */
+tb_size_t           gb_palette_index(gb_palette_ref_t palette, gb_color_t color);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
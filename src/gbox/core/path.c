@@ -107,8 +107,18 @@ typedef struct __gb_path_impl_t
     // the polygon counts, gb_uint16_t[]
     tb_vector_ref_t     polygon_counts;
 
+    // the version of the polygon
+    tb_size_t           version;
+
 }gb_path_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the version of the last remade path polygon
+static tb_atomic_t      g_version = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -328,6 +338,66 @@ static tb_bool_t gb_path_make_hint(gb_path_impl_t* impl)
     // ok
     return tb_true;
 }
+static tb_bool_t gb_path_make_convex_once(gb_path_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->points, tb_false);
+
+    // the points
+    gb_point_ref_t  points = (gb_point_ref_t)tb_vector_data(impl->points);
+    tb_size_t       count = tb_vector_size(impl->points);
+    tb_assert_and_check_return_val(points && count, tb_false);
+
+    /* the convex contour only turns around once
+     *
+     * the signs of dx and dy are changed twice at most along all closed edges,
+     * so the star and the collinear spike with the same cross signs are not convex
+     */
+    tb_size_t       i = 0;
+    tb_long_t       dx = 0;
+    tb_long_t       dy = 0;
+    tb_long_t       sign_x = 0;
+    tb_long_t       sign_y = 0;
+    tb_long_t       first_x = 0;
+    tb_long_t       first_y = 0;
+    tb_size_t       changes_x = 0;
+    tb_size_t       changes_y = 0;
+    gb_point_ref_t  p0 = tb_null;
+    gb_point_ref_t  p1 = tb_null;
+    for (i = 0; i < count; i++)
+    {
+        // the edge
+        p0 = points + i;
+        p1 = points + (i + 1 < count? i + 1 : 0);
+
+        // the signs of dx and dy
+        dx = p1->x > p0->x? 1 : (p1->x < p0->x? -1 : 0);
+        dy = p1->y > p0->y? 1 : (p1->y < p0->y? -1 : 0);
+
+        // update the changes of the x-direction
+        if (dx)
+        {
+            if (!sign_x) first_x = dx;
+            else if (dx != sign_x) changes_x++;
+            sign_x = dx;
+        }
+
+        // update the changes of the y-direction
+        if (dy)
+        {
+            if (!sign_y) first_y = dy;
+            else if (dy != sign_y) changes_y++;
+            sign_y = dy;
+        }
+    }
+
+    // the changes from the last edge to the first edge
+    if (sign_x != first_x) changes_x++;
+    if (sign_y != first_y) changes_y++;
+
+    // ok?
+    return changes_x <= 2 && changes_y <= 2;
+}
 static tb_bool_t gb_path_make_convex(gb_path_impl_t* impl)
 {
     // check
@@ -572,6 +642,10 @@ static tb_bool_t gb_path_make_convex(gb_path_impl_t* impl)
         // check
         tb_assert(point_count > 2);
         tb_assert(contour_count == 1);
+
+        // the same cross signs are not enough for the contour turned around more than once
+        if ((impl->flag & GB_PATH_FLAG_CONVEX) && !gb_path_make_convex_once(impl))
+            impl->flag &= ~GB_PATH_FLAG_CONVEX;
     }
 
     // trace
@@ -1024,6 +1098,9 @@ tb_void_t gb_path_last_set(gb_path_ref_t path, gb_point_ref_t point)
 
     // save it
     if (last) *last = *point;
+
+    // mark dirty
+    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
 }
 gb_shape_ref_t gb_path_hint(gb_path_ref_t path)
 {
@@ -1064,11 +1141,26 @@ gb_polygon_ref_t gb_path_polygon(gb_path_ref_t path)
 
         // remove dirty
         impl->flag &= ~GB_PATH_FLAG_DIRTY_POLYGON;
+
+        // update version
+        impl->version = (tb_size_t)tb_atomic_add_and_fetch(&g_version, 1);
     }
 
     // ok?
     return &impl->polygon;
 }
+tb_size_t gb_path_version(gb_path_ref_t path)
+{
+    // check
+    gb_path_impl_t* impl = (gb_path_impl_t*)path;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // make polygon and update version if the path have been modified
+    if (impl->flag & GB_PATH_FLAG_DIRTY_POLYGON) gb_path_polygon(path);
+
+    // the version
+    return impl->version;
+}
 tb_void_t gb_path_apply(gb_path_ref_t path, gb_matrix_ref_t matrix)
 {
     // check
@@ -1084,6 +1176,9 @@ tb_void_t gb_path_apply(gb_path_ref_t path, gb_matrix_ref_t matrix)
         // apply it
         gb_point_apply(point, matrix);
     }
+
+    // mark dirty
+    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
 }
 tb_void_t gb_path_clos(gb_path_ref_t path)
 {
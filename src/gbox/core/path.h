@@ -166,6 +166,17 @@ gb_shape_ref_t      gb_path_hint(gb_path_ref_t path);
  */
 gb_polygon_ref_t    gb_path_polygon(gb_path_ref_t path);
 
+/*! the path version
+ *
+ * the version is unique for all paths and will be changed after the path is modified,
+ * so it can be used as the key for caching the data made from the path
+ *
+ * @param path      the path
+ *
+ * @return          the version
+ */
+tb_size_t           gb_path_version(gb_path_ref_t path);
+
 /*! apply the matrix to the path 
  *
  * @param path      the path
@@ -23,6 +23,13 @@
  * @ingroup     core
  *
  */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "pixmap"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
@@ -42,6 +49,12 @@
 #include "pixmap/rgbx4444.h"
 #include "pixmap/rgba8888.h"
 #include "pixmap/rgbx8888.h"
+#include "pixmap/pargb8888.h"
+#include "pixmap/a8.h"
+#include "pixmap/g8.h"
+#include "pixmap/blend.h"
+#include "pixmap/linear.h"
+#include "paint.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals 
@@ -81,6 +94,10 @@ static gb_pixmap_ref_t g_pixmaps_lo[] =
 ,	tb_null
 ,	tb_null
 
+,	&g_pixmap_lo_pargb8888
+,	&g_pixmap_o_a8
+,	&g_pixmap_o_g8
+
 };
 
 // the pixmaps for opaque and big endian
@@ -117,6 +134,10 @@ static gb_pixmap_ref_t g_pixmaps_bo[] =
 ,	tb_null
 ,	tb_null
 
+,	&g_pixmap_bo_pargb8888
+,	&g_pixmap_o_a8
+,	&g_pixmap_o_g8
+
 };
 
 // the pixmaps for alpha and little endian
@@ -153,6 +174,10 @@ static gb_pixmap_ref_t g_pixmaps_la[] =
 ,	tb_null
 ,	tb_null
 
+,	&g_pixmap_la_pargb8888
+,	&g_pixmap_a_a8
+,	&g_pixmap_a_g8
+
 };
 
 // the pixmaps for alpha and big endian
@@ -189,6 +214,63 @@ static gb_pixmap_ref_t g_pixmaps_ba[] =
 ,	tb_null
 ,	tb_null
 
+,	&g_pixmap_ba_pargb8888
+,	&g_pixmap_a_a8
+,	&g_pixmap_a_g8
+
+};
+
+// the blend pixmaps for little endian, the source-over mode uses the alpha pixmaps
+static gb_pixmap_ref_t g_pixmaps_blend_l[][4] =
+{
+    {tb_null, tb_null, tb_null, tb_null}
+,   {&g_pixmap_blend_clear_rgb565_l, &g_pixmap_blend_clear_argb8888_l, &g_pixmap_blend_clear_xrgb8888_l, &g_pixmap_blend_clear_pargb8888_l}
+,   {&g_pixmap_blend_src_rgb565_l, &g_pixmap_blend_src_argb8888_l, &g_pixmap_blend_src_xrgb8888_l, &g_pixmap_blend_src_pargb8888_l}
+,   {&g_pixmap_blend_dst_rgb565_l, &g_pixmap_blend_dst_argb8888_l, &g_pixmap_blend_dst_xrgb8888_l, &g_pixmap_blend_dst_pargb8888_l}
+,   {&g_pixmap_blend_dst_over_rgb565_l, &g_pixmap_blend_dst_over_argb8888_l, &g_pixmap_blend_dst_over_xrgb8888_l, &g_pixmap_blend_dst_over_pargb8888_l}
+,   {&g_pixmap_blend_src_in_rgb565_l, &g_pixmap_blend_src_in_argb8888_l, &g_pixmap_blend_src_in_xrgb8888_l, &g_pixmap_blend_src_in_pargb8888_l}
+,   {&g_pixmap_blend_dst_in_rgb565_l, &g_pixmap_blend_dst_in_argb8888_l, &g_pixmap_blend_dst_in_xrgb8888_l, &g_pixmap_blend_dst_in_pargb8888_l}
+,   {&g_pixmap_blend_src_out_rgb565_l, &g_pixmap_blend_src_out_argb8888_l, &g_pixmap_blend_src_out_xrgb8888_l, &g_pixmap_blend_src_out_pargb8888_l}
+,   {&g_pixmap_blend_dst_out_rgb565_l, &g_pixmap_blend_dst_out_argb8888_l, &g_pixmap_blend_dst_out_xrgb8888_l, &g_pixmap_blend_dst_out_pargb8888_l}
+,   {&g_pixmap_blend_src_atop_rgb565_l, &g_pixmap_blend_src_atop_argb8888_l, &g_pixmap_blend_src_atop_xrgb8888_l, &g_pixmap_blend_src_atop_pargb8888_l}
+,   {&g_pixmap_blend_dst_atop_rgb565_l, &g_pixmap_blend_dst_atop_argb8888_l, &g_pixmap_blend_dst_atop_xrgb8888_l, &g_pixmap_blend_dst_atop_pargb8888_l}
+,   {&g_pixmap_blend_xor_rgb565_l, &g_pixmap_blend_xor_argb8888_l, &g_pixmap_blend_xor_xrgb8888_l, &g_pixmap_blend_xor_pargb8888_l}
+,   {&g_pixmap_blend_plus_rgb565_l, &g_pixmap_blend_plus_argb8888_l, &g_pixmap_blend_plus_xrgb8888_l, &g_pixmap_blend_plus_pargb8888_l}
+,   {&g_pixmap_blend_multiply_rgb565_l, &g_pixmap_blend_multiply_argb8888_l, &g_pixmap_blend_multiply_xrgb8888_l, &g_pixmap_blend_multiply_pargb8888_l}
+,   {&g_pixmap_blend_screen_rgb565_l, &g_pixmap_blend_screen_argb8888_l, &g_pixmap_blend_screen_xrgb8888_l, &g_pixmap_blend_screen_pargb8888_l}
+,   {&g_pixmap_blend_darken_rgb565_l, &g_pixmap_blend_darken_argb8888_l, &g_pixmap_blend_darken_xrgb8888_l, &g_pixmap_blend_darken_pargb8888_l}
+,   {&g_pixmap_blend_lighten_rgb565_l, &g_pixmap_blend_lighten_argb8888_l, &g_pixmap_blend_lighten_xrgb8888_l, &g_pixmap_blend_lighten_pargb8888_l}
+};
+
+// the blend pixmaps for big endian, the source-over mode uses the alpha pixmaps
+static gb_pixmap_ref_t g_pixmaps_blend_b[][4] =
+{
+    {tb_null, tb_null, tb_null, tb_null}
+,   {&g_pixmap_blend_clear_rgb565_b, &g_pixmap_blend_clear_argb8888_b, &g_pixmap_blend_clear_xrgb8888_b, &g_pixmap_blend_clear_pargb8888_b}
+,   {&g_pixmap_blend_src_rgb565_b, &g_pixmap_blend_src_argb8888_b, &g_pixmap_blend_src_xrgb8888_b, &g_pixmap_blend_src_pargb8888_b}
+,   {&g_pixmap_blend_dst_rgb565_b, &g_pixmap_blend_dst_argb8888_b, &g_pixmap_blend_dst_xrgb8888_b, &g_pixmap_blend_dst_pargb8888_b}
+,   {&g_pixmap_blend_dst_over_rgb565_b, &g_pixmap_blend_dst_over_argb8888_b, &g_pixmap_blend_dst_over_xrgb8888_b, &g_pixmap_blend_dst_over_pargb8888_b}
+,   {&g_pixmap_blend_src_in_rgb565_b, &g_pixmap_blend_src_in_argb8888_b, &g_pixmap_blend_src_in_xrgb8888_b, &g_pixmap_blend_src_in_pargb8888_b}
+,   {&g_pixmap_blend_dst_in_rgb565_b, &g_pixmap_blend_dst_in_argb8888_b, &g_pixmap_blend_dst_in_xrgb8888_b, &g_pixmap_blend_dst_in_pargb8888_b}
+,   {&g_pixmap_blend_src_out_rgb565_b, &g_pixmap_blend_src_out_argb8888_b, &g_pixmap_blend_src_out_xrgb8888_b, &g_pixmap_blend_src_out_pargb8888_b}
+,   {&g_pixmap_blend_dst_out_rgb565_b, &g_pixmap_blend_dst_out_argb8888_b, &g_pixmap_blend_dst_out_xrgb8888_b, &g_pixmap_blend_dst_out_pargb8888_b}
+,   {&g_pixmap_blend_src_atop_rgb565_b, &g_pixmap_blend_src_atop_argb8888_b, &g_pixmap_blend_src_atop_xrgb8888_b, &g_pixmap_blend_src_atop_pargb8888_b}
+,   {&g_pixmap_blend_dst_atop_rgb565_b, &g_pixmap_blend_dst_atop_argb8888_b, &g_pixmap_blend_dst_atop_xrgb8888_b, &g_pixmap_blend_dst_atop_pargb8888_b}
+,   {&g_pixmap_blend_xor_rgb565_b, &g_pixmap_blend_xor_argb8888_b, &g_pixmap_blend_xor_xrgb8888_b, &g_pixmap_blend_xor_pargb8888_b}
+,   {&g_pixmap_blend_plus_rgb565_b, &g_pixmap_blend_plus_argb8888_b, &g_pixmap_blend_plus_xrgb8888_b, &g_pixmap_blend_plus_pargb8888_b}
+,   {&g_pixmap_blend_multiply_rgb565_b, &g_pixmap_blend_multiply_argb8888_b, &g_pixmap_blend_multiply_xrgb8888_b, &g_pixmap_blend_multiply_pargb8888_b}
+,   {&g_pixmap_blend_screen_rgb565_b, &g_pixmap_blend_screen_argb8888_b, &g_pixmap_blend_screen_xrgb8888_b, &g_pixmap_blend_screen_pargb8888_b}
+,   {&g_pixmap_blend_darken_rgb565_b, &g_pixmap_blend_darken_argb8888_b, &g_pixmap_blend_darken_xrgb8888_b, &g_pixmap_blend_darken_pargb8888_b}
+,   {&g_pixmap_blend_lighten_rgb565_b, &g_pixmap_blend_lighten_argb8888_b, &g_pixmap_blend_lighten_xrgb8888_b, &g_pixmap_blend_lighten_pargb8888_b}
+};
+
+// the 4x4 bayer matrix
+static tb_byte_t const g_pixmap_dither_bayer[4][4] = 
+{
+    { 0,  8,  2, 10}
+,   {12,  4, 14,  6}
+,   { 3, 11,  1,  9}
+,   {15,  7, 13,  5}
 };
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -204,7 +286,7 @@ gb_pixmap_ref_t gb_pixmap(tb_size_t pixfmt, tb_byte_t alpha)
     tb_assert(pixfmt);
 
     // opaque?
-	if (alpha > GB_ALPHA_MAXN)
+	if (GB_ALPHA_IS_OPAQUE(alpha))
 	{
         // check
 		tb_assert(pixfmt && (pixfmt - 1) < tb_arrayn(g_pixmaps_lo));
@@ -225,4 +307,93 @@ gb_pixmap_ref_t gb_pixmap(tb_size_t pixfmt, tb_byte_t alpha)
 	// transparent
 	return tb_null;
 }
+gb_pixmap_ref_t gb_pixmap_blend(tb_size_t pixfmt, tb_size_t blend, tb_byte_t alpha)
+{
+    // check
+    tb_assert(blend < GB_PAINT_BLEND_MAXN && tb_arrayn(g_pixmaps_blend_l) == GB_PAINT_BLEND_MAXN);
+
+    // source-over? use the opaque or alpha pixmap
+    if (blend == GB_PAINT_BLEND_SRC_OVER) return gb_pixmap(pixfmt, alpha);
+
+    // the pixmap index
+    tb_size_t index;
+    switch (GB_PIXFMT(pixfmt))
+    {
+    case GB_PIXFMT(GB_PIXFMT_RGB565):     index = 0; break;
+    case GB_PIXFMT(GB_PIXFMT_ARGB8888):   index = 1; break;
+    case GB_PIXFMT(GB_PIXFMT_XRGB8888):   index = 2; break;
+    case GB_PIXFMT(GB_PIXFMT_PARGB8888):  index = 3; break;
+    default:
+        tb_trace_e("the blend mode %lu is not supported for pixfmt: %lx", blend, pixfmt);
+        return tb_null;
+    }
+
+    // ok
+    return GB_PIXFMT_BE(pixfmt)? g_pixmaps_blend_b[blend][index] : g_pixmaps_blend_l[blend][index];
+}
+gb_pixmap_ref_t gb_pixmap_linear(tb_size_t pixfmt, tb_byte_t alpha)
+{
+    // opaque or transparent? need not blend it
+    if (GB_ALPHA_IS_OPAQUE(alpha) || alpha < GB_ALPHA_MINN) return gb_pixmap(pixfmt, alpha);
+
+    // the linear pixmap
+    tb_size_t bendian = GB_PIXFMT_BE(pixfmt);
+    switch (GB_PIXFMT(pixfmt))
+    {
+    case GB_PIXFMT(GB_PIXFMT_ARGB8888): return bendian? &g_pixmap_linear_ba_argb8888 : &g_pixmap_linear_la_argb8888;
+    case GB_PIXFMT(GB_PIXFMT_XRGB8888): return bendian? &g_pixmap_linear_ba_xrgb8888 : &g_pixmap_linear_la_xrgb8888;
+    default: break;
+    }
+
+    // not supported, blend it in the srgb color space
+    return gb_pixmap(pixfmt, alpha);
+}
+tb_size_t gb_pixmap_dither_steps(gb_pixmap_ref_t pixmap)
+{
+    // check
+    tb_assert_and_check_return_val(pixmap && pixmap->pixel && pixmap->color, 0);
+
+    // no dithering for the low quality
+    tb_check_return_val(gb_quality() >= GB_QUALITY_MID, 0);
+
+    // only for the 16-bit pixfmts
+    tb_check_return_val(pixmap->bpp == 16, 0);
+
+    /* compute the quantization steps from the truncated white color
+     *
+     * 0xf8 => 8, 0xfc => 4, 0xf0 => 16
+     *
+     * use the opaque pixmap of this pixfmt, the pixel of the blend pixmap is not truncated
+     */
+    gb_pixmap_ref_t opaque = gb_pixmap(pixmap->pixfmt, 0xff);
+    tb_check_return_val(opaque, 0);
+    gb_color_t  color = opaque->color(opaque->pixel(GB_COLOR_WHITE));
+    tb_size_t   r = 0x100 - color.r;
+    tb_size_t   g = 0x100 - color.g;
+    tb_size_t   b = 0x100 - color.b;
+
+    // no truncation? 
+    tb_check_return_val(r > 1 || g > 1 || b > 1, 0);
+
+    // ok
+    return r | (g << 8) | (b << 16);
+}
+gb_color_t gb_pixmap_dither_color(gb_color_t color, tb_size_t steps, tb_long_t x, tb_long_t y)
+{
+    /* the threshold of the bayer matrix: (2 * t + 1) / 32
+     *
+     * the pixel() will truncate the channel, so the average of the dithered pixels is the original color
+     */
+    tb_size_t t = (g_pixmap_dither_bayer[y & 3][x & 3] << 1) + 1;
+    tb_size_t r = color.r + (((steps & 0xff) * t) >> 5);
+    tb_size_t g = color.g + ((((steps >> 8) & 0xff) * t) >> 5);
+    tb_size_t b = color.b + ((((steps >> 16) & 0xff) * t) >> 5);
 
+    // clip it
+    color.r = (tb_byte_t)tb_min(r, 0xff);
+    color.g = (tb_byte_t)tb_min(g, 0xff);
+    color.b = (tb_byte_t)tb_min(b, 0xff);
+
+    // ok
+    return color;
+}
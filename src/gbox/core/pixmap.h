@@ -153,12 +153,63 @@ typedef gb_pixmap_t const*      gb_pixmap_ref_t;
 /*! get the pixmap from the pixel format 
  *
  * @param pixfmt        the pixfmt with endian
- * @param alpha         the alpha value, do blend-alpha operation if (alpha >= GB_ALPHA_MINN && alpha <= GB_ALPHA_MAXN) 
+ * @param alpha         the alpha value, do blend-alpha operation if (alpha >= GB_ALPHA_MINN && !GB_ALPHA_IS_OPAQUE(alpha)) 
  *
  * @return              the pixmap
  */
 gb_pixmap_ref_t 		gb_pixmap(tb_size_t pixfmt, tb_byte_t alpha);
 
+/*! get the pixmap with the given blend mode 
+ *
+ * the pixel of this pixmap is the premultiplied argb32 source which contains the paint alpha,
+ * and the alpha of pixel_set() and pixels_fill() is only the coverage of the pixels.
+ *
+ * the source-over mode is same as gb_pixmap()
+ *
+ * @param pixfmt        the pixfmt with endian
+ * @param blend         the blend mode, see gb_paint_blend_e
+ * @param alpha         the alpha value
+ *
+ * @return              the pixmap, return null if the pixfmt is not supported for this blend mode
+ */
+gb_pixmap_ref_t 		gb_pixmap_blend(tb_size_t pixfmt, tb_size_t blend, tb_byte_t alpha);
+
+/*! get the pixmap which blends in the linear-light color space
+ *
+ * the srgb channels are converted to the 12-bit linear values by the lookup tables, 
+ * blended with the given alpha and converted back to srgb. 
+ *
+ * only for the argb8888 and xrgb8888 pixfmts, the other pixfmts will fall back to gb_pixmap()
+ *
+ * @param pixfmt        the pixfmt with endian
+ * @param alpha         the alpha value
+ *
+ * @return              the pixmap
+ */
+gb_pixmap_ref_t         gb_pixmap_linear(tb_size_t pixfmt, tb_byte_t alpha);
+
+/*! get the dither steps of the pixmap
+ *
+ * the quantization steps of the r, g, b channels for the low-depth pixfmts, e.g. rgb565, argb4444, xrgb1555 ..
+ * only dither it if gb_quality() >= GB_QUALITY_MID
+ *
+ * @param pixmap        the pixmap
+ *
+ * @return              the packed steps: r | (g << 8) | (b << 16), return 0 if no dithering
+ */
+tb_size_t               gb_pixmap_dither_steps(gb_pixmap_ref_t pixmap);
+
+/*! dither the color with the 4x4 bayer matrix
+ *
+ * @param color         the color
+ * @param steps         the dither steps, see gb_pixmap_dither_steps()
+ * @param x             the x-coordinate of the pixel
+ * @param y             the y-coordinate of the pixel
+ *
+ * @return              the dithered color which will be truncated by the pixel() of the pixmap
+ */
+gb_color_t              gb_pixmap_dither_color(gb_color_t color, tb_size_t steps, tb_long_t x, tb_long_t y);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,152 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        a8.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_PIXMAP_A8_H
+#define GB_CORE_PIXMAP_A8_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+// the alpha blend: d + (s - d) * a / 256
+static __tb_inline__ tb_byte_t gb_pixmap_a8_blend(tb_long_t d, tb_long_t s, tb_byte_t a)
+{
+    return (tb_byte_t)(d + (((s - d) * a) >> 8));
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+/* the alpha-only pixel
+ *
+ * only the alpha channel is stored, e.g. the coverage masks, the glyphs and the clip masks
+ */
+static __tb_inline__ gb_pixel_t gb_pixmap_a8_pixel(gb_color_t color)
+{
+    return color.a;
+}
+static __tb_inline__ gb_color_t gb_pixmap_a8_color(gb_pixel_t pixel)
+{
+    gb_color_t color;
+    color.a = (tb_byte_t)pixel;
+    color.r = 0;
+    color.g = 0;
+    color.b = 0;
+    return color;
+}
+static __tb_inline__ gb_pixel_t gb_pixmap_a8_pixel_get(tb_cpointer_t data)
+{
+    return ((tb_byte_t const*)data)[0];
+}
+static __tb_inline__ tb_void_t gb_pixmap_a8_pixel_set_o(tb_pointer_t data, gb_pixel_t pixel, tb_byte_t alpha)
+{
+    ((tb_byte_t*)data)[0] = (tb_byte_t)pixel;
+}
+static __tb_inline__ tb_void_t gb_pixmap_a8_pixel_set_a(tb_pointer_t data, gb_pixel_t pixel, tb_byte_t alpha)
+{
+    ((tb_byte_t*)data)[0] = gb_pixmap_a8_blend(((tb_byte_t*)data)[0], pixel & 0xff, alpha);
+}
+static __tb_inline__ tb_void_t gb_pixmap_a8_pixel_cpy_o(tb_pointer_t data, tb_cpointer_t source, tb_byte_t alpha)
+{
+    ((tb_byte_t*)data)[0] = ((tb_byte_t const*)source)[0];
+}
+static __tb_inline__ tb_void_t gb_pixmap_a8_pixel_cpy_a(tb_pointer_t data, tb_cpointer_t source, tb_byte_t alpha)
+{
+    ((tb_byte_t*)data)[0] = gb_pixmap_a8_blend(((tb_byte_t*)data)[0], ((tb_byte_t const*)source)[0], alpha);
+}
+static __tb_inline__ gb_color_t gb_pixmap_a8_color_get(tb_cpointer_t data)
+{
+    return gb_pixmap_a8_color(((tb_byte_t const*)data)[0]);
+}
+static __tb_inline__ tb_void_t gb_pixmap_a8_color_set_o(tb_pointer_t data, gb_color_t color)
+{
+    ((tb_byte_t*)data)[0] = (tb_byte_t)gb_pixmap_a8_pixel(color);
+}
+static __tb_inline__ tb_void_t gb_pixmap_a8_color_set_a(tb_pointer_t data, gb_color_t color)
+{
+    ((tb_byte_t*)data)[0] = gb_pixmap_a8_blend(((tb_byte_t*)data)[0], gb_pixmap_a8_pixel(color), color.a);
+}
+static __tb_inline__ tb_void_t gb_pixmap_a8_pixels_fill_o(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
+{
+    tb_memset(data, (tb_byte_t)pixel, count);
+}
+static __tb_inline__ tb_void_t gb_pixmap_a8_pixels_fill_a(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
+{
+    // the source value and the alpha
+    tb_long_t   s = pixel & 0xff;
+    tb_long_t   a = alpha;
+
+    // done
+    tb_byte_t*  p = (tb_byte_t*)data;
+    tb_byte_t*  e = p + count;
+    while (p < e) 
+    {
+        *p = (tb_byte_t)(*p + (((s - *p) * a) >> 8));
+        p++;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+static gb_pixmap_t const g_pixmap_o_a8 =
+{   
+    "a8"
+,   8
+,   1
+,   GB_PIXFMT_A8
+,   gb_pixmap_a8_pixel
+,   gb_pixmap_a8_color
+,   gb_pixmap_a8_pixel_get
+,   gb_pixmap_a8_pixel_set_o
+,   gb_pixmap_a8_pixel_cpy_o
+,   gb_pixmap_a8_color_get
+,   gb_pixmap_a8_color_set_o
+,   gb_pixmap_a8_pixels_fill_o
+};
+
+static gb_pixmap_t const g_pixmap_a_a8 =
+{   
+    "a8"
+,   8
+,   1
+,   GB_PIXFMT_A8
+,   gb_pixmap_a8_pixel
+,   gb_pixmap_a8_color
+,   gb_pixmap_a8_pixel_get
+,   gb_pixmap_a8_pixel_set_a
+,   gb_pixmap_a8_pixel_cpy_a
+,   gb_pixmap_a8_color_get
+,   gb_pixmap_a8_color_set_a
+,   gb_pixmap_a8_pixels_fill_a
+};
+
+#endif
@@ -131,7 +131,7 @@ static __tb_inline__ tb_void_t gb_pixmap_argb1555_pixels_fill_la(tb_pointer_t da
     tb_size_t       l = count & 0x3; count -= l; alpha >>= 3;
     tb_uint16_t*    p = (tb_uint16_t*)data;
     tb_uint16_t*    e = p + count;
-    tb_uint32_t     s = (pixel | (pixel << 16)) & 0x41f07c1f;
+    tb_uint32_t     s = (pixel | (pixel << 15)) & 0x41f07c1f;
     while (p < e)
     {
         tb_bits_set_u16_le(&p[0], gb_pixmap_argb1555_blend2(tb_bits_get_u16_le(&p[0]), s, alpha));
@@ -151,7 +151,7 @@ static __tb_inline__ tb_void_t gb_pixmap_argb1555_pixels_fill_ba(tb_pointer_t da
     tb_size_t       l = count & 0x3; count -= l; alpha >>= 3;
     tb_uint16_t*    p = (tb_uint16_t*)data;
     tb_uint16_t*    e = p + count;
-    tb_uint32_t     s = (pixel | (pixel << 16)) & 0x41f07c1f;
+    tb_uint32_t     s = (pixel | (pixel << 15)) & 0x41f07c1f;
     while (p < e)
     {
         tb_bits_set_u16_be(&p[0], gb_pixmap_argb1555_blend2(tb_bits_get_u16_be(&p[0]), s, alpha));
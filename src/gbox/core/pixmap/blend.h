@@ -0,0 +1,380 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        blend.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_PIXMAP_BLEND_H
+#define GB_CORE_PIXMAP_BLEND_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "rgb565.h"
+#include "argb8888.h"
+#include "xrgb8888.h"
+#include "pargb8888.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* define the blend pixmap for the given blend mode and pixfmt
+ *
+ * the blend operations work on the premultiplied argb32 pixels:
+ *
+ * S: the source pixel, the paint alpha and the alpha of the source pixel have been premultiplied into it
+ * D: the destination pixel, the alpha is 0xff if the pixfmt has not alpha
+ * c: the given coverage of this pixel, e.g. the antialiasing coverage
+ *
+ * r = lerp(D, op(S, D), c)
+ *
+ * the coverage cannot be folded into the source like source-over, 
+ * e.g. the uncovered pixels will be cleared by the src-in mode if S * c is used
+ *
+ * so the pixel of this pixmap is the premultiplied argb32 source instead of the pixel of the pixfmt,
+ * and the pixfmt without alpha will store the premultiplied color directly,
+ * the premultiplied pixfmt will load and store the pixels without any conversion
+ *
+ * pixel_cpy() copies the source pixel of the same pixfmt, the given alpha is the paint alpha of the source
+ */
+#define GB_PIXMAP_BLEND_DEFINE(mode, fmt, e, E, bpp, btp, pixfmt, pixel_get) \
+static tb_void_t gb_pixmap_blend_##mode##_##fmt##_pixel_set_##e(tb_pointer_t data, gb_pixel_t pixel, tb_byte_t alpha) \
+{ \
+    tb_uint32_t d = gb_pixmap_blend_##fmt##_load_##e(data); \
+    gb_pixmap_blend_##fmt##_store_##e(data, gb_pixmap_blend_lerp(d, gb_pixmap_blend_op_##mode(pixel, d), alpha)); \
+} \
+static tb_void_t gb_pixmap_blend_##mode##_##fmt##_pixel_cpy_##e(tb_pointer_t data, tb_cpointer_t source, tb_byte_t alpha) \
+{ \
+    tb_uint32_t s = gb_pixmap_blend_##fmt##_load_##e(source); \
+    if (alpha != 0xff) s = gb_pixmap_rgb32_mul4(s, alpha); \
+    gb_pixmap_blend_##fmt##_store_##e(data, gb_pixmap_blend_op_##mode(s, gb_pixmap_blend_##fmt##_load_##e(data))); \
+} \
+static tb_void_t gb_pixmap_blend_##mode##_##fmt##_color_set_##e(tb_pointer_t data, gb_color_t color) \
+{ \
+    gb_pixmap_blend_##fmt##_store_##e(data, gb_pixmap_blend_op_##mode(gb_pixmap_blend_pixel(color), gb_pixmap_blend_##fmt##_load_##e(data))); \
+} \
+static tb_void_t gb_pixmap_blend_##mode##_##fmt##_pixels_fill_##e(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha) \
+{ \
+    tb_byte_t*  p = (tb_byte_t*)data; \
+    tb_uint32_t d = 0; \
+    while (count--) \
+    { \
+        d = gb_pixmap_blend_##fmt##_load_##e(p); \
+        gb_pixmap_blend_##fmt##_store_##e(p, gb_pixmap_blend_lerp(d, gb_pixmap_blend_op_##mode(pixel, d), alpha)); \
+        p += btp; \
+    } \
+} \
+static gb_pixmap_t const g_pixmap_blend_##mode##_##fmt##_##e = \
+{ \
+    #fmt \
+,   bpp \
+,   btp \
+,   pixfmt | E \
+,   gb_pixmap_blend_pixel \
+,   gb_pixmap_blend_color \
+,   pixel_get \
+,   gb_pixmap_blend_##mode##_##fmt##_pixel_set_##e \
+,   gb_pixmap_blend_##mode##_##fmt##_pixel_cpy_##e \
+,   gb_pixmap_##fmt##_color_get_##e \
+,   gb_pixmap_blend_##mode##_##fmt##_color_set_##e \
+,   gb_pixmap_blend_##mode##_##fmt##_pixels_fill_##e \
+};
+
+// define the blend pixmaps of all supported pixfmts for the given blend mode
+#define GB_PIXMAP_BLEND_DEFINE_MODE(mode) \
+    GB_PIXMAP_BLEND_DEFINE(mode, rgb565,    l, 0,                  16, 2, GB_PIXFMT_RGB565,    gb_pixmap_rgb16_pixel_get_l) \
+    GB_PIXMAP_BLEND_DEFINE(mode, rgb565,    b, GB_PIXFMT_BENDIAN,  16, 2, GB_PIXFMT_RGB565,    gb_pixmap_rgb16_pixel_get_b) \
+    GB_PIXMAP_BLEND_DEFINE(mode, argb8888,  l, 0,                  32, 4, GB_PIXFMT_ARGB8888,  gb_pixmap_rgb32_pixel_get_l) \
+    GB_PIXMAP_BLEND_DEFINE(mode, argb8888,  b, GB_PIXFMT_BENDIAN,  32, 4, GB_PIXFMT_ARGB8888,  gb_pixmap_rgb32_pixel_get_b) \
+    GB_PIXMAP_BLEND_DEFINE(mode, xrgb8888,  l, 0,                  32, 4, GB_PIXFMT_XRGB8888,  gb_pixmap_rgb32_pixel_get_l) \
+    GB_PIXMAP_BLEND_DEFINE(mode, xrgb8888,  b, GB_PIXFMT_BENDIAN,  32, 4, GB_PIXFMT_XRGB8888,  gb_pixmap_rgb32_pixel_get_b) \
+    GB_PIXMAP_BLEND_DEFINE(mode, pargb8888, l, 0,                  32, 4, GB_PIXFMT_PARGB8888, gb_pixmap_rgb32_pixel_get_l) \
+    GB_PIXMAP_BLEND_DEFINE(mode, pargb8888, b, GB_PIXFMT_BENDIAN,  32, 4, GB_PIXFMT_PARGB8888, gb_pixmap_rgb32_pixel_get_b)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+// a * b / 255 for the single channel
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_mul(tb_uint32_t a, tb_uint32_t b)
+{
+    tb_uint32_t t = a * b + 0x80;
+    return (t + (t >> 8)) >> 8;
+}
+
+// min(a + b, 255) for all channels
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_adds(tb_uint32_t a, tb_uint32_t b)
+{
+    tb_uint32_t l = (a & 0x00ff00ff) + (b & 0x00ff00ff);
+    tb_uint32_t h = ((a >> 8) & 0x00ff00ff) + ((b >> 8) & 0x00ff00ff);
+    l = (l | (0x01000100 - ((l >> 8) & 0x00010001))) & 0x00ff00ff;
+    h = (h | (0x01000100 - ((h >> 8) & 0x00010001))) & 0x00ff00ff;
+    return (h << 8) | l;
+}
+
+// the premultiplied argb32 source of the color
+static __tb_inline__ gb_pixel_t gb_pixmap_blend_pixel(gb_color_t color)
+{
+    return gb_pixmap_rgb32_premul(gb_color_pixel(color), color.a);
+}
+
+// the color of the premultiplied argb32 source
+static __tb_inline__ gb_color_t gb_pixmap_blend_color(gb_pixel_t pixel)
+{
+    return gb_pixel_color(gb_pixmap_rgb32_unpremul(pixel));
+}
+
+/* lerp(d, r, a) = r * a + d * (1 - a) for all channels
+ *
+ * @param d     the premultiplied destination pixel
+ * @param r     the premultiplied blended pixel
+ * @param a     the coverage
+ *
+ * @return      the premultiplied result pixel
+ */
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_lerp(tb_uint32_t d, tb_uint32_t r, tb_uint32_t a)
+{
+    // full coverage?
+    if (a == 0xff) return r;
+
+    // no coverage?
+    if (!a) return d;
+
+    // done
+    return gb_pixmap_rgb32_mul4(r, a) + gb_pixmap_rgb32_mul4(d, 0xff - a);
+}
+
+/* the blend operations: r = S * Fa + D * Fb
+ *
+ * @param s     the premultiplied source pixel
+ * @param d     the premultiplied destination pixel
+ *
+ * @return      the premultiplied result pixel
+ */
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_clear(tb_uint32_t s, tb_uint32_t d)
+{
+    return 0;
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_src(tb_uint32_t s, tb_uint32_t d)
+{
+    return s;
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_dst(tb_uint32_t s, tb_uint32_t d)
+{
+    return d;
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_src_over(tb_uint32_t s, tb_uint32_t d)
+{
+    return s + gb_pixmap_rgb32_mul4(d, 0xff - (s >> 24));
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_dst_over(tb_uint32_t s, tb_uint32_t d)
+{
+    return d + gb_pixmap_rgb32_mul4(s, 0xff - (d >> 24));
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_src_in(tb_uint32_t s, tb_uint32_t d)
+{
+    return gb_pixmap_rgb32_mul4(s, d >> 24);
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_dst_in(tb_uint32_t s, tb_uint32_t d)
+{
+    return gb_pixmap_rgb32_mul4(d, s >> 24);
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_src_out(tb_uint32_t s, tb_uint32_t d)
+{
+    return gb_pixmap_rgb32_mul4(s, 0xff - (d >> 24));
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_dst_out(tb_uint32_t s, tb_uint32_t d)
+{
+    return gb_pixmap_rgb32_mul4(d, 0xff - (s >> 24));
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_src_atop(tb_uint32_t s, tb_uint32_t d)
+{
+    return gb_pixmap_rgb32_mul4(s, d >> 24) + gb_pixmap_rgb32_mul4(d, 0xff - (s >> 24));
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_dst_atop(tb_uint32_t s, tb_uint32_t d)
+{
+    return gb_pixmap_rgb32_mul4(d, s >> 24) + gb_pixmap_rgb32_mul4(s, 0xff - (d >> 24));
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_xor(tb_uint32_t s, tb_uint32_t d)
+{
+    return gb_pixmap_rgb32_mul4(s, 0xff - (d >> 24)) + gb_pixmap_rgb32_mul4(d, 0xff - (s >> 24));
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_plus(tb_uint32_t s, tb_uint32_t d)
+{
+    return gb_pixmap_blend_adds(s, d);
+}
+
+/* the separable blend operations: r = S * (1 - da) + D * (1 - sa) + B(S, D)
+ *
+ * the alpha channel is also computed by this formula: ra = sa + da - sa * da
+ */
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_multiply(tb_uint32_t s, tb_uint32_t d)
+{
+    // S * (1 - da) + D * (1 - sa) + S * D
+    tb_uint32_t sa = s >> 24;
+    tb_uint32_t da = d >> 24;
+    tb_uint32_t r = (sa + da - gb_pixmap_blend_mul(sa, da)) << 24;
+    tb_size_t   i = 0;
+    for (i = 0; i < 24; i += 8)
+    {
+        tb_uint32_t sc = (s >> i) & 0xff;
+        tb_uint32_t dc = (d >> i) & 0xff;
+        r |= tb_min(gb_pixmap_blend_mul(sc, 0xff - da) + gb_pixmap_blend_mul(dc, 0xff - sa) + gb_pixmap_blend_mul(sc, dc), 0xff) << i;
+    }
+    return r;
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_screen(tb_uint32_t s, tb_uint32_t d)
+{
+    // S + D - S * D = S + D * (1 - S)
+    tb_uint32_t r = s;
+    r += gb_pixmap_blend_mul(d >> 24, 0xff - (s >> 24)) << 24;
+    r += gb_pixmap_blend_mul((d >> 16) & 0xff, 0xff - ((s >> 16) & 0xff)) << 16;
+    r += gb_pixmap_blend_mul((d >> 8) & 0xff, 0xff - ((s >> 8) & 0xff)) << 8;
+    r += gb_pixmap_blend_mul(d & 0xff, 0xff - (s & 0xff));
+    return r;
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_darken(tb_uint32_t s, tb_uint32_t d)
+{
+    // S + D - max(S * da, D * sa)
+    tb_uint32_t sa = s >> 24;
+    tb_uint32_t da = d >> 24;
+    tb_uint32_t r = (sa + da - gb_pixmap_blend_mul(sa, da)) << 24;
+    tb_size_t   i = 0;
+    for (i = 0; i < 24; i += 8)
+    {
+        tb_uint32_t sc = (s >> i) & 0xff;
+        tb_uint32_t dc = (d >> i) & 0xff;
+        r |= tb_min(sc + dc - tb_max(gb_pixmap_blend_mul(sc, da), gb_pixmap_blend_mul(dc, sa)), 0xff) << i;
+    }
+    return r;
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_op_lighten(tb_uint32_t s, tb_uint32_t d)
+{
+    // S + D - min(S * da, D * sa)
+    tb_uint32_t sa = s >> 24;
+    tb_uint32_t da = d >> 24;
+    tb_uint32_t r = (sa + da - gb_pixmap_blend_mul(sa, da)) << 24;
+    tb_size_t   i = 0;
+    for (i = 0; i < 24; i += 8)
+    {
+        tb_uint32_t sc = (s >> i) & 0xff;
+        tb_uint32_t dc = (d >> i) & 0xff;
+        r |= tb_min(sc + dc - tb_min(gb_pixmap_blend_mul(sc, da), gb_pixmap_blend_mul(dc, sa)), 0xff) << i;
+    }
+    return r;
+}
+
+/* the pixfmt operations
+ *
+ * load:    load the premultiplied argb32 pixel from data
+ * store:   store the premultiplied argb32 pixel to data
+ */
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_rgb565_load_l(tb_cpointer_t data)
+{
+    return gb_color_pixel(gb_pixmap_rgb565_color(tb_bits_get_u16_le(data)));
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_rgb565_load_b(tb_cpointer_t data)
+{
+    return gb_color_pixel(gb_pixmap_rgb565_color(tb_bits_get_u16_be(data)));
+}
+static __tb_inline__ tb_void_t gb_pixmap_blend_rgb565_store_l(tb_pointer_t data, tb_uint32_t p)
+{
+    tb_bits_set_u16_le(data, GB_RGB_565((p >> 16) & 0xff, (p >> 8) & 0xff, p & 0xff));
+}
+static __tb_inline__ tb_void_t gb_pixmap_blend_rgb565_store_b(tb_pointer_t data, tb_uint32_t p)
+{
+    tb_bits_set_u16_be(data, GB_RGB_565((p >> 16) & 0xff, (p >> 8) & 0xff, p & 0xff));
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_argb8888_load_l(tb_cpointer_t data)
+{
+    tb_uint32_t p = tb_bits_get_u32_le(data);
+    return gb_pixmap_rgb32_premul(p, p >> 24);
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_argb8888_load_b(tb_cpointer_t data)
+{
+    tb_uint32_t p = tb_bits_get_u32_be(data);
+    return gb_pixmap_rgb32_premul(p, p >> 24);
+}
+static __tb_inline__ tb_void_t gb_pixmap_blend_argb8888_store_l(tb_pointer_t data, tb_uint32_t p)
+{
+    tb_bits_set_u32_le(data, gb_pixmap_rgb32_unpremul(p));
+}
+static __tb_inline__ tb_void_t gb_pixmap_blend_argb8888_store_b(tb_pointer_t data, tb_uint32_t p)
+{
+    tb_bits_set_u32_be(data, gb_pixmap_rgb32_unpremul(p));
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_xrgb8888_load_l(tb_cpointer_t data)
+{
+    return tb_bits_get_u32_le(data) | 0xff000000;
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_xrgb8888_load_b(tb_cpointer_t data)
+{
+    return tb_bits_get_u32_be(data) | 0xff000000;
+}
+static __tb_inline__ tb_void_t gb_pixmap_blend_xrgb8888_store_l(tb_pointer_t data, tb_uint32_t p)
+{
+    tb_bits_set_u32_le(data, p | 0xff000000);
+}
+static __tb_inline__ tb_void_t gb_pixmap_blend_xrgb8888_store_b(tb_pointer_t data, tb_uint32_t p)
+{
+    tb_bits_set_u32_be(data, p | 0xff000000);
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_pargb8888_load_l(tb_cpointer_t data)
+{
+    return tb_bits_get_u32_le(data);
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_blend_pargb8888_load_b(tb_cpointer_t data)
+{
+    return tb_bits_get_u32_be(data);
+}
+static __tb_inline__ tb_void_t gb_pixmap_blend_pargb8888_store_l(tb_pointer_t data, tb_uint32_t p)
+{
+    tb_bits_set_u32_le(data, p);
+}
+static __tb_inline__ tb_void_t gb_pixmap_blend_pargb8888_store_b(tb_pointer_t data, tb_uint32_t p)
+{
+    tb_bits_set_u32_be(data, p);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+GB_PIXMAP_BLEND_DEFINE_MODE(clear)
+GB_PIXMAP_BLEND_DEFINE_MODE(src)
+GB_PIXMAP_BLEND_DEFINE_MODE(dst)
+GB_PIXMAP_BLEND_DEFINE_MODE(dst_over)
+GB_PIXMAP_BLEND_DEFINE_MODE(src_in)
+GB_PIXMAP_BLEND_DEFINE_MODE(dst_in)
+GB_PIXMAP_BLEND_DEFINE_MODE(src_out)
+GB_PIXMAP_BLEND_DEFINE_MODE(dst_out)
+GB_PIXMAP_BLEND_DEFINE_MODE(src_atop)
+GB_PIXMAP_BLEND_DEFINE_MODE(dst_atop)
+GB_PIXMAP_BLEND_DEFINE_MODE(xor)
+GB_PIXMAP_BLEND_DEFINE_MODE(plus)
+GB_PIXMAP_BLEND_DEFINE_MODE(multiply)
+GB_PIXMAP_BLEND_DEFINE_MODE(screen)
+GB_PIXMAP_BLEND_DEFINE_MODE(darken)
+GB_PIXMAP_BLEND_DEFINE_MODE(lighten)
+
+#endif
@@ -0,0 +1,179 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        fill.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_PIXMAP_FILL_H
+#define GB_CORE_PIXMAP_FILL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the minimum bytes for filling pixels with the streaming stores
+ *
+ * the filled pixels larger than the cache will only evict the other data,
+ * so bypass the cache for clearing the whole large surface
+ */
+#define GB_PIXMAP_FILL_STREAM_MINN          (1 << 21)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef TB_ARCH_SSE2
+static __tb_inline__ tb_void_t gb_pixmap_fill_u32_sse2(tb_uint32_t* data, tb_uint32_t pixel, tb_size_t count)
+{
+    // align data to 16-bytes
+    while (((tb_size_t)data & 15) && count)
+    {
+        *data++ = pixel;
+        count--;
+    }
+
+    // fill 64-bytes for each loop
+    __m128i     p = _mm_set1_epi32((tb_int_t)pixel);
+    __m128i*    d = (__m128i*)data;
+    tb_size_t   n = count >> 4;
+    if ((count << 2) >= GB_PIXMAP_FILL_STREAM_MINN)
+    {
+        // fill it with the streaming stores
+        while (n--)
+        {
+            _mm_stream_si128(d + 0, p);
+            _mm_stream_si128(d + 1, p);
+            _mm_stream_si128(d + 2, p);
+            _mm_stream_si128(d + 3, p);
+            d += 4;
+        }
+
+        // make the streaming stores visible before the next draws
+        _mm_sfence();
+    }
+    else
+    {
+        while (n--)
+        {
+            _mm_store_si128(d + 0, p);
+            _mm_store_si128(d + 1, p);
+            _mm_store_si128(d + 2, p);
+            _mm_store_si128(d + 3, p);
+            d += 4;
+        }
+    }
+
+    // fill the left pixels
+    data = (tb_uint32_t*)d;
+    count &= 15;
+    while (count--) *data++ = pixel;
+}
+#else
+static __tb_inline__ tb_void_t gb_pixmap_fill_u32_u64(tb_uint32_t* data, tb_uint32_t pixel, tb_size_t count)
+{
+    // align data to 8-bytes
+    if (((tb_size_t)data & 7) && count)
+    {
+        *data++ = pixel;
+        count--;
+    }
+
+    // fill 32-bytes for each loop
+    tb_uint64_t     p = ((tb_uint64_t)pixel << 32) | pixel;
+    tb_uint64_t*    d = (tb_uint64_t*)data;
+    tb_size_t       n = count >> 3;
+    while (n--)
+    {
+        d[0] = p;
+        d[1] = p;
+        d[2] = p;
+        d[3] = p;
+        d += 4;
+    }
+
+    // fill the left pixels
+    data = (tb_uint32_t*)d;
+    count &= 7;
+    while (count--) *data++ = pixel;
+}
+#endif
+
+/* fill the 32-bits pixels 
+ *
+ * @param data      the data, must be aligned to 4-bytes
+ * @param pixel     the pixel with the stored byte order
+ * @param count     the pixels count
+ */
+static __tb_inline__ tb_void_t gb_pixmap_fill_u32(tb_pointer_t data, tb_uint32_t pixel, tb_size_t count)
+{
+    // check
+    tb_assert(!((tb_size_t)data & 3));
+
+    // all bytes are same? fill bytes directly, .e.g black and white
+    if ((pixel & 0xff) * 0x01010101 == pixel) 
+    {
+        tb_memset(data, (tb_byte_t)pixel, count << 2);
+        return ;
+    }
+
+    // fill it
+#ifdef TB_ARCH_SSE2
+    gb_pixmap_fill_u32_sse2((tb_uint32_t*)data, pixel, count);
+#else
+    gb_pixmap_fill_u32_u64((tb_uint32_t*)data, pixel, count);
+#endif
+}
+
+/* fill the 16-bits pixels with the repeated 32-bits pattern
+ *
+ * @param data      the data, must be aligned to 2-bytes
+ * @param pixel     the pixel with the stored byte order
+ * @param count     the pixels count
+ */
+static __tb_inline__ tb_void_t gb_pixmap_fill_u16(tb_pointer_t data, tb_uint16_t pixel, tb_size_t count)
+{
+    // check
+    tb_assert(!((tb_size_t)data & 1));
+
+    // align data to 4-bytes
+    tb_uint16_t* d = (tb_uint16_t*)data;
+    if (((tb_size_t)d & 3) && count)
+    {
+        *d++ = pixel;
+        count--;
+    }
+
+    // fill the pixel pairs
+    gb_pixmap_fill_u32(d, ((tb_uint32_t)pixel << 16) | pixel, count >> 1);
+
+    // fill the last pixel
+    if (count & 1) d[count - 1] = pixel;
+}
+
+#endif
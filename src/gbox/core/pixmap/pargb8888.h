@@ -0,0 +1,244 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        pargb8888.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_PIXMAP_PARGB8888_H
+#define GB_CORE_PIXMAP_PARGB8888_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "rgb32.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/* the source-over operation for the premultiplied pixels: d = s + d * (1 - sa)
+ *
+ * s + d * (256 - sa) >> 8 will not overflow because s <= sa for all channels
+ */
+static __tb_inline__ tb_uint32_t gb_pixmap_pargb8888_over(tb_uint32_t d, tb_uint32_t s, tb_uint32_t f)
+{
+    tb_uint32_t hd = (((d >> 8) & 0x00ff00ff) * f) & 0xff00ff00;
+    tb_uint32_t ld = (((d & 0x00ff00ff) * f) >> 8) & 0x00ff00ff;
+    return s + (hd | ld);
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_pargb8888_blend(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
+{
+    // s *= a
+    s = gb_pixmap_rgb32_mul4(s, a);
+
+    // s + d * (1 - sa)
+    return gb_pixmap_pargb8888_over(d, s, 0x100 - (s >> 24));
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static __tb_inline__ gb_pixel_t gb_pixmap_pargb8888_pixel(gb_color_t color)
+{
+    return gb_pixmap_rgb32_premul(gb_color_pixel(color), color.a);
+}
+static __tb_inline__ gb_color_t gb_pixmap_pargb8888_color(gb_pixel_t pixel)
+{
+    return gb_pixel_color(gb_pixmap_rgb32_unpremul(pixel));
+}
+static __tb_inline__ tb_void_t gb_pixmap_pargb8888_pixel_set_la(tb_pointer_t data, gb_pixel_t pixel, tb_byte_t alpha)
+{
+    tb_bits_set_u32_le(data, gb_pixmap_pargb8888_blend(tb_bits_get_u32_le(data), pixel, alpha));
+}
+static __tb_inline__ tb_void_t gb_pixmap_pargb8888_pixel_set_ba(tb_pointer_t data, gb_pixel_t pixel, tb_byte_t alpha)
+{
+    tb_bits_set_u32_be(data, gb_pixmap_pargb8888_blend(tb_bits_get_u32_be(data), pixel, alpha));
+}
+static __tb_inline__ tb_void_t gb_pixmap_pargb8888_pixel_cpy_la(tb_pointer_t data, tb_cpointer_t source, tb_byte_t alpha)
+{
+    tb_bits_set_u32_le(data, gb_pixmap_pargb8888_blend(tb_bits_get_u32_le(data), tb_bits_get_u32_le(source), alpha));
+}
+static __tb_inline__ tb_void_t gb_pixmap_pargb8888_pixel_cpy_ba(tb_pointer_t data, tb_cpointer_t source, tb_byte_t alpha)
+{
+    tb_bits_set_u32_be(data, gb_pixmap_pargb8888_blend(tb_bits_get_u32_be(data), tb_bits_get_u32_be(source), alpha));
+}
+static __tb_inline__ tb_void_t gb_pixmap_pargb8888_color_set_lo(tb_pointer_t data, gb_color_t color)
+{
+    tb_bits_set_u32_le(data, gb_pixmap_pargb8888_pixel(color));
+}
+static __tb_inline__ tb_void_t gb_pixmap_pargb8888_color_set_bo(tb_pointer_t data, gb_color_t color)
+{
+    tb_bits_set_u32_be(data, gb_pixmap_pargb8888_pixel(color));
+}
+static __tb_inline__ tb_void_t gb_pixmap_pargb8888_color_set_la(tb_pointer_t data, gb_color_t color)
+{
+    tb_uint32_t s = gb_pixmap_pargb8888_pixel(color);
+    tb_bits_set_u32_le(data, gb_pixmap_pargb8888_over(tb_bits_get_u32_le(data), s, 0x100 - color.a));
+}
+static __tb_inline__ tb_void_t gb_pixmap_pargb8888_color_set_ba(tb_pointer_t data, gb_color_t color)
+{
+    tb_uint32_t s = gb_pixmap_pargb8888_pixel(color);
+    tb_bits_set_u32_be(data, gb_pixmap_pargb8888_over(tb_bits_get_u32_be(data), s, 0x100 - color.a));
+}
+static __tb_inline__ gb_color_t gb_pixmap_pargb8888_color_get_l(tb_cpointer_t data)
+{
+    return gb_pixmap_pargb8888_color(tb_bits_get_u32_le(data));
+}
+static __tb_inline__ gb_color_t gb_pixmap_pargb8888_color_get_b(tb_cpointer_t data)
+{
+    return gb_pixmap_pargb8888_color(tb_bits_get_u32_be(data));
+}
+static __tb_inline__ tb_void_t gb_pixmap_pargb8888_pixels_fill_la(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
+{
+    // s *= a
+    tb_uint32_t s = gb_pixmap_rgb32_mul4(pixel, alpha);
+
+    // opaque now? fill it directly
+    if ((s >> 24) == 0xff) 
+    {
+        gb_pixmap_fill_u32(data, tb_bits_ne_to_le_u32(s), count);
+        return ;
+    }
+
+    // done
+    tb_size_t       l = count & 0x3; count -= l;
+    tb_uint32_t*    p = (tb_uint32_t*)data;
+    tb_uint32_t*    e = p + count;
+    tb_uint32_t     f = 0x100 - (s >> 24);
+    while (p < e)
+    {
+        tb_bits_set_u32_le(&p[0], gb_pixmap_pargb8888_over(tb_bits_get_u32_le(&p[0]), s, f));
+        tb_bits_set_u32_le(&p[1], gb_pixmap_pargb8888_over(tb_bits_get_u32_le(&p[1]), s, f));
+        tb_bits_set_u32_le(&p[2], gb_pixmap_pargb8888_over(tb_bits_get_u32_le(&p[2]), s, f));
+        tb_bits_set_u32_le(&p[3], gb_pixmap_pargb8888_over(tb_bits_get_u32_le(&p[3]), s, f));
+        p += 4;
+    }
+    while (l--)
+    {
+        tb_bits_set_u32_le(&p[0], gb_pixmap_pargb8888_over(tb_bits_get_u32_le(&p[0]), s, f));
+        p++;
+    }
+}
+static __tb_inline__ tb_void_t gb_pixmap_pargb8888_pixels_fill_ba(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
+{
+    // s *= a
+    tb_uint32_t s = gb_pixmap_rgb32_mul4(pixel, alpha);
+
+    // opaque now? fill it directly
+    if ((s >> 24) == 0xff) 
+    {
+        gb_pixmap_fill_u32(data, tb_bits_ne_to_be_u32(s), count);
+        return ;
+    }
+
+    // done
+    tb_size_t       l = count & 0x3; count -= l;
+    tb_uint32_t*    p = (tb_uint32_t*)data;
+    tb_uint32_t*    e = p + count;
+    tb_uint32_t     f = 0x100 - (s >> 24);
+    while (p < e)
+    {
+        tb_bits_set_u32_be(&p[0], gb_pixmap_pargb8888_over(tb_bits_get_u32_be(&p[0]), s, f));
+        tb_bits_set_u32_be(&p[1], gb_pixmap_pargb8888_over(tb_bits_get_u32_be(&p[1]), s, f));
+        tb_bits_set_u32_be(&p[2], gb_pixmap_pargb8888_over(tb_bits_get_u32_be(&p[2]), s, f));
+        tb_bits_set_u32_be(&p[3], gb_pixmap_pargb8888_over(tb_bits_get_u32_be(&p[3]), s, f));
+        p += 4;
+    }
+    while (l--)
+    {
+        tb_bits_set_u32_be(&p[0], gb_pixmap_pargb8888_over(tb_bits_get_u32_be(&p[0]), s, f));
+        p++;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+static gb_pixmap_t const g_pixmap_lo_pargb8888 =
+{   
+    "pargb8888"
+,   32
+,   4
+,   GB_PIXFMT_PARGB8888 
+,   gb_pixmap_pargb8888_pixel
+,   gb_pixmap_pargb8888_color
+,   gb_pixmap_rgb32_pixel_get_l
+,   gb_pixmap_rgb32_pixel_set_lo
+,   gb_pixmap_rgb32_pixel_cpy_o
+,   gb_pixmap_pargb8888_color_get_l
+,   gb_pixmap_pargb8888_color_set_lo
+,   gb_pixmap_rgb32_pixels_fill_lo
+};
+
+static gb_pixmap_t const g_pixmap_bo_pargb8888 =
+{   
+    "pargb8888"
+,   32
+,   4
+,   GB_PIXFMT_PARGB8888 | GB_PIXFMT_BENDIAN
+,   gb_pixmap_pargb8888_pixel
+,   gb_pixmap_pargb8888_color
+,   gb_pixmap_rgb32_pixel_get_b
+,   gb_pixmap_rgb32_pixel_set_bo
+,   gb_pixmap_rgb32_pixel_cpy_o
+,   gb_pixmap_pargb8888_color_get_b
+,   gb_pixmap_pargb8888_color_set_bo
+,   gb_pixmap_rgb32_pixels_fill_bo
+};
+
+static gb_pixmap_t const g_pixmap_la_pargb8888 =
+{   
+    "pargb8888"
+,   32
+,   4
+,   GB_PIXFMT_PARGB8888 
+,   gb_pixmap_pargb8888_pixel
+,   gb_pixmap_pargb8888_color
+,   gb_pixmap_rgb32_pixel_get_l
+,   gb_pixmap_pargb8888_pixel_set_la
+,   gb_pixmap_pargb8888_pixel_cpy_la
+,   gb_pixmap_pargb8888_color_get_l
+,   gb_pixmap_pargb8888_color_set_la
+,   gb_pixmap_pargb8888_pixels_fill_la
+};
+
+static gb_pixmap_t const g_pixmap_ba_pargb8888 =
+{   
+    "pargb8888"
+,   32
+,   4
+,   GB_PIXFMT_PARGB8888 | GB_PIXFMT_BENDIAN
+,   gb_pixmap_pargb8888_pixel
+,   gb_pixmap_pargb8888_color
+,   gb_pixmap_rgb32_pixel_get_b
+,   gb_pixmap_pargb8888_pixel_set_ba
+,   gb_pixmap_pargb8888_pixel_cpy_ba
+,   gb_pixmap_pargb8888_color_get_b
+,   gb_pixmap_pargb8888_color_set_ba
+,   gb_pixmap_pargb8888_pixels_fill_ba
+};
+
+
+#endif
+
@@ -30,6 +30,7 @@
  * includes
  */
 #include "prefix.h"
+#include "fill.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -56,11 +57,11 @@ static __tb_inline__ tb_void_t gb_pixmap_rgb16_pixel_cpy_o(tb_pointer_t data, tb
 }
 static __tb_inline__ tb_void_t gb_pixmap_rgb16_pixels_fill_lo(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
 {
-    tb_memset_u16(data, tb_bits_ne_to_le_u16(pixel), count);
+    gb_pixmap_fill_u16(data, tb_bits_ne_to_le_u16(pixel), count);
 }
 static __tb_inline__ tb_void_t gb_pixmap_rgb16_pixels_fill_bo(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
 {
-    tb_memset_u16(data, tb_bits_ne_to_be_u16(pixel), count);
+    gb_pixmap_fill_u16(data, tb_bits_ne_to_be_u16(pixel), count);
 }
 
 
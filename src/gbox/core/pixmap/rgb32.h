@@ -30,11 +30,44 @@
  * includes
  */
 #include "prefix.h"
+#include "fill.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
  */
 
+// p * f / 255 for all channels
+static __tb_inline__ tb_uint32_t gb_pixmap_rgb32_mul4(tb_uint32_t p, tb_uint32_t f)
+{
+    tb_uint32_t l = (p & 0x00ff00ff) * f + 0x00800080;
+    tb_uint32_t h = ((p >> 8) & 0x00ff00ff) * f + 0x00800080;
+    l = ((l + ((l >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    h = (h + ((h >> 8) & 0x00ff00ff)) & 0xff00ff00;
+    return h | l;
+}
+
+// premultiply the rgb of the argb32 pixel with the given alpha 
+static __tb_inline__ tb_uint32_t gb_pixmap_rgb32_premul(tb_uint32_t p, tb_uint32_t a)
+{
+    return (gb_pixmap_rgb32_mul4(p, a) & 0x00ffffff) | (a << 24);
+}
+
+// unpremultiply the argb32 pixel
+static __tb_inline__ tb_uint32_t gb_pixmap_rgb32_unpremul(tb_uint32_t p)
+{
+    // opaque or transparent?
+    tb_uint32_t a = p >> 24;
+    if (a == 0xff) return p;
+    else if (!a) return 0;
+
+    // c * 255 / a
+    tb_uint32_t s = (0xff << 16) / a;
+    tb_uint32_t r = tb_min(((((p >> 16) & 0xff) * s) + 0x8000) >> 16, 0xff);
+    tb_uint32_t g = tb_min(((((p >> 8) & 0xff) * s) + 0x8000) >> 16, 0xff);
+    tb_uint32_t b = tb_min((((p & 0xff) * s) + 0x8000) >> 16, 0xff);
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
 static __tb_inline__ tb_uint32_t gb_pixmap_rgb32_blend(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
 {
     tb_uint32_t hs = (s >> 8) & 0x00ff00ff;
@@ -87,11 +120,11 @@ static __tb_inline__ tb_void_t gb_pixmap_rgb32_pixel_cpy_o(tb_pointer_t data, tb
 }
 static __tb_inline__ tb_void_t gb_pixmap_rgb32_pixels_fill_lo(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
 {
-    tb_memset_u32(data, tb_bits_ne_to_le_u32(pixel), count);
+    gb_pixmap_fill_u32(data, tb_bits_ne_to_le_u32(pixel), count);
 }
 static __tb_inline__ tb_void_t gb_pixmap_rgb32_pixels_fill_bo(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
 {
-    tb_memset_u32(data, tb_bits_ne_to_be_u32(pixel), count);
+    gb_pixmap_fill_u32(data, tb_bits_ne_to_be_u32(pixel), count);
 }
 
 
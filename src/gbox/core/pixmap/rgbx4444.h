@@ -53,20 +53,22 @@
  * (d & 0xffff) | (d >> 16):
  * 0000 0000 0000 0000 0000 rrrr gggg bbbb
  *
- * (s * a + d * (32 - a)) >> 5 => ((s - d) * a) >> 5 + d
+ * the 4-bit alpha for the 4-bit gaps between the channels
+ *
+ * (s * a + d * (16 - a)) >> 4 => ((s - d) * a) >> 4 + d
  */
 static __tb_inline__ tb_uint16_t gb_pixmap_rgbx4444_blend(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
 {
     // FIXME: s - d? overflow?
     s = (s | (s << 16)) & 0x0f00f0f0;
     d = (d | (d << 16)) & 0x0f00f0f0;
-    d = ((((s - d) * a) >> 5) + d) & 0x0f00f0f0;
+    d = ((((s - d) * (a >> 1)) >> 4) + d) & 0x0f00f0f0;
     return (tb_uint16_t)((d & 0xffff) | (d >> 16) | 0x000f);
 }
 static __tb_inline__ tb_uint16_t gb_pixmap_rgbx4444_blend2(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
 {
     d = (d | (d << 16)) & 0x0f00f0f0;
-    d = ((((s - d) * a) >> 5) + d) & 0x0f00f0f0;
+    d = ((((s - d) * (a >> 1)) >> 4) + d) & 0x0f00f0f0;
     return (tb_uint16_t)((d & 0xffff) | (d >> 16) | 0x000f);
 }
 
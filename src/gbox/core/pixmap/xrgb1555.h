@@ -58,15 +58,15 @@
 static __tb_inline__ tb_uint16_t gb_pixmap_xrgb1555_blend(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
 {
     // FIXME: s - d? overflow?
-    s = (s | (s << 15)) & 0x3e07c1f;
-    d = (d | (d << 15)) & 0x3e07c1f;
-    d = ((((s - d) * a) >> 5) + d) & 0x3e07c1f;
+    s = (s | (s << 15)) & 0x1f07c1f;
+    d = (d | (d << 15)) & 0x1f07c1f;
+    d = ((((s - d) * a) >> 5) + d) & 0x1f07c1f;
     return (tb_uint16_t)((d & 0xffff) | (d >> 15) | 0x8000);
 }
 static __tb_inline__ tb_uint16_t gb_pixmap_xrgb1555_blend2(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
 {
-    d = (d | (d << 15)) & 0x3e07c1f;
-    d = ((((s - d) * a) >> 5) + d) & 0x3e07c1f;
+    d = (d | (d << 15)) & 0x1f07c1f;
+    d = ((((s - d) * a) >> 5) + d) & 0x1f07c1f;
     return (tb_uint16_t)((d & 0xffff) | (d >> 15) | 0x8000);
 }
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -130,7 +130,7 @@ static __tb_inline__ tb_void_t gb_pixmap_xrgb1555_pixels_fill_la(tb_pointer_t da
     tb_size_t       l = count & 0x3; count -= l; alpha >>= 3;
     tb_uint16_t*    p = (tb_uint16_t*)data;
     tb_uint16_t*    e = p + count;
-    tb_uint32_t     s = (pixel | (pixel << 16)) & 0x3e07c1f;
+    tb_uint32_t     s = (pixel | (pixel << 15)) & 0x1f07c1f;
     while (p < e)
     {
         tb_bits_set_u16_le(&p[0], gb_pixmap_xrgb1555_blend2(tb_bits_get_u16_le(&p[0]), s, alpha));
@@ -150,7 +150,7 @@ static __tb_inline__ tb_void_t gb_pixmap_xrgb1555_pixels_fill_ba(tb_pointer_t da
     tb_size_t       l = count & 0x3; count -= l; alpha >>= 3;
     tb_uint16_t*    p = (tb_uint16_t*)data;
     tb_uint16_t*    e = p + count;
-    tb_uint32_t     s = (pixel | (pixel << 16)) & 0x3e07c1f;
+    tb_uint32_t     s = (pixel | (pixel << 15)) & 0x1f07c1f;
     while (p < e)
     {
         tb_bits_set_u16_be(&p[0], gb_pixmap_xrgb1555_blend2(tb_bits_get_u16_be(&p[0]), s, alpha));
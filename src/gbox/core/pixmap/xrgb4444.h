@@ -53,20 +53,22 @@
  * (d & 0xffff) | (d >> 12):
  * 0000 0000 0000 0000 0000 rrrr gggg bbbb
  *
- * (s * a + d * (32 - a)) >> 5 => ((s - d) * a) >> 5 + d
+ * the 4-bit alpha for the 4-bit gaps between the channels
+ *
+ * (s * a + d * (16 - a)) >> 4 => ((s - d) * a) >> 4 + d
  */
 static __tb_inline__ tb_uint16_t gb_pixmap_xrgb4444_blend(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
 {
 	// FIXME: s - d? overflow?
 	s = (s | (s << 12)) & 0x000f0f0f;
 	d = (d | (d << 12)) & 0x000f0f0f;
-	d = ((((s - d) * a) >> 5) + d) & 0x000f0f0f;
+	d = ((((s - d) * (a >> 1)) >> 4) + d) & 0x000f0f0f;
 	return (tb_uint16_t)((d & 0xffff) | (d >> 12) | 0xf000);
 }
 static __tb_inline__ tb_uint16_t gb_pixmap_xrgb4444_blend2(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
 {
-	d = (d | (d << 16)) & 0x000f0f0f;
-	d = ((((s - d) * a) >> 5) + d) & 0x000f0f0f;
+	d = (d | (d << 12)) & 0x000f0f0f;
+	d = ((((s - d) * (a >> 1)) >> 4) + d) & 0x000f0f0f;
 	return (tb_uint16_t)((d & 0xffff) | (d >> 12) | 0xf000);
 }
 
@@ -131,7 +133,7 @@ static __tb_inline__ tb_void_t gb_pixmap_xrgb4444_pixels_fill_la(tb_pointer_t da
 	tb_size_t 		l = count & 0x3; count -= l; alpha >>= 3;
 	tb_uint16_t* 	p = (tb_uint16_t*)data;
 	tb_uint16_t* 	e = p + count;
-	tb_uint32_t 	s = (pixel | (pixel << 16)) & 0x000f0f0f;
+	tb_uint32_t 	s = (pixel | (pixel << 12)) & 0x000f0f0f;
 	while (p < e)
 	{
 		tb_bits_set_u16_le(&p[0], gb_pixmap_xrgb4444_blend2(tb_bits_get_u16_le(&p[0]), s, alpha));
@@ -151,7 +153,7 @@ static __tb_inline__ tb_void_t gb_pixmap_xrgb4444_pixels_fill_ba(tb_pointer_t da
 	tb_size_t 		l = count & 0x3; count -= l; alpha >>= 3;
 	tb_uint16_t* 	p = (tb_uint16_t*)data;
 	tb_uint16_t* 	e = p + count;
-	tb_uint32_t 	s = (pixel | (pixel << 16)) & 0x000f0f0f;
+	tb_uint32_t 	s = (pixel | (pixel << 12)) & 0x000f0f0f;
 	while (p < e)
 	{
 		tb_bits_set_u16_be(&p[0], gb_pixmap_xrgb4444_blend2(tb_bits_get_u16_be(&p[0]), s, alpha));
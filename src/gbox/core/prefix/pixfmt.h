@@ -136,6 +136,9 @@
 /// the alpha mask?
 #define GB_PIXFMT_ALPHA             (0x0200)
 
+/// the premultiplied alpha mask?
+#define GB_PIXFMT_PREMULTIPLIED     (0x0400)
+
 /// pixfmt
 #define GB_PIXFMT(pixfmt)           (((pixfmt) & 0xff))
 
@@ -145,6 +148,9 @@
 /// has alpha
 #define GB_PIXFMT_HAS_ALPHA(pixfmt) (((pixfmt) & GB_PIXFMT_ALPHA))
 
+/// is premultiplied alpha?
+#define GB_PIXFMT_IS_PREMULTIPLIED(pixfmt)  (((pixfmt) & GB_PIXFMT_PREMULTIPLIED))
+
 /// pixfmt ok?
 #define GB_PIXFMT_OK(pixfmt)        (GB_PIXFMT(pixfmt) != GB_PIXFMT_NONE)
 
@@ -188,6 +194,11 @@ typedef enum __gb_pixfmt_t
 ,   GB_PIXFMT_BGRA8888      = 28    | GB_PIXFMT_ALPHA       //!< 32-bit b g r a: 8 8 8 8
 ,   GB_PIXFMT_BGRX8888      = 29                            //!< 32-bit b g r x: 8 8 8 8
 
+,   GB_PIXFMT_PARGB8888     = 30    | GB_PIXFMT_ALPHA | GB_PIXFMT_PREMULTIPLIED     //!< 32-bit premultiplied a r g b: 8 8 8 8, r, g, b <= a
+
+,   GB_PIXFMT_A8            = 31    | GB_PIXFMT_ALPHA       //!< 8-bit alpha only, for the masks
+,   GB_PIXFMT_G8            = 32                            //!< 8-bit gray
+
 }gb_pixfmt_t;
 
 
@@ -68,6 +68,13 @@
  */
 #define GB_ALPHA_MAXN           ((tb_byte_t)(0xff - ((GB_QUALITY_TOP - gb_quality()) << 3)))
 
+/*! is opaque alpha?
+ *
+ * the alpha 0xff is always opaque even if the quality is top, 
+ * so the opaque pixels will not be blended and darkened 
+ */
+#define GB_ALPHA_IS_OPAQUE(alpha)   ((alpha) == 0xff || (alpha) > GB_ALPHA_MAXN)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -46,6 +46,7 @@ tb_void_t gb_round_rect_make(gb_round_rect_ref_t rect, gb_rect_ref_t bounds, gb_
     rect->radius[1] = radius[1];  
     rect->radius[2] = radius[2]; 
     rect->radius[3] = radius[3]; 
+    rect->bounds    = *bounds;
 }
 tb_void_t gb_round_rect_make_same(gb_round_rect_ref_t rect, gb_rect_ref_t bounds, gb_float_t rx, gb_float_t ry)
 {
@@ -363,6 +363,9 @@ typedef struct{}*       gb_paint_ref_t;
 /// the bitmap ref type
 typedef struct{}*       gb_bitmap_ref_t;
 
+/// the palette ref type
+typedef struct{}*       gb_palette_ref_t;
+
 /// the shader ref type
 typedef struct{}*       gb_shader_ref_t;
 
@@ -34,9 +34,113 @@
  */
 #include "geometry.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+#ifdef GB_CONFIG_FLOAT_FIXED
+/* the maximum coordinate difference for the fast orientation
+ *
+ * the cross value will not overflow 64-bits if all differences are less than it
+ */
+#   define GB_GEOMETRY_ORIENTATION_FAST_MAXD        ((tb_hong_t)1 << 31)
+#else
+// the relative error of the double: 2^-53
+#   define GB_GEOMETRY_EPSILON                      (1.1102230246251565e-16)
+
+// the error bound of the fast orientation: (3 + 16 * eps) * eps, see Shewchuk's ccwerrboundA
+#   define GB_GEOMETRY_ORIENTATION_ERRBOUND         ((3.0 + 16.0 * GB_GEOMETRY_EPSILON) * GB_GEOMETRY_EPSILON)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+
+/* compute the exact orientation of the three points
+ *
+ * cross[(p1, p0), (p1, p2)] = (x0 - x1) * (y2 - y1) - (y0 - y1) * (x2 - x1)
+ *                           = x0 * y2 - x0 * y1 - x1 * y2 - y0 * x2 + y0 * x1 + y1 * x2
+ *
+ * all products are exact (fixed: 32 x 32 => 64-bits, float: 24 x 24 => 53-bits), 
+ * so we need only sum them exactly and get the sign of the result.
+ *
+ * it is slower than the fast orientation, but we need call it only for the almost-degenerate situations
+ */
+static tb_long_t gb_points_orientation_exact(gb_point_ref_t p0, gb_point_ref_t p1, gb_point_ref_t p2)
+{
+#ifdef GB_CONFIG_FLOAT_FIXED
+    // the products
+    tb_hong_t products[6];
+    products[0] =  (tb_hong_t)p0->x * p2->y;
+    products[1] = -(tb_hong_t)p0->x * p1->y;
+    products[2] = -(tb_hong_t)p1->x * p2->y;
+    products[3] = -(tb_hong_t)p0->y * p2->x;
+    products[4] =  (tb_hong_t)p0->y * p1->x;
+    products[5] =  (tb_hong_t)p1->y * p2->x;
+
+    /* sum the high and low 32-bits parts respectively, it will not overflow
+     *
+     * sum = high * 2^32 + low
+     */
+    tb_size_t i     = 0;
+    tb_hong_t high  = 0;
+    tb_hong_t low   = 0;
+    for (i = 0; i < tb_arrayn(products); i++)
+    {
+        high += products[i] >> 32;
+        low  += products[i] & 0xffffffff;
+    }
+
+    // normalize it, 0 <= low < 2^32 
+    high += low >> 32;
+    low &= 0xffffffff;
+
+    // get the sign of the sum
+    return high > 0? 1 : (high < 0? -1 : (low != 0));
+#else
+    // the products
+    tb_double_t products[6];
+    products[0] =  (tb_double_t)p0->x * p2->y;
+    products[1] = -(tb_double_t)p0->x * p1->y;
+    products[2] = -(tb_double_t)p1->x * p2->y;
+    products[3] = -(tb_double_t)p0->y * p2->x;
+    products[4] =  (tb_double_t)p0->y * p1->x;
+    products[5] =  (tb_double_t)p1->y * p2->x;
+
+    /* sum them to the nonoverlapping expansion exactly, see Shewchuk's grow-expansion
+     *
+     * sum = expansion[0] + expansion[1] + ... + expansion[size - 1]
+     * 
+     * and the last nonzero component is the largest one
+     */
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_size_t   size = 0;
+    tb_double_t expansion[6];
+    for (i = 0; i < tb_arrayn(products); i++)
+    {
+        tb_double_t q = products[i];
+        for (j = 0; j < size; j++)
+        {
+            // two-sum: q + expansion[j] = sum + error exactly
+            tb_double_t sum     = q + expansion[j];
+            tb_double_t bvirt   = sum - q;
+            tb_double_t avirt   = sum - bvirt;
+            expansion[j]        = (q - avirt) + (expansion[j] - bvirt);
+            q                   = sum;
+        }
+        expansion[size++] = q;
+    }
+
+    // get the sign of the largest nonzero component
+    while (size--)
+    {
+        if (expansion[size] > 0) return 1;
+        else if (expansion[size] < 0) return -1;
+    }
+    return 0;
+#endif
+}
 static gb_double_t gb_point_to_segment_distance_h_cheap(gb_point_ref_t center, gb_point_ref_t upper, gb_point_ref_t lower)
 {
     // check
@@ -434,27 +538,66 @@ static tb_bool_t gb_segment_near_parallel(gb_point_ref_t org1, gb_point_ref_t ds
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_long_t gb_points_is_ccw(gb_point_ref_t p0, gb_point_ref_t p1, gb_point_ref_t p2)
+tb_long_t gb_points_orientation(gb_point_ref_t p0, gb_point_ref_t p1, gb_point_ref_t p2)
 {
     // check
     tb_assert(p0 && p1 && p2);
 
-    // the coordinates
-    tb_fixed_t x0 = gb_float_to_fixed(p0->x);
-    tb_fixed_t y0 = gb_float_to_fixed(p0->y);
-    tb_fixed_t x1 = gb_float_to_fixed(p1->x);
-    tb_fixed_t y1 = gb_float_to_fixed(p1->y);
-    tb_fixed_t x2 = gb_float_to_fixed(p2->x);
-    tb_fixed_t y2 = gb_float_to_fixed(p2->y);
-  
-    /* compute the cross value of the vectors (p1, p0) and (p1, p2)
-     *
-     * cross[(p1, p0), (p1, p2)] > 0
+#ifdef GB_CONFIG_FLOAT_FIXED
+    // the differences
+    tb_hong_t dx0 = (tb_hong_t)p0->x - p1->x;
+    tb_hong_t dy0 = (tb_hong_t)p0->y - p1->y;
+    tb_hong_t dx2 = (tb_hong_t)p2->x - p1->x;
+    tb_hong_t dy2 = (tb_hong_t)p2->y - p1->y;
+
+    // the cross value will not overflow? it is exact
+    if (    dx0 < GB_GEOMETRY_ORIENTATION_FAST_MAXD && dx0 > -GB_GEOMETRY_ORIENTATION_FAST_MAXD
+        &&  dy0 < GB_GEOMETRY_ORIENTATION_FAST_MAXD && dy0 > -GB_GEOMETRY_ORIENTATION_FAST_MAXD
+        &&  dx2 < GB_GEOMETRY_ORIENTATION_FAST_MAXD && dx2 > -GB_GEOMETRY_ORIENTATION_FAST_MAXD
+        &&  dy2 < GB_GEOMETRY_ORIENTATION_FAST_MAXD && dy2 > -GB_GEOMETRY_ORIENTATION_FAST_MAXD)
+    {
+        // compute the cross value of the vectors (p1, p0) and (p1, p2)
+        tb_hong_t cross = dx0 * dy2 - dy0 * dx2;
+        return cross > 0? 1 : (cross < 0? -1 : 0);
+    }
+#else
+    /* compute the cross value of the vectors (p1, p0) and (p1, p2) with the double
      *
+     * cross = left - right
+     */
+    tb_double_t left    = ((tb_double_t)p0->x - p1->x) * ((tb_double_t)p2->y - p1->y);
+    tb_double_t right   = ((tb_double_t)p0->y - p1->y) * ((tb_double_t)p2->x - p1->x);
+    tb_double_t cross   = left - right;
+
+    // the sign of the cross value is exact if the left and right values have the different signs
+    tb_double_t sum = 0;
+    if (left > 0)
+    {
+        if (right <= 0) return cross > 0? 1 : (cross < 0? -1 : 0);
+        sum = left + right;
+    }
+    else if (left < 0)
+    {
+        if (right >= 0) return cross > 0? 1 : (cross < 0? -1 : 0);
+        sum = -left - right;
+    }
+    else return cross > 0? 1 : (cross < 0? -1 : 0);
+
+    // the error of the cross value is less than the error bound? it is reliable
+    tb_double_t bound = GB_GEOMETRY_ORIENTATION_ERRBOUND * sum;
+    if (cross >= bound || -cross >= bound) return cross > 0? 1 : -1;
+#endif
+
+    // it is almost-degenerate, we compute it exactly
+    return gb_points_orientation_exact(p0, p1, p2);
+}
+tb_long_t gb_points_is_ccw(gb_point_ref_t p0, gb_point_ref_t p1, gb_point_ref_t p2)
+{
+    /* the cross value of the vectors (p1, p0) and (p1, p2) > 0
      *
-     * the result is not reliable for almost-degenerate situations
+     * cross[(p1, p0), (p1, p2)] > 0
      */
-    return ((tb_hong_t)(x0 - x1) * (y2 - y1) - (tb_hong_t)(y0 - y1) * (x2 - x1)) > 0;
+    return gb_points_orientation(p0, p1, p2) > 0;
 }
 gb_float_t gb_point_to_segment_distance_h(gb_point_ref_t center, gb_point_ref_t upper, gb_point_ref_t lower)
 {
@@ -639,22 +782,36 @@ tb_long_t gb_point_to_segment_position_h(gb_point_ref_t center, gb_point_ref_t u
     // check
     tb_assert(center && upper && lower);
 
-    // compute the cheap distance quickly
-    gb_double_t distance = gb_point_to_segment_distance_h_cheap(center, upper, lower);
+    // must be upper <= center <= lower
+    tb_assertf(gb_point_in_top_or_horizontal(upper, center), "%{point} <=? %{point}", upper, center);
+    tb_assertf(gb_point_in_top_or_horizontal(center, lower), "%{point} <=? %{point}", center, lower);
 
-    // get the sign of the distance
-    return distance < 0? -1 : distance > 0;
+    /* the sign of the cheap distance is the orientation of (lower, upper, center)
+     *
+     * distance * (yu + yl) = (center.x - lower.x) * yu + (center.x - upper.x) * yl
+     *                      = -cross[(upper, lower), (upper, center)]
+     *
+     * and it will be zero for the horizontal edge
+     */
+    return -gb_points_orientation(lower, upper, center);
 }
 tb_long_t gb_point_to_segment_position_v(gb_point_ref_t center, gb_point_ref_t left, gb_point_ref_t right)
 {
     // check
     tb_assert(center && left && right);
 
-    // compute the cheap distance quickly
-    gb_double_t distance = gb_point_to_segment_distance_v_cheap(center, left, right);
+    // must be left <= center <= right
+    tb_assertf(gb_point_in_left_or_vertical(left, center), "%{point} <=? %{point}", left, center);
+    tb_assertf(gb_point_in_left_or_vertical(center, right), "%{point} <=? %{point}", center, right);
 
-    // get the sign of the distance
-    return distance < 0? -1 : distance > 0;
+    /* the sign of the cheap distance is the orientation of (right, left, center)
+     *
+     * distance * (xl + xr) = (center.y - right.y) * xl + (center.y - left.y) * xr
+     *                      = cross[(left, right), (left, center)]
+     *
+     * and it will be zero for the vertical edge
+     */
+    return gb_points_orientation(right, left, center);
 }
 tb_long_t gb_segment_intersection(gb_point_ref_t org1, gb_point_ref_t dst1, gb_point_ref_t org2, gb_point_ref_t dst2, gb_point_ref_t result)
 {
@@ -664,6 +821,20 @@ tb_long_t gb_segment_intersection(gb_point_ref_t org1, gb_point_ref_t dst1, gb_p
     // near parallel? no intersection
     if (gb_segment_near_parallel(org1, dst1, org2, dst2)) return 0;
 
+    /* no intersection? we reject it exactly if org2 and dst2 are strictly on the same side of segment1
+     *
+     *                  org2
+     *                   .
+     *                     .
+     *                       . dst2
+     * . . . . . . . . . . . .
+     * org1                 dst1
+     */
+    if (gb_points_orientation(org1, dst1, org2) * gb_points_orientation(org1, dst1, dst2) > 0) return -1;
+
+    // no intersection? we reject it exactly if org1 and dst1 are strictly on the same side of segment2
+    if (gb_points_orientation(org2, dst2, org1) * gb_points_orientation(org2, dst2, dst1) > 0) return -1;
+
     /* calculate the intersection
      *
      * this is certainly not the most efficient way to find the intersection of two line segments,
@@ -183,6 +183,20 @@ __tb_extern_c_enter__
  * interfaces
  */
 
+/*! compute the orientation of the three points
+ *
+ * the sign of cross[(p1, p0), (p1, p2)], it is evaluated with the adaptive precision:
+ * the fast filter first and the exact arithmetic only for the almost-degenerate situations,
+ * so the result is always reliable.
+ *
+ * @param p0            the first point
+ * @param p1            the second point
+ * @param p2            the last point
+ *
+ * @return              counter-clockwise: 1, clockwise: -1, collinear: 0
+ */
+tb_long_t               gb_points_orientation(gb_point_ref_t p0, gb_point_ref_t p1, gb_point_ref_t p2);
+
 /*! the three points are counter-clockwise?
  *
  *                   p1
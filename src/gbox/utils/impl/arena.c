@@ -0,0 +1,206 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena.c
+ * @ingroup     utils
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "arena"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "arena.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the alignment of the chunk data
+ *
+ * the items are bumped from the cache line boundary, 
+ * so the item with the cache line size (e.g. the mesh edge with its user data) will be not split into two lines
+ */
+#define GB_ARENA_CHUNK_ALIGN                (64)
+
+// the chunk data
+#define gb_arena_chunk_data(chunk)          ((tb_byte_t*)tb_align((tb_size_t)(chunk) + sizeof(gb_arena_chunk_t), GB_ARENA_CHUNK_ALIGN))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the arena chunk type
+typedef struct __gb_arena_chunk_t
+{
+    // the next chunk
+    struct __gb_arena_chunk_t*  next;
+
+}gb_arena_chunk_t;
+
+// the arena impl type
+typedef struct __gb_arena_impl_t
+{
+    // the items count of each chunk
+    tb_size_t                   grow;
+
+    // the item size
+    tb_size_t                   item_size;
+
+    // the items count
+    tb_size_t                   size;
+
+    // the chunks
+    gb_arena_chunk_t*           chunks;
+
+    // the current chunk, all chunks after it are not used
+    gb_arena_chunk_t*           chunk;
+
+    // the used items count of the current chunk
+    tb_size_t                   index;
+
+    // the free items
+    tb_pointer_t                frees;
+
+}gb_arena_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_arena_ref_t gb_arena_init(tb_size_t grow, tb_size_t item_size)
+{
+    // check
+    tb_assert_and_check_return_val(grow && item_size, tb_null);
+
+    // make arena
+    gb_arena_impl_t* impl = tb_malloc0_type(gb_arena_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init arena, the free item need store the next free item
+    impl->grow      = grow;
+    impl->item_size = tb_align8(tb_max(item_size, sizeof(tb_pointer_t)));
+
+    // ok
+    return (gb_arena_ref_t)impl;
+}
+tb_void_t gb_arena_exit(gb_arena_ref_t arena)
+{
+    // check
+    gb_arena_impl_t* impl = (gb_arena_impl_t*)arena;
+    tb_assert_and_check_return(impl);
+
+    // exit all chunks
+    gb_arena_chunk_t* chunk = impl->chunks;
+    while (chunk)
+    {
+        gb_arena_chunk_t* next = chunk->next;
+        tb_free(chunk);
+        chunk = next;
+    }
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_arena_clear(gb_arena_ref_t arena)
+{
+    // check
+    gb_arena_impl_t* impl = (gb_arena_impl_t*)arena;
+    tb_assert_and_check_return(impl);
+
+    // reset it and all chunks will be reused from the head
+    impl->size  = 0;
+    impl->chunk = tb_null;
+    impl->index = 0;
+    impl->frees = tb_null;
+}
+tb_size_t gb_arena_size(gb_arena_ref_t arena)
+{
+    // check
+    gb_arena_impl_t* impl = (gb_arena_impl_t*)arena;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the items count
+    return impl->size;
+}
+tb_pointer_t gb_arena_malloc0(gb_arena_ref_t arena)
+{
+    // check
+    gb_arena_impl_t* impl = (gb_arena_impl_t*)arena;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // reuse the free item first
+    tb_pointer_t data = impl->frees;
+    if (data) impl->frees = *((tb_pointer_t*)data);
+    else
+    {
+        // the current chunk is full? switch to the next chunk
+        if (!impl->chunk || impl->index == impl->grow)
+        {
+            // the next unused chunk
+            gb_arena_chunk_t* next = impl->chunk? impl->chunk->next : impl->chunks;
+            if (!next)
+            {
+                // make a new chunk
+                next = (gb_arena_chunk_t*)tb_malloc(sizeof(gb_arena_chunk_t) + GB_ARENA_CHUNK_ALIGN + impl->grow * impl->item_size);
+                tb_assert_and_check_return_val(next, tb_null);
+
+                // append it to the chunks
+                next->next = tb_null;
+                if (impl->chunk) impl->chunk->next = next;
+                else impl->chunks = next;
+            }
+
+            // use the next chunk
+            impl->chunk = next;
+            impl->index = 0;
+        }
+
+        // bump a new item from the current chunk
+        data = gb_arena_chunk_data(impl->chunk) + impl->index++ * impl->item_size;
+    }
+
+    // clear it
+    tb_memset(data, 0, impl->item_size);
+
+    // update the items count
+    impl->size++;
+
+    // ok
+    return data;
+}
+tb_void_t gb_arena_free(gb_arena_ref_t arena, tb_pointer_t data)
+{
+    // check
+    gb_arena_impl_t* impl = (gb_arena_impl_t*)arena;
+    tb_assert_and_check_return(impl && data && impl->size);
+
+    // put it to the free items
+    *((tb_pointer_t*)data) = impl->frees;
+    impl->frees = data;
+
+    // update the items count
+    impl->size--;
+}
@@ -0,0 +1,107 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena.h
+ * @ingroup     utils
+ *
+ */
+#ifndef GB_UTILS_IMPL_ARENA_H
+#define GB_UTILS_IMPL_ARENA_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the fixed-size item arena type
+ *
+ * the items are bumped from the chunks and the freed items are reused by the free list,
+ * all chunks are kept after clearing it, so the memory will be hot for the next using.
+ */
+typedef struct{}*           gb_arena_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the arena
+ *
+ * @param grow              the items count of each chunk
+ * @param item_size         the item size
+ *
+ * @return                  the arena
+ */
+gb_arena_ref_t              gb_arena_init(tb_size_t grow, tb_size_t item_size);
+
+/* exit the arena
+ *
+ * @param arena             the arena
+ */
+tb_void_t                   gb_arena_exit(gb_arena_ref_t arena);
+
+/* clear the arena in O(1) and keep all chunks
+ *
+ * @note the items will be not exited one by one
+ *
+ * @param arena             the arena
+ */
+tb_void_t                   gb_arena_clear(gb_arena_ref_t arena);
+
+/* the items count of the arena
+ *
+ * @param arena             the arena
+ *
+ * @return                  the items count
+ */
+tb_size_t                   gb_arena_size(gb_arena_ref_t arena);
+
+/* make a new item and clear it
+ *
+ * @param arena             the arena
+ *
+ * @return                  the item data
+ */
+tb_pointer_t                gb_arena_malloc0(gb_arena_ref_t arena);
+
+/* free the item and it will be reused for the next item
+ *
+ * @param arena             the arena
+ * @param data              the item data
+ */
+tb_void_t                   gb_arena_free(gb_arena_ref_t arena, tb_pointer_t data);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
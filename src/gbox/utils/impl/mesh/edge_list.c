@@ -33,6 +33,7 @@
  * includes
  */
 #include "edge_list.h"
+#include "../arena.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -68,6 +69,9 @@ typedef struct __gb_mesh_edge_list_impl_t
     // the pool
     tb_fixed_pool_ref_t             pool;
 
+    // the arena, the pool will be not used if it exists
+    gb_arena_ref_t                  arena;
+
     // the head edge
     gb_mesh_edge_t                  head[2];
 
@@ -100,6 +104,21 @@ static tb_void_t gb_mesh_edge_exit(tb_pointer_t data, tb_cpointer_t priv)
     impl->element.free(&impl->element, (tb_pointer_t)((gb_mesh_edge_ref_t)data + 1));
     impl->element.free(&impl->element, (tb_pointer_t)((gb_mesh_edge_ref_t)((tb_byte_t*)data + impl->edge_size) + 1));
 }
+static __tb_inline__ tb_pointer_t gb_mesh_edge_list_malloc0(gb_mesh_edge_list_impl_t* impl)
+{
+    // make it from the arena or pool
+    return impl->arena? gb_arena_malloc0(impl->arena) : tb_fixed_pool_malloc0(impl->pool);
+}
+static __tb_inline__ tb_void_t gb_mesh_edge_list_free(gb_mesh_edge_list_impl_t* impl, tb_pointer_t data)
+{
+    // exit it to the arena or pool
+    if (impl->arena) 
+    {
+        gb_mesh_edge_exit(data, (tb_cpointer_t)impl);
+        gb_arena_free(impl->arena, data);
+    }
+    else tb_fixed_pool_free(impl->pool, data);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
@@ -248,7 +267,7 @@ static tb_pointer_t gb_mesh_edge_itor_item(tb_iterator_ref_t iterator, tb_size_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-gb_mesh_edge_list_ref_t gb_mesh_edge_list_init(tb_element_t element)
+gb_mesh_edge_list_ref_t gb_mesh_edge_list_init(tb_element_t element, tb_bool_t arena)
 {
     // check
     tb_assert_and_check_return_val(element.data && element.dupl && element.repl, tb_null);
@@ -283,9 +302,10 @@ gb_mesh_edge_list_ref_t gb_mesh_edge_list_init(tb_element_t element)
         impl->itor.next = gb_mesh_edge_itor_next;
         impl->itor.item = gb_mesh_edge_itor_item;
 
-        // init pool, item = (edge + data) + (edge->sym + data)
-        impl->pool = tb_fixed_pool_init(tb_null, GB_MESH_EDGE_LIST_GROW, impl->edge_size << 1, tb_null, gb_mesh_edge_exit, (tb_cpointer_t)impl);
-        tb_assert_and_check_break(impl->pool);
+        // init arena or pool, item = (edge + data) + (edge->sym + data)
+        if (arena) impl->arena = gb_arena_init(GB_MESH_EDGE_LIST_GROW, impl->edge_size << 1);
+        else impl->pool = tb_fixed_pool_init(tb_null, GB_MESH_EDGE_LIST_GROW, impl->edge_size << 1, tb_null, gb_mesh_edge_exit, (tb_cpointer_t)impl);
+        tb_assert_and_check_break(impl->pool || impl->arena);
 
         // init head edge
         impl->head[0].sym = &impl->head[1];
@@ -323,6 +343,10 @@ tb_void_t gb_mesh_edge_list_exit(gb_mesh_edge_list_ref_t list)
     if (impl->pool) tb_fixed_pool_exit(impl->pool);
     impl->pool = tb_null;
 
+    // exit arena
+    if (impl->arena) gb_arena_exit(impl->arena);
+    impl->arena = tb_null;
+
     // exit it
     tb_free(impl);
 }
@@ -335,6 +359,9 @@ tb_void_t gb_mesh_edge_list_clear(gb_mesh_edge_list_ref_t list)
     // clear pool
     if (impl->pool) tb_fixed_pool_clear(impl->pool);
 
+    // clear arena and keep its memory
+    if (impl->arena) gb_arena_clear(impl->arena);
+
     // clear list
     gb_mesh_edge_init(impl->head);
 
@@ -352,10 +379,10 @@ tb_size_t gb_mesh_edge_list_size(gb_mesh_edge_list_ref_t list)
 {
     // check
     gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)list;
-    tb_assert_and_check_return_val(impl && impl->pool, 0);
+    tb_assert_and_check_return_val(impl && (impl->pool || impl->arena), 0);
 
     // the size
-    return tb_fixed_pool_size(impl->pool);
+    return impl->arena? gb_arena_size(impl->arena) : tb_fixed_pool_size(impl->pool);
 }
 tb_size_t gb_mesh_edge_list_maxn(gb_mesh_edge_list_ref_t list)
 {
@@ -366,10 +393,10 @@ gb_mesh_edge_ref_t gb_mesh_edge_list_make(gb_mesh_edge_list_ref_t list)
 {
     // check
     gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)list;
-    tb_assert_and_check_return_val(impl && impl->pool, tb_null);
+    tb_assert_and_check_return_val(impl && (impl->pool || impl->arena), tb_null);
 
     // make it
-    gb_mesh_edge_ref_t edge = (gb_mesh_edge_ref_t)tb_fixed_pool_malloc0(impl->pool);
+    gb_mesh_edge_ref_t edge = (gb_mesh_edge_ref_t)gb_mesh_edge_list_malloc0(impl);
     tb_assert_and_check_return_val(edge, tb_null);
 
     // the sym edge
@@ -414,10 +441,10 @@ gb_mesh_edge_ref_t gb_mesh_edge_list_make_loop(gb_mesh_edge_list_ref_t list, tb_
 {
     // check
     gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)list;
-    tb_assert_and_check_return_val(impl && impl->pool, tb_null);
+    tb_assert_and_check_return_val(impl && (impl->pool || impl->arena), tb_null);
 
     // make it
-    gb_mesh_edge_ref_t edge = (gb_mesh_edge_ref_t)tb_fixed_pool_malloc0(impl->pool);
+    gb_mesh_edge_ref_t edge = (gb_mesh_edge_ref_t)gb_mesh_edge_list_malloc0(impl);
     tb_assert_and_check_return_val(edge, tb_null);
 
     // the sym edge
@@ -483,7 +510,7 @@ tb_void_t gb_mesh_edge_list_kill(gb_mesh_edge_list_ref_t list, gb_mesh_edge_ref_
 {
     // check
     gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)list;
-    tb_assert_and_check_return(impl && impl->pool && edge);
+    tb_assert_and_check_return(impl && (impl->pool || impl->arena) && edge);
 
     // make sure the edge points to the first half-edge
     if (edge->sym < edge) edge = edge->sym;
@@ -501,7 +528,7 @@ tb_void_t gb_mesh_edge_list_kill(gb_mesh_edge_list_ref_t list, gb_mesh_edge_ref_
     gb_mesh_edge_remove_done(edge);
 
     // exit it
-    tb_fixed_pool_free(impl->pool, edge);
+    gb_mesh_edge_list_free(impl, edge);
 }
 tb_cpointer_t gb_mesh_edge_list_data(gb_mesh_edge_list_ref_t list, gb_mesh_edge_ref_t edge)
 {
@@ -50,10 +50,11 @@ typedef struct{}*           gb_mesh_edge_list_ref_t;
 /* init the mesh edge list 
  *
  * @param element           the element
+ * @param arena             using the arena? it will be cleared in O(1) and keep memory
  *
  * @return                  the edge list
  */
-gb_mesh_edge_list_ref_t     gb_mesh_edge_list_init(tb_element_t element);
+gb_mesh_edge_list_ref_t     gb_mesh_edge_list_init(tb_element_t element, tb_bool_t arena);
 
 /* exit the mesh edge list
  *
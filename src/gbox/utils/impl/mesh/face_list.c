@@ -33,6 +33,7 @@
  * includes
  */
 #include "face_list.h"
+#include "../arena.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -65,6 +66,9 @@ typedef struct __gb_mesh_face_list_impl_t
     // the pool
     tb_fixed_pool_ref_t         pool;
 
+    // the arena, the pool will be not used if it exists
+    gb_arena_ref_t              arena;
+
     // the head
     tb_list_entry_head_t        head;
 
@@ -93,11 +97,26 @@ static tb_void_t gb_mesh_face_exit(tb_pointer_t data, tb_cpointer_t priv)
     // exit the user data
     impl->element.free(&impl->element, (tb_pointer_t)((gb_mesh_face_ref_t)data + 1));
 }
+static __tb_inline__ tb_pointer_t gb_mesh_face_list_malloc0(gb_mesh_face_list_impl_t* impl)
+{
+    // make it from the arena or pool
+    return impl->arena? gb_arena_malloc0(impl->arena) : tb_fixed_pool_malloc0(impl->pool);
+}
+static __tb_inline__ tb_void_t gb_mesh_face_list_free(gb_mesh_face_list_impl_t* impl, tb_pointer_t data)
+{
+    // exit it to the arena or pool
+    if (impl->arena) 
+    {
+        gb_mesh_face_exit(data, (tb_cpointer_t)impl);
+        gb_arena_free(impl->arena, data);
+    }
+    else tb_fixed_pool_free(impl->pool, data);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-gb_mesh_face_list_ref_t gb_mesh_face_list_init(tb_element_t element)
+gb_mesh_face_list_ref_t gb_mesh_face_list_init(tb_element_t element, tb_bool_t arena)
 {
     // check
     tb_assert_and_check_return_val(element.data && element.dupl && element.repl, tb_null);
@@ -114,9 +133,10 @@ gb_mesh_face_list_ref_t gb_mesh_face_list_init(tb_element_t element)
         // init element
         impl->element = element;
 
-        // init pool, item = face + data
-        impl->pool = tb_fixed_pool_init(tb_null, GB_MESH_FACE_LIST_GROW, sizeof(gb_mesh_face_t) + element.size, tb_null, gb_mesh_face_exit, (tb_cpointer_t)impl);
-        tb_assert_and_check_break(impl->pool);
+        // init arena or pool, item = face + data
+        if (arena) impl->arena = gb_arena_init(GB_MESH_FACE_LIST_GROW, sizeof(gb_mesh_face_t) + element.size);
+        else impl->pool = tb_fixed_pool_init(tb_null, GB_MESH_FACE_LIST_GROW, sizeof(gb_mesh_face_t) + element.size, tb_null, gb_mesh_face_exit, (tb_cpointer_t)impl);
+        tb_assert_and_check_break(impl->pool || impl->arena);
 
         // init head
         tb_list_entry_init_(&impl->head, 0, sizeof(gb_mesh_face_t) + element.size, tb_null);
@@ -153,6 +173,10 @@ tb_void_t gb_mesh_face_list_exit(gb_mesh_face_list_ref_t list)
     if (impl->pool) tb_fixed_pool_exit(impl->pool);
     impl->pool = tb_null;
 
+    // exit arena
+    if (impl->arena) gb_arena_exit(impl->arena);
+    impl->arena = tb_null;
+
     // exit it
     tb_free(impl);
 }
@@ -165,6 +189,9 @@ tb_void_t gb_mesh_face_list_clear(gb_mesh_face_list_ref_t list)
     // clear pool
     if (impl->pool) tb_fixed_pool_clear(impl->pool);
 
+    // clear arena and keep its memory
+    if (impl->arena) gb_arena_clear(impl->arena);
+
     // clear head
     tb_list_entry_clear(&impl->head);
 
@@ -186,8 +213,8 @@ tb_size_t gb_mesh_face_list_size(gb_mesh_face_list_ref_t list)
 {
     // check
     gb_mesh_face_list_impl_t* impl = (gb_mesh_face_list_impl_t*)list;
-    tb_assert_and_check_return_val(impl && impl->pool, 0);
-    tb_assert(tb_list_entry_size(&impl->head) == tb_fixed_pool_size(impl->pool));
+    tb_assert_and_check_return_val(impl && (impl->pool || impl->arena), 0);
+    tb_assert(tb_list_entry_size(&impl->head) == (impl->arena? gb_arena_size(impl->arena) : tb_fixed_pool_size(impl->pool)));
 
     // the size
     return tb_list_entry_size(&impl->head);
@@ -201,10 +228,10 @@ gb_mesh_face_ref_t gb_mesh_face_list_make(gb_mesh_face_list_ref_t list)
 {
     // check
     gb_mesh_face_list_impl_t* impl = (gb_mesh_face_list_impl_t*)list;
-    tb_assert_and_check_return_val(impl && impl->pool, tb_null);
+    tb_assert_and_check_return_val(impl && (impl->pool || impl->arena), tb_null);
 
     // make it
-    gb_mesh_face_ref_t face = (gb_mesh_face_ref_t)tb_fixed_pool_malloc0(impl->pool);
+    gb_mesh_face_ref_t face = (gb_mesh_face_ref_t)gb_mesh_face_list_malloc0(impl);
     tb_assert_and_check_return_val(face, tb_null);
 
 #ifdef __gb_debug__
@@ -247,7 +274,7 @@ tb_void_t gb_mesh_face_list_kill(gb_mesh_face_list_ref_t list, gb_mesh_face_ref_
 {
     // check
     gb_mesh_face_list_impl_t* impl = (gb_mesh_face_list_impl_t*)list;
-    tb_assert_and_check_return(impl && impl->pool && face);
+    tb_assert_and_check_return(impl && (impl->pool || impl->arena) && face);
 
 #ifdef __gb_debug__
     // check
@@ -261,7 +288,7 @@ tb_void_t gb_mesh_face_list_kill(gb_mesh_face_list_ref_t list, gb_mesh_face_ref_
     tb_list_entry_remove(&impl->head, &face->entry);
 
     // exit it
-    tb_fixed_pool_free(impl->pool, face);
+    gb_mesh_face_list_free(impl, face);
 }
 tb_cpointer_t gb_mesh_face_list_data(gb_mesh_face_list_ref_t list, gb_mesh_face_ref_t face)
 {
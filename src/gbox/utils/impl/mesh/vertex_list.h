@@ -54,10 +54,11 @@ typedef struct{}*           gb_mesh_vertex_list_ref_t;
 /* init the mesh vertex list 
  *
  * @param element           the element
+ * @param arena             using the arena? it will be cleared in O(1) and keep memory
  *
  * @returned                the vertex list
  */
-gb_mesh_vertex_list_ref_t   gb_mesh_vertex_list_init(tb_element_t element);
+gb_mesh_vertex_list_ref_t   gb_mesh_vertex_list_init(tb_element_t element, tb_bool_t arena);
 
 /* exit the mesh vertex list
  *
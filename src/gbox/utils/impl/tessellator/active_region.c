@@ -35,6 +35,7 @@
 #include "active_region.h"
 #include "geometry.h"
 #include "mesh.h"
+#include "../arena.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -43,6 +44,70 @@
 // enable test?
 #define GB_ACTIVE_REGION_TEST_ENABLE    (0)
 
+// the active regions grow
+#ifdef __gb_small__
+#   define GB_ACTIVE_REGIONS_GROW       (64)
+#else
+#   define GB_ACTIVE_REGIONS_GROW       (256)
+#endif
+
+/* the maximum level of the active regions 
+ *
+ * the probability of the next level is 1/4, so it is enough for 4^12 regions
+ */
+#define GB_ACTIVE_REGIONS_LEVEL_MAXN    (12)
+
+// the active region node
+#define gb_tessellator_active_region_node(region)     ((gb_tessellator_active_region_node_ref_t)(region))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the active region node type of the skip list
+typedef struct __gb_tessellator_active_region_node_t
+{
+    // the region, must be the first field
+    gb_tessellator_active_region_t                  region;
+
+    // the previous node at the bottom level
+    struct __gb_tessellator_active_region_node_t*   prev;
+
+    // the level count of this node
+    tb_size_t                                       level;
+
+    // the next nodes at all levels
+    struct __gb_tessellator_active_region_node_t*   next[GB_ACTIVE_REGIONS_LEVEL_MAXN];
+
+}gb_tessellator_active_region_node_t, *gb_tessellator_active_region_node_ref_t;
+
+/* the active regions impl type
+ *
+ * the regions are kept in the sweep line order by the skip list
+ *
+ * level 2: head ---------------------------------------> r3 ------------------> null
+ * level 1: head ----------------> r1 ------------------> r3 ------> r4 -------> null
+ * level 0: head ------> r0 -----> r1 ------> r2 -------> r3 ------> r4 -------> null
+ *
+ * and we only find the position by the current ordering of the regions at the sweep line, 
+ * so the order will not be broken if the regions are changed
+ */
+typedef struct __gb_tessellator_active_regions_impl_t
+{
+    // the nodes arena
+    gb_arena_ref_t                                  arena;
+
+    // the head node
+    gb_tessellator_active_region_node_t             head;
+
+    // the level count of the skip list
+    tb_size_t                                       level;
+
+    // the random seed for the node level
+    tb_uint32_t                                     seed;
+
+}gb_tessellator_active_regions_impl_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -202,25 +267,7 @@ static tb_bool_t gb_tessellator_active_region_leq(gb_tessellator_active_region_r
     tb_assert(0);
     return 0;
 }
-static tb_long_t gb_tessellator_active_region_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
-{
-    // lregion <= rregion ? -1 : 1
-    return (!gb_tessellator_active_region_leq((gb_tessellator_active_region_ref_t)ldata, (gb_tessellator_active_region_ref_t)rdata) << 1) - 1;
-}
 #ifdef __gb_debug__
-static tb_char_t const* gb_tessellator_active_region_cstr(tb_element_ref_t element, tb_cpointer_t data, tb_char_t* cstr, tb_size_t maxn)
-{
-    // check
-    gb_tessellator_active_region_ref_t region = (gb_tessellator_active_region_ref_t)data;
-    tb_assert_and_check_return_val(region, tb_null);
-
-    // make info
-    tb_long_t size = tb_snprintf(cstr, maxn, "%{tess_region}.%{mesh_edge}", region, region->edge);
-    if (size >= 0) cstr[size] = '\0';
-
-    // ok?
-    return cstr;
-}
 static tb_long_t gb_tessellator_active_region_printf(tb_cpointer_t object, tb_char_t* cstr, tb_size_t maxn)
 {
     // check
@@ -245,7 +292,79 @@ static tb_long_t gb_tessellator_active_region_printf(tb_cpointer_t object, tb_ch
                     ,   region->inside);
 }
 #endif
-/* insert region in ascending order and save the region position
+static tb_size_t gb_tessellator_active_regions_level(gb_tessellator_active_regions_impl_t* regions)
+{
+    // check
+    tb_assert(regions);
+
+    // update the random seed using the xorshift
+    tb_uint32_t seed = regions->seed;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    regions->seed = seed;
+
+    // make a random level with the probability: 1/4 for the next level
+    tb_size_t level = 1;
+    while (!(seed & 3) && level < GB_ACTIVE_REGIONS_LEVEL_MAXN) 
+    {
+        level++;
+        seed >>= 2;
+    }
+    return level;
+}
+/* find the last node which is in the left of the given region from the given node 
+ *
+ * r0 ----> r1 ------> r2 -------> r3 ---> ... ---->
+ *        node              found
+ *          |---------------->|
+ */
+static gb_tessellator_active_region_node_ref_t gb_tessellator_active_regions_search(gb_tessellator_active_regions_impl_t* regions, gb_tessellator_active_region_node_ref_t node, gb_tessellator_active_region_ref_t region)
+{
+    // check
+    tb_assert(regions && node && region && region->edge);
+
+    // the head node?
+    tb_size_t level;
+    gb_tessellator_active_region_node_ref_t next;
+    if (node == &regions->head) level = regions->level - 1;
+    else
+    {
+        /* climb up from the given node as far as the next nodes are still in the left of the region
+         *
+         * it is faster than searching from the head node because the inserted region is often near to the given node
+         */
+        level = 0;
+        while (1)
+        {
+            // climb up this node 
+            while (     level + 1 < node->level 
+                    &&  (next = node->next[level + 1]) 
+                    &&  gb_tessellator_active_region_leq(&next->region, region)) 
+                level++;
+
+            // move to the next node at this level
+            next = node->next[level];
+            if (next && gb_tessellator_active_region_leq(&next->region, region)) node = next;
+            else break;
+        }
+    }
+
+    // walk down to the bottom level
+    while (1)
+    {
+        // move to the next nodes at this level
+        while ((next = node->next[level]) && gb_tessellator_active_region_leq(&next->region, region)) node = next;
+
+        // the bottom level?
+        tb_check_break(level);
+        level--;
+    }
+
+    // ok
+    return node;
+}
+/* insert region in ascending order after the given node
  *
  * r0 ----> r1 ------> r2 -------> r3 ---> ... ---->
  *                 region_prev
@@ -253,10 +372,11 @@ static tb_long_t gb_tessellator_active_region_printf(tb_cpointer_t object, tb_ch
  *                           insert
  *
  */
-static gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_done(gb_tessellator_impl_t* impl, tb_size_t prev, gb_tessellator_active_region_ref_t region)
+static gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_done(gb_tessellator_impl_t* impl, gb_tessellator_active_region_node_ref_t prev, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions && region && region->edge);
+    gb_tessellator_active_regions_impl_t* regions = (gb_tessellator_active_regions_impl_t*)impl->active_regions;
+    tb_assert(regions && prev && region && region->edge);
 
     // the edge must go up
     tb_assertf(gb_tessellator_edge_go_up(region->edge), "%{mesh_edge}", region->edge);
@@ -264,28 +384,48 @@ static gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_d
     // trace
     tb_trace_d("insert: %{mesh_edge}", region->edge);
 
-    // reverse to find the inserted position
-    tb_size_t itor = tb_find_if(impl->active_regions, prev, tb_iterator_tail(impl->active_regions), tb_predicate_beq, region);
+    // find the inserted position
+    prev = gb_tessellator_active_regions_search(regions, prev, region);
+    tb_assert(prev);
 
-    // trace
-    tb_trace_d("insert: find count: %lu", tb_distance(impl->active_regions, prev, itor));
+    // stat the regions
+    gb_tessellator_stats_add(impl, regions, 1);
+
+    // make a new node
+    gb_tessellator_active_region_node_ref_t node = (gb_tessellator_active_region_node_ref_t)gb_arena_malloc0(regions->arena);
+    tb_assert_and_check_return_val(node, tb_null);
 
-    // insert the region to the next position
-    itor = tb_list_insert_prev(impl->active_regions, itor, region);
-    tb_assert(itor != tb_iterator_tail(impl->active_regions));
+    // init the region and level
+    node->region    = *region;
+    node->level     = gb_tessellator_active_regions_level(regions);
 
-    // get the real region reference 
-    region = (gb_tessellator_active_region_ref_t)tb_iterator_item(impl->active_regions, itor);
-    tb_assert(region);
+    // grow the level of the skip list
+    while (regions->level < node->level) regions->head.next[regions->level++] = tb_null;
 
-    // save the region position
-    region->position = itor;
+    // insert it after the previous node at the bottom level
+    node->prev      = prev;
+    node->next[0]   = prev->next[0];
+    if (prev->next[0]) prev->next[0]->prev = node;
+    prev->next[0]   = node;
+
+    // insert it after the previous nodes at the upper levels
+    tb_size_t level;
+    for (level = 1; level < node->level; level++)
+    {
+        // walk back to the previous node at this level
+        while (prev->level <= level) prev = prev->prev;
+        tb_assert(prev);
+
+        // insert it
+        node->next[level] = prev->next[level];
+        prev->next[level] = node;
+    }
 
     // save the region reference to the edge
-    gb_tessellator_edge_region_set(region->edge, region);
+    gb_tessellator_edge_region_set(node->region.edge, &node->region);
 
     // ok
-    return region;
+    return &node->region;
 }
 /* insert region for the bounds in ascending order
  *
@@ -317,6 +457,7 @@ static tb_void_t gb_tessellator_active_regions_insert_bounds(gb_tessellator_impl
     gb_tessellator_active_region_t region;
     region.edge     = edge;
     region.winding  = 0;
+    region.dirty    = 0;
     region.inside   = 0;
     region.fixedge  = 0;
     region.bounds   = 1;
@@ -350,6 +491,7 @@ static tb_void_t gb_tessellator_active_regions_test_insert(gb_tessellator_impl_t
     gb_tessellator_active_region_t region;
     region.edge     = edge;
     region.winding  = 0;
+    region.dirty    = 0;
     region.inside   = 0;
     region.bounds   = 1;
 
@@ -379,10 +521,12 @@ static tb_void_t gb_tessellator_active_regions_test(gb_tessellator_impl_t* impl,
 
     // dump the codes for drawing
     tb_size_t index = 1;
-    tb_for_all_if (gb_tessellator_active_region_ref_t, region, impl->active_regions, region)
+    gb_tessellator_active_regions_impl_t*   regions = (gb_tessellator_active_regions_impl_t*)impl->active_regions;
+    gb_tessellator_active_region_node_ref_t node    = regions->head.next[0];
+    for (; node; node = node->next[0])
     {
         // the edge
-        gb_mesh_edge_ref_t edge = region->edge;
+        gb_mesh_edge_ref_t edge = node->region.edge;
 
         // the points
         gb_point_ref_t org = gb_tessellator_vertex_point(gb_mesh_edge_org(edge));
@@ -410,16 +554,18 @@ tb_bool_t gb_tessellator_active_regions_make(gb_tessellator_impl_t* impl, gb_rec
     // init active regions
     if (!impl->active_regions) 
     {
-        // make active region element
-        tb_element_t element = tb_element_mem(sizeof(gb_tessellator_active_region_t), tb_null, tb_null);
+        // make active regions
+        gb_tessellator_active_regions_impl_t* regions = tb_malloc0_type(gb_tessellator_active_regions_impl_t);
+        tb_assert_and_check_return_val(regions, tb_false);
 
-        // init the comparator 
-        element.comp = gb_tessellator_active_region_comp;
+        // save active regions
+        impl->active_regions = (gb_tessellator_active_regions_ref_t)regions;
 
-#ifdef __gb_debug__
-        // init the c-string function for tb_list_dump
-        element.cstr = gb_tessellator_active_region_cstr;
+        // init the nodes arena
+        regions->arena = gb_arena_init(GB_ACTIVE_REGIONS_GROW, sizeof(gb_tessellator_active_region_node_t));
+        tb_assert_and_check_return_val(regions->arena, tb_false);
 
+#ifdef __gb_debug__
         // register printf("%{tess_region}", region);
         static tb_bool_t s_is_registered = tb_false;
         if (!s_is_registered)
@@ -431,14 +577,18 @@ tb_bool_t gb_tessellator_active_regions_make(gb_tessellator_impl_t* impl, gb_rec
             s_is_registered = tb_true;
         }
 #endif
-
-        // make active regions
-        impl->active_regions = tb_list_init(0, element);
     }
-    tb_assert_and_check_return_val(impl->active_regions, tb_false);
 
-    // clear active regions first
-    tb_list_clear(impl->active_regions);
+    // the active regions
+    gb_tessellator_active_regions_impl_t* regions = (gb_tessellator_active_regions_impl_t*)impl->active_regions;
+    tb_assert_and_check_return_val(regions->arena, tb_false);
+
+    // clear active regions first, only reset the arena and keep its memory
+    gb_arena_clear(regions->arena);
+    regions->head.level     = GB_ACTIVE_REGIONS_LEVEL_MAXN;
+    regions->head.next[0]   = tb_null;
+    regions->level          = 1;
+    regions->seed           = 2463534242u;
 
     /* insert two regions for the bounds to avoid special cases
      *
@@ -463,12 +613,30 @@ tb_bool_t gb_tessellator_active_regions_make(gb_tessellator_impl_t* impl, gb_rec
 #endif
 
     // ok
-    return tb_list_size(impl->active_regions);
+    return regions->head.next[0] != tb_null;
+}
+tb_void_t gb_tessellator_active_regions_exit(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // the active regions
+    gb_tessellator_active_regions_impl_t* regions = (gb_tessellator_active_regions_impl_t*)impl->active_regions;
+    tb_check_return(regions);
+
+    // exit the nodes arena
+    if (regions->arena) gb_arena_exit(regions->arena);
+    regions->arena = tb_null;
+
+    // exit it
+    tb_free(regions);
+    impl->active_regions = tb_null;
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_find(gb_tessellator_impl_t* impl, gb_mesh_edge_ref_t edge)
 {
     // check
-    tb_assert(impl && impl->active_regions && edge);
+    gb_tessellator_active_regions_impl_t* regions = (gb_tessellator_active_regions_impl_t*)impl->active_regions;
+    tb_assert(regions && edge);
 
     // make a temporary region with the given edge for finding the real region containing it
     gb_tessellator_active_region_t region_temp;
@@ -477,7 +645,7 @@ gb_tessellator_active_region_ref_t gb_tessellator_active_regions_find(gb_tessell
     // the edge must go up
     tb_assertf(gb_tessellator_edge_go_up(edge), "%{mesh_edge}", edge);
 
-    /* reverse to find the region containing the given edge from the regions
+    /* find the last region which is in the left of the given edge from the regions
      *
      * region.edge
      * |
@@ -489,44 +657,41 @@ gb_tessellator_active_region_ref_t gb_tessellator_active_regions_find(gb_tessell
      * .       .        . region2  .
      * .     . edge     .
      *          |
-     *        found                <= find direction
+     *        found  
      *
      *
      */
-    tb_size_t itor = tb_rfind_all_if(impl->active_regions, tb_predicate_le, &region_temp);
+    gb_tessellator_active_region_node_ref_t node = gb_tessellator_active_regions_search(regions, &regions->head, &region_temp);
 
-    // get the found item
-    return (itor != tb_iterator_tail(impl->active_regions))? (gb_tessellator_active_region_ref_t)tb_iterator_item(impl->active_regions, itor) : tb_null;
+    // get the found region
+    return (node != &regions->head)? &node->region : tb_null;
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_left(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions);
-    tb_assert(region && region->position != tb_iterator_tail(impl->active_regions));
+    gb_tessellator_active_regions_impl_t* regions = (gb_tessellator_active_regions_impl_t*)impl->active_regions;
+    tb_assert(regions && region);
     
-    // get the prev position
-    tb_size_t position = tb_iterator_prev(impl->active_regions, region->position);
+    // get the previous node
+    gb_tessellator_active_region_node_ref_t prev = gb_tessellator_active_region_node(region)->prev;
+    tb_assert(prev);
 
     // no left region?
-    tb_check_return_val(position != tb_iterator_tail(impl->active_regions), tb_null);
+    tb_check_return_val(prev != &regions->head, tb_null);
 
     // ok
-    return (gb_tessellator_active_region_ref_t)tb_iterator_item(impl->active_regions, position);
+    return &prev->region;
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_right(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions);
-    tb_assert(region && region->position != tb_iterator_tail(impl->active_regions));
+    tb_assert(impl && impl->active_regions && region);
     
-    // get the next position
-    tb_size_t position = tb_iterator_next(impl->active_regions, region->position);
-
-    // no right region?
-    tb_check_return_val(position != tb_iterator_tail(impl->active_regions), tb_null);
+    // get the next node
+    gb_tessellator_active_region_node_ref_t next = gb_tessellator_active_region_node(region)->next[0];
 
     // ok
-    return (gb_tessellator_active_region_ref_t)tb_iterator_item(impl->active_regions, position);
+    return next? &next->region : tb_null;
 }
 tb_bool_t gb_tessellator_active_regions_in_left(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region1, gb_tessellator_active_region_ref_t region2)
 {
@@ -536,8 +701,8 @@ tb_bool_t gb_tessellator_active_regions_in_left(gb_tessellator_impl_t* impl, gb_
 tb_void_t gb_tessellator_active_regions_remove(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions && region && region->edge);
-    tb_assert(region->position != tb_iterator_tail(impl->active_regions));
+    gb_tessellator_active_regions_impl_t* regions = (gb_tessellator_active_regions_impl_t*)impl->active_regions;
+    tb_assert(regions && region && region->edge);
 
     // it can not be a real edge if the left edge need fix, then we will remove it 
     tb_assert(!region->fixedge || !gb_tessellator_edge_winding(region->edge));
@@ -545,52 +710,75 @@ tb_void_t gb_tessellator_active_regions_remove(gb_tessellator_impl_t* impl, gb_t
     // clear the region reference for the edge
     gb_tessellator_edge_region_set(region->edge, tb_null);
 
-    // remove it
-    tb_list_remove(impl->active_regions, region->position);
+    // remove it from the bottom level
+    gb_tessellator_active_region_node_ref_t node = gb_tessellator_active_region_node(region);
+    gb_tessellator_active_region_node_ref_t prev = node->prev;
+    tb_assert(prev && prev->next[0] == node);
+    prev->next[0] = node->next[0];
+    if (node->next[0]) node->next[0]->prev = prev;
+
+    // remove it from the upper levels
+    tb_size_t level;
+    for (level = 1; level < node->level; level++)
+    {
+        // walk back to the previous node at this level
+        while (prev->level <= level) prev = prev->prev;
+        tb_assert(prev && prev->next[level] == node);
+
+        // remove it
+        prev->next[level] = node->next[level];
+    }
+
+    // free it
+    gb_arena_free(regions->arena, node);
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions && region);
+    gb_tessellator_active_regions_impl_t* regions = (gb_tessellator_active_regions_impl_t*)impl->active_regions;
+    tb_assert(regions && region);
 
     // insert it
-    return gb_tessellator_active_regions_insert_done(impl, tb_iterator_head(impl->active_regions), region);
+    return gb_tessellator_active_regions_insert_done(impl, &regions->head, region);
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_after(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region_prev, gb_tessellator_active_region_ref_t region)
 {
     // check
     tb_assert(impl && impl->active_regions && region_prev && region);
-    tb_assert(region_prev->position != tb_iterator_tail(impl->active_regions));
 
     // region_prev <= region
-    tb_assert(tb_iterator_comp(impl->active_regions, region_prev, region) <= 0);
+    tb_assert(gb_tessellator_active_region_leq(region_prev, region));
 
     // insert it
-    return gb_tessellator_active_regions_insert_done(impl, region_prev->position, region);
+    return gb_tessellator_active_regions_insert_done(impl, gb_tessellator_active_region_node(region_prev), region);
 }
 #ifdef __gb_debug__
 tb_void_t gb_tessellator_active_regions_check(gb_tessellator_impl_t* impl)
 {
     // check
-    tb_assert(impl && impl->active_regions);
+    gb_tessellator_active_regions_impl_t* regions = (gb_tessellator_active_regions_impl_t*)impl->active_regions;
+    tb_assert(regions);
 
     // done
-    gb_tessellator_active_region_ref_t region_prev = tb_null;
-    tb_for_all_if (gb_tessellator_active_region_ref_t, region, impl->active_regions, region)
+    gb_tessellator_active_region_node_ref_t node = regions->head.next[0];
+    gb_tessellator_active_region_ref_t      region_prev = tb_null;
+    for (; node; node = node->next[0])
     {
+        // the region
+        gb_tessellator_active_region_ref_t region = &node->region;
+
         // check order
         if (region_prev)
         {
             // the order is error?
-            if (tb_iterator_comp(impl->active_regions, region_prev, region) > 0)
+            if (!gb_tessellator_active_region_leq(region_prev, region))
             {
                 // trace
                 tb_trace_i("the order of the active regions is error with event: %{mesh_vertex}", impl->event);
 
                 // dump it
-#           ifdef __tb_debug__
-                tb_list_dump(impl->active_regions);
-#           endif
+                gb_tessellator_active_region_node_ref_t item = regions->head.next[0];
+                for (; item; item = item->next[0]) tb_trace_i("%{tess_region}.%{mesh_edge}", &item->region, item->region.edge);
 
                 // trace
                 tb_trace_i("%{mesh_edge}", region_prev->edge);
@@ -602,6 +790,9 @@ tb_void_t gb_tessellator_active_regions_check(gb_tessellator_impl_t* impl)
             }
         }
 
+        // the previous node must be linked
+        tb_assert(node->prev && node->prev->next[0] == node);
+
         // the edge must go up
         tb_assertf(gb_tessellator_edge_go_up(region->edge), "%{mesh_edge}", region->edge);
 
@@ -610,4 +801,3 @@ tb_void_t gb_tessellator_active_regions_check(gb_tessellator_impl_t* impl)
     }
 }
 #endif
-
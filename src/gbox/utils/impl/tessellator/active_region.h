@@ -48,6 +48,12 @@ __tb_extern_c_enter__
  */
 tb_bool_t                           gb_tessellator_active_regions_make(gb_tessellator_impl_t* impl, gb_rect_ref_t bounds);
 
+/* exit the active regions
+ *
+ * @param impl                      the tessellator impl
+ */
+tb_void_t                           gb_tessellator_active_regions_exit(gb_tessellator_impl_t* impl);
+
 /* find the region containing the given edge from the regions
  *
  *         =>
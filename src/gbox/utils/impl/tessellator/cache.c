@@ -0,0 +1,470 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        cache.c
+ * @ingroup     utils
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "cache"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "cache.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the buckets count, must be power of 2
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_CACHE_BUCKET_MAXN         (64)
+#else
+#   define GB_TESSELLATOR_CACHE_BUCKET_MAXN         (256)
+#endif
+
+// the recorded outputs grow
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_CACHE_OUTPUTS_GROW        (64)
+#else
+#   define GB_TESSELLATOR_CACHE_OUTPUTS_GROW        (256)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the tessellator cache entry type
+ *
+ * the data are allocated after this entry:
+ *
+ * polygon points: gb_point_t[points_count]
+ * outputs points: gb_point_t[outputs_count]
+ * polygon counts: tb_uint16_t[counts_count]
+ * outputs counts: tb_uint16_t[contours_count]
+ */
+typedef struct __gb_tessellator_cache_entry_t
+{
+    // the list entry for lru
+    tb_list_entry_t                         entry;
+
+    // the next entry at the same bucket
+    struct __gb_tessellator_cache_entry_t*  next;
+
+    // the hash
+    tb_size_t                               hash;
+
+    // the points count of the polygon
+    tb_size_t                               points_count;
+
+    // the counts count of the polygon, not including the end zero
+    tb_size_t                               counts_count;
+
+    // the points count of all output contours
+    tb_size_t                               outputs_count;
+
+    // the output contours count
+    tb_size_t                               contours_count;
+
+    // the rule
+    tb_uint8_t                              rule;
+
+    // the mode
+    tb_uint8_t                              mode;
+
+    // is convex polygon?
+    tb_uint8_t                              convex;
+
+}gb_tessellator_cache_entry_t, *gb_tessellator_cache_entry_ref_t;
+
+// the tessellator cache impl type
+typedef struct __gb_tessellator_cache_impl_t
+{
+    // the maximum memory size
+    tb_size_t                               maxn;
+
+    // the current memory size
+    tb_size_t                               size;
+
+    // the lru list, the head is the most recently used entry
+    tb_list_entry_head_t                    lru;
+
+    // the buckets
+    gb_tessellator_cache_entry_ref_t        buckets[GB_TESSELLATOR_CACHE_BUCKET_MAXN];
+
+    // the key of the recording polygon
+    gb_tessellator_cache_entry_t            key;
+
+    // is recording now?
+    tb_bool_t                               recording;
+
+    // the recorded outputs are discarded?
+    tb_bool_t                               discarded;
+
+    // the recorded output points, gb_point_t[]
+    tb_vector_ref_t                         points;
+
+    // the recorded output counts, tb_uint16_t[]
+    tb_vector_ref_t                         counts;
+
+    // the hooked tessellator func
+    gb_tessellator_func_t                   func;
+
+    // the hooked user private data
+    tb_cpointer_t                           priv;
+
+}gb_tessellator_cache_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_size_t gb_tessellator_cache_hash(gb_tessellator_cache_entry_ref_t key, gb_polygon_ref_t polygon)
+{
+    // check
+    tb_assert(key && polygon && polygon->points && polygon->counts);
+
+    // done fnv-1a for the words of the counts and points
+    tb_size_t           i = 0;
+    tb_uint32_t         hash = 2166136261u;
+    tb_uint16_t const*  counts = polygon->counts;
+    tb_uint32_t const*  words = (tb_uint32_t const*)polygon->points;
+    tb_size_t           words_count = key->points_count * (sizeof(gb_point_t) / sizeof(tb_uint32_t));
+    for (i = 0; i < key->counts_count; i++) hash = (hash ^ counts[i]) * 16777619u;
+    for (i = 0; i < words_count; i++) hash = (hash ^ words[i]) * 16777619u;
+    hash = (hash ^ key->rule) * 16777619u;
+    hash = (hash ^ key->mode) * 16777619u;
+    hash = (hash ^ key->convex) * 16777619u;
+
+    /* mix the high bits to the low bits for the bucket index
+     *
+     * the low bits of the words are only mixed to the low bits of the hash,
+     * but they are usually the same for the fixed-point coordinates
+     */
+    hash ^= hash >> 16;
+
+    // ok
+    return (tb_size_t)hash;
+}
+static __tb_inline__ gb_point_ref_t gb_tessellator_cache_entry_points(gb_tessellator_cache_entry_ref_t entry)
+{
+    return (gb_point_ref_t)(entry + 1);
+}
+static __tb_inline__ gb_point_ref_t gb_tessellator_cache_entry_outputs(gb_tessellator_cache_entry_ref_t entry)
+{
+    return gb_tessellator_cache_entry_points(entry) + entry->points_count;
+}
+static __tb_inline__ tb_uint16_t* gb_tessellator_cache_entry_counts(gb_tessellator_cache_entry_ref_t entry)
+{
+    return (tb_uint16_t*)(gb_tessellator_cache_entry_outputs(entry) + entry->outputs_count);
+}
+static __tb_inline__ tb_uint16_t* gb_tessellator_cache_entry_contours(gb_tessellator_cache_entry_ref_t entry)
+{
+    return gb_tessellator_cache_entry_counts(entry) + entry->counts_count;
+}
+static tb_size_t gb_tessellator_cache_entry_size(gb_tessellator_cache_entry_ref_t entry)
+{
+    // the memory size of the entry and its data
+    return      sizeof(gb_tessellator_cache_entry_t) 
+            +   (entry->points_count + entry->outputs_count) * sizeof(gb_point_t) 
+            +   (entry->counts_count + entry->contours_count) * sizeof(tb_uint16_t);
+}
+static tb_bool_t gb_tessellator_cache_entry_eq(gb_tessellator_cache_entry_ref_t entry, gb_tessellator_cache_entry_ref_t key, gb_polygon_ref_t polygon)
+{
+    // check
+    tb_assert(entry && key && polygon);
+
+    // the key is equal?
+    tb_check_return_val(    entry->hash == key->hash
+                        &&  entry->points_count == key->points_count
+                        &&  entry->counts_count == key->counts_count
+                        &&  entry->rule == key->rule
+                        &&  entry->mode == key->mode
+                        &&  entry->convex == key->convex, tb_false);
+
+    // the counts and points are equal? 
+    return      !tb_memcmp(gb_tessellator_cache_entry_counts(entry), polygon->counts, entry->counts_count * sizeof(tb_uint16_t))
+            &&  !tb_memcmp(gb_tessellator_cache_entry_points(entry), polygon->points, entry->points_count * sizeof(gb_point_t));
+}
+static tb_void_t gb_tessellator_cache_entry_exit(gb_tessellator_cache_impl_t* impl, gb_tessellator_cache_entry_ref_t entry)
+{
+    // check
+    tb_assert(impl && entry);
+
+    // remove it from the bucket
+    gb_tessellator_cache_entry_ref_t* pentry = &impl->buckets[entry->hash & (GB_TESSELLATOR_CACHE_BUCKET_MAXN - 1)];
+    while (*pentry && *pentry != entry) pentry = &(*pentry)->next;
+    tb_assert(*pentry == entry);
+    if (*pentry) *pentry = entry->next;
+
+    // remove it from the lru list
+    tb_list_entry_remove(&impl->lru, &entry->entry);
+
+    // update the memory size
+    tb_assert(impl->size >= gb_tessellator_cache_entry_size(entry));
+    impl->size -= gb_tessellator_cache_entry_size(entry);
+
+    // exit it
+    tb_free(entry);
+}
+static tb_void_t gb_tessellator_cache_reserve(gb_tessellator_cache_impl_t* impl, tb_size_t size)
+{
+    // check
+    tb_assert(impl);
+
+    // remove the least recently used entries until the given size is enough
+    while (impl->size + size > impl->maxn && tb_list_entry_size(&impl->lru))
+    {
+        // the last entry
+        gb_tessellator_cache_entry_ref_t entry = (gb_tessellator_cache_entry_ref_t)tb_list_entry(&impl->lru, tb_list_entry_last(&impl->lru));
+        tb_assert(entry);
+
+        // exit it
+        gb_tessellator_cache_entry_exit(impl, entry);
+    }
+}
+static tb_void_t gb_tessellator_cache_record(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_tessellator_cache_impl_t* impl = (gb_tessellator_cache_impl_t*)priv;
+    tb_assert(impl && impl->func && impl->points && impl->counts && points && count);
+
+    // record the points of this contour
+    tb_size_t size = tb_vector_size(impl->points);
+    if (tb_vector_resize(impl->points, size + count))
+        tb_memcpy((gb_point_ref_t)tb_vector_data(impl->points) + size, points, count * sizeof(gb_point_t));
+    // failed? discard all outputs
+    else impl->discarded = tb_true;
+
+    // record the points count of this contour
+    tb_vector_insert_tail(impl->counts, tb_u2p(count));
+
+    // done the hooked func
+    impl->func(points, count, impl->priv);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_tessellator_cache_ref_t gb_tessellator_cache_init(tb_size_t maxn)
+{
+    // done
+    tb_bool_t                       ok = tb_false;
+    gb_tessellator_cache_impl_t*    impl = tb_null;
+    do
+    {
+        // make cache
+        impl = tb_malloc0_type(gb_tessellator_cache_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init maxn
+        impl->maxn = maxn;
+
+        // init lru
+        tb_list_entry_init(&impl->lru, gb_tessellator_cache_entry_t, entry, tb_null);
+
+        // init points
+        impl->points = tb_vector_init(GB_TESSELLATOR_CACHE_OUTPUTS_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
+        tb_assert_and_check_break(impl->points);
+
+        // init counts
+        impl->counts = tb_vector_init(GB_TESSELLATOR_CACHE_OUTPUTS_GROW, tb_element_uint16());
+        tb_assert_and_check_break(impl->counts);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_tessellator_cache_exit((gb_tessellator_cache_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_tessellator_cache_ref_t)impl;
+}
+tb_void_t gb_tessellator_cache_exit(gb_tessellator_cache_ref_t cache)
+{
+    // check
+    gb_tessellator_cache_impl_t* impl = (gb_tessellator_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // clear it
+    gb_tessellator_cache_clear(cache);
+
+    // exit points
+    if (impl->points) tb_vector_exit(impl->points);
+    impl->points = tb_null;
+
+    // exit counts
+    if (impl->counts) tb_vector_exit(impl->counts);
+    impl->counts = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_tessellator_cache_clear(gb_tessellator_cache_ref_t cache)
+{
+    // check
+    gb_tessellator_cache_impl_t* impl = (gb_tessellator_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // exit all entries
+    tb_size_t i = 0;
+    for (i = 0; i < GB_TESSELLATOR_CACHE_BUCKET_MAXN; i++)
+    {
+        gb_tessellator_cache_entry_ref_t entry = impl->buckets[i];
+        while (entry)
+        {
+            gb_tessellator_cache_entry_ref_t next = entry->next;
+            tb_free(entry);
+            entry = next;
+        }
+        impl->buckets[i] = tb_null;
+    }
+
+    // clear lru
+    tb_list_entry_clear(&impl->lru);
+
+    // clear the memory size
+    impl->size = 0;
+}
+tb_bool_t gb_tessellator_cache_done(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon)
+{
+    // check
+    gb_tessellator_cache_impl_t* cache = (gb_tessellator_cache_impl_t*)impl->cache;
+    tb_assert_and_check_return_val(cache && impl->func && polygon && polygon->points && polygon->counts, tb_false);
+
+    // no memory for caching?
+    cache->recording = tb_false;
+    tb_check_return_val(cache->maxn, tb_false);
+
+    // make key
+    gb_tessellator_cache_entry_t* key = &cache->key;
+    tb_memset(key, 0, sizeof(gb_tessellator_cache_entry_t));
+    tb_uint16_t const* counts = polygon->counts;
+    while (*counts) key->points_count += *counts++;
+    key->counts_count   = counts - polygon->counts;
+    key->rule           = (tb_uint8_t)impl->rule;
+    key->mode           = (tb_uint8_t)impl->mode;
+    key->convex         = (tb_uint8_t)polygon->convex;
+
+    // the polygon is too large? 
+    tb_check_return_val(gb_tessellator_cache_entry_size(key) <= (cache->maxn >> 2), tb_false);
+
+    // find the entry
+    key->hash = gb_tessellator_cache_hash(key, polygon);
+    gb_tessellator_cache_entry_ref_t entry = cache->buckets[key->hash & (GB_TESSELLATOR_CACHE_BUCKET_MAXN - 1)];
+    while (entry && !gb_tessellator_cache_entry_eq(entry, key, polygon)) entry = entry->next;
+
+    // cached? 
+    if (entry)
+    {
+        // move it to the head of the lru list
+        tb_list_entry_moveto_head(&cache->lru, &entry->entry);
+
+        // done func for all cached contours
+        tb_size_t       i = 0;
+        tb_uint16_t*    contours = gb_tessellator_cache_entry_contours(entry);
+        gb_point_ref_t  outputs = gb_tessellator_cache_entry_outputs(entry);
+        for (i = 0; i < entry->contours_count; i++)
+        {
+            impl->func(outputs, contours[i], impl->priv);
+            outputs += contours[i];
+        }
+
+        // ok
+        return tb_true;
+    }
+
+    // clear the recorded outputs
+    tb_vector_clear(cache->points);
+    tb_vector_clear(cache->counts);
+
+    // hook the tessellator func for recording the outputs
+    cache->func         = impl->func;
+    cache->priv         = impl->priv;
+    cache->recording    = tb_true;
+    cache->discarded    = tb_false;
+    impl->func          = gb_tessellator_cache_record;
+    impl->priv          = cache;
+
+    // not cached now
+    return tb_false;
+}
+tb_void_t gb_tessellator_cache_save(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon)
+{
+    // check
+    gb_tessellator_cache_impl_t* cache = (gb_tessellator_cache_impl_t*)impl->cache;
+    tb_assert_and_check_return(cache && polygon);
+
+    // not recording?
+    tb_check_return(cache->recording);
+    cache->recording = tb_false;
+
+    // restore the tessellator func
+    impl->func = cache->func;
+    impl->priv = cache->priv;
+
+    // the recorded outputs have been discarded?
+    tb_check_return(!cache->discarded);
+
+    // the key
+    gb_tessellator_cache_entry_t* key = &cache->key;
+    key->outputs_count  = tb_vector_size(cache->points);
+    key->contours_count = tb_vector_size(cache->counts);
+
+    // the outputs are too large?
+    tb_size_t size = gb_tessellator_cache_entry_size(key);
+    tb_check_return(size <= (cache->maxn >> 2));
+
+    // remove the old entries if the memory is not enough
+    gb_tessellator_cache_reserve(cache, size);
+
+    // make entry
+    gb_tessellator_cache_entry_ref_t entry = (gb_tessellator_cache_entry_ref_t)tb_malloc(size);
+    tb_assert_and_check_return(entry);
+
+    // init entry
+    *entry = *key;
+    tb_memcpy(gb_tessellator_cache_entry_points(entry), polygon->points, entry->points_count * sizeof(gb_point_t));
+    tb_memcpy(gb_tessellator_cache_entry_counts(entry), polygon->counts, entry->counts_count * sizeof(tb_uint16_t));
+    if (entry->outputs_count) tb_memcpy(gb_tessellator_cache_entry_outputs(entry), tb_vector_data(cache->points), entry->outputs_count * sizeof(gb_point_t));
+    if (entry->contours_count) tb_memcpy(gb_tessellator_cache_entry_contours(entry), tb_vector_data(cache->counts), entry->contours_count * sizeof(tb_uint16_t));
+
+    // insert it to the bucket
+    gb_tessellator_cache_entry_ref_t* bucket = &cache->buckets[entry->hash & (GB_TESSELLATOR_CACHE_BUCKET_MAXN - 1)];
+    entry->next = *bucket;
+    *bucket = entry;
+
+    // insert it to the head of the lru list
+    tb_list_entry_insert_head(&cache->lru, &entry->entry);
+
+    // update the memory size
+    cache->size += size;
+}
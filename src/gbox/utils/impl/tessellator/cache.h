@@ -0,0 +1,89 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        cache.h
+ * @ingroup     utils
+ */
+#ifndef GB_UTILS_IMPL_TESSELLATOR_CACHE_H
+#define GB_UTILS_IMPL_TESSELLATOR_CACHE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the tessellator cache
+ *
+ * cache: (polygon points and counts, rule, mode) => the output contours
+ *
+ * @param maxn                      the maximum memory size of all cached outputs
+ *
+ * @return                          the cache
+ */
+gb_tessellator_cache_ref_t          gb_tessellator_cache_init(tb_size_t maxn);
+
+/* exit the tessellator cache
+ *
+ * @param cache                     the cache
+ */
+tb_void_t                           gb_tessellator_cache_exit(gb_tessellator_cache_ref_t cache);
+
+/* clear the tessellator cache
+ *
+ * @param cache                     the cache
+ */
+tb_void_t                           gb_tessellator_cache_clear(gb_tessellator_cache_ref_t cache);
+
+/* done the tessellator from the cache
+ *
+ * the cached outputs will be passed to the tessellator func if the polygon has been cached,
+ * otherwise we hook the tessellator func for recording the outputs 
+ * and they will be cached at gb_tessellator_cache_save()
+ *
+ * @param impl                      the tessellator impl
+ * @param polygon                   the polygon
+ *
+ * @return                          tb_true if the polygon has been cached, otherwise tb_false
+ */
+tb_bool_t                           gb_tessellator_cache_done(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon);
+
+/* save the recorded outputs of the polygon to the cache and restore the tessellator func
+ *
+ * @param impl                      the tessellator impl
+ * @param polygon                   the polygon
+ */
+tb_void_t                           gb_tessellator_cache_save(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -35,6 +35,20 @@
 #include "event_queue.h"
 #include "geometry.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the sorted events grow
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_EVENT_SORTED_GROW     (256)
+#else
+#   define GB_TESSELLATOR_EVENT_SORTED_GROW     (1024)
+#endif
+
+// the events will be sorted using the insertion sort if the count is less than it
+#define GB_TESSELLATOR_EVENT_SORTED_SMALL       (32)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -72,6 +86,167 @@ static tb_char_t const* gb_tessellator_event_queue_cstr(tb_element_ref_t element
     return cstr;
 }
 #endif
+static __tb_inline__ tb_uint32_t gb_tessellator_event_queue_key_float(gb_float_t value)
+{
+#ifdef GB_CONFIG_FLOAT_FIXED
+    // the biased fixed value as unsigned key
+    return (tb_uint32_t)value ^ 0x80000000;
+#else
+    // -0.0 and 0.0 are the same position
+    if (value == 0) return 0x80000000;
+
+    // the float bits
+    union { tb_float_t f; tb_uint32_t u; } bits;
+    bits.f = value;
+
+    // flip all bits of the negative value and only the sign bit of the positive value
+    return (bits.u & 0x80000000)? ~bits.u : (bits.u | 0x80000000);
+#endif
+}
+static __tb_inline__ tb_uint64_t gb_tessellator_event_queue_key(gb_mesh_vertex_ref_t event)
+{
+    // the point
+    gb_point_ref_t point = gb_tessellator_vertex_point(event);
+    tb_assert(point);
+
+    // make the key of (y, x) which has the same order as gb_tessellator_vertex_leq()
+    return ((tb_uint64_t)gb_tessellator_event_queue_key_float(point->y) << 32) | gb_tessellator_event_queue_key_float(point->x);
+}
+static tb_bool_t gb_tessellator_event_queue_sorted_init(gb_tessellator_impl_t* impl, tb_size_t maxn)
+{
+    // check
+    tb_assert(impl && maxn);
+
+    // grow the sorted events
+    if (maxn > impl->event_sorted_maxn)
+    {
+        /* make the sorted events data
+         *
+         * keys: [maxn], keys of the radix sort: [maxn], events: [maxn], events of the radix sort: [maxn]
+         */
+        maxn += GB_TESSELLATOR_EVENT_SORTED_GROW;
+        if (impl->event_sorted_keys) tb_free(impl->event_sorted_keys);
+        impl->event_sorted_keys = (tb_uint64_t*)tb_malloc(maxn * ((sizeof(tb_uint64_t) + sizeof(gb_mesh_vertex_ref_t)) << 1));
+        impl->event_sorted      = tb_null;
+        impl->event_sorted_maxn = 0;
+        tb_assert_and_check_return_val(impl->event_sorted_keys, tb_false);
+
+        // init the sorted events
+        impl->event_sorted      = (gb_mesh_vertex_ref_t*)(impl->event_sorted_keys + (maxn << 1));
+        impl->event_sorted_maxn = maxn;
+    }
+
+    // clear the sorted events
+    impl->event_sorted_head = 0;
+    impl->event_sorted_size = 0;
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_tessellator_event_queue_sorted_sort(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->event_sorted_keys && impl->event_sorted);
+
+    // the sorted events
+    tb_size_t               i;
+    tb_size_t               j;
+    tb_uint64_t             key;
+    gb_mesh_vertex_ref_t    event;
+    tb_size_t               size    = impl->event_sorted_size;
+    tb_uint64_t*            keys    = impl->event_sorted_keys;
+    gb_mesh_vertex_ref_t*   events  = impl->event_sorted;
+
+    // only a few events? sort them using the insertion sort
+    if (size < GB_TESSELLATOR_EVENT_SORTED_SMALL)
+    {
+        for (i = 1; i < size; i++)
+        {
+            // insert this event to the sorted events
+            key     = keys[i];
+            event   = events[i];
+            for (j = i; j && keys[j - 1] > key; j--)
+            {
+                keys[j]     = keys[j - 1];
+                events[j]   = events[j - 1];
+            }
+            keys[j]     = key;
+            events[j]   = event;
+        }
+        return ;
+    }
+
+    // make the histograms of all digits
+    tb_uint32_t histograms[8][256];
+    tb_memset(histograms, 0, sizeof(histograms));
+    for (i = 0; i < size; i++)
+    {
+        key = keys[i];
+        for (j = 0; j < 8; j++, key >>= 8) histograms[j][key & 0xff]++;
+    }
+
+    // sort them using the lsd radix sort, the order of the same keys will be kept
+    tb_size_t               shift;
+    tb_uint32_t             offset;
+    tb_uint32_t             count;
+    tb_uint32_t*            histogram;
+    tb_uint64_t*            keys_temp   = keys + impl->event_sorted_maxn;
+    gb_mesh_vertex_ref_t*   events_temp = events + impl->event_sorted_maxn;
+    for (j = 0, shift = 0; j < 8; j++, shift += 8)
+    {
+        // all keys have the same digit? skip it
+        histogram = histograms[j];
+        if (histogram[(keys[0] >> shift) & 0xff] == size) continue;
+
+        // make the offsets of the digits
+        for (i = 0, offset = 0; i < 256; i++)
+        {
+            count           = histogram[i];
+            histogram[i]    = offset;
+            offset          += count;
+        }
+
+        // scatter the events by this digit
+        for (i = 0; i < size; i++)
+        {
+            offset              = histogram[(keys[i] >> shift) & 0xff]++;
+            keys_temp[offset]   = keys[i];
+            events_temp[offset] = events[i];
+        }
+
+        // swap the keys and events
+        tb_swap(tb_uint64_t*, keys, keys_temp);
+        tb_swap(gb_mesh_vertex_ref_t*, events, events_temp);
+    }
+
+    // copy the sorted keys and events back if they are in the temporary data
+    if (keys != impl->event_sorted_keys)
+    {
+        tb_memcpy(impl->event_sorted_keys, keys, size * sizeof(tb_uint64_t));
+        tb_memcpy(impl->event_sorted, events, size * sizeof(gb_mesh_vertex_ref_t));
+    }
+}
+static __tb_inline__ tb_bool_t gb_tessellator_event_queue_from_heap(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->event_queue);
+
+    // skip the removed events at the head of the sorted events
+    gb_mesh_vertex_ref_t*   events  = impl->event_sorted;
+    tb_size_t               head    = impl->event_sorted_head;
+    tb_size_t               size    = impl->event_sorted_size;
+    while (head < size && !events[head]) head++;
+    impl->event_sorted_head = head;
+
+    // no intersection events? get it from the sorted events
+    if (!tb_priority_queue_size(impl->event_queue)) return tb_false;
+
+    // no sorted events? get it from the heap
+    if (head == size) return tb_true;
+
+    // get the minimum event from the heap if it is less than the minimum sorted event
+    return gb_tessellator_event_queue_comp(tb_null, tb_priority_queue_get(impl->event_queue), events[head]) < 0;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -85,7 +260,7 @@ tb_bool_t gb_tessellator_event_queue_make(gb_tessellator_impl_t* impl)
     gb_mesh_ref_t mesh = impl->mesh;
     tb_assert(mesh);
 
-    // init event queue
+    // init event queue for the new intersection vertices
     if (!impl->event_queue) 
     {
         // make event element
@@ -107,22 +282,56 @@ tb_bool_t gb_tessellator_event_queue_make(gb_tessellator_impl_t* impl)
     // clear event queue first
     tb_priority_queue_clear(impl->event_queue);
 
-    // done
-    tb_for_all_if (gb_mesh_vertex_ref_t, vertex, gb_mesh_vertex_itor(mesh), vertex)
+    // init the sorted events
+    tb_iterator_ref_t iterator = gb_mesh_vertex_itor(mesh);
+    tb_size_t size = tb_iterator_size(iterator);
+    tb_check_return_val(size, tb_false);
+    if (!gb_tessellator_event_queue_sorted_init(impl, size)) return tb_false;
+
+    // put all vertex events and their keys to the sorted events
+    tb_uint64_t*            keys    = impl->event_sorted_keys;
+    gb_mesh_vertex_ref_t*   events  = impl->event_sorted;
+    tb_for_all_if (gb_mesh_vertex_ref_t, vertex, iterator, vertex)
     {
-        // put vertex event to the queue
-        tb_priority_queue_put(impl->event_queue, vertex);
+        // check
+        tb_assert(impl->event_sorted_size < impl->event_sorted_maxn);
+
+        // put vertex event
+        keys[impl->event_sorted_size]   = gb_tessellator_event_queue_key(vertex);
+        events[impl->event_sorted_size] = vertex;
+        impl->event_sorted_size++;
     }
 
+    // sort all vertex events at once
+    gb_tessellator_event_queue_sorted_sort(impl);
+
     // ok
-    return tb_priority_queue_size(impl->event_queue);
+    return impl->event_sorted_size;
+}
+gb_mesh_vertex_ref_t gb_tessellator_event_queue_get(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->event_queue);
+
+    // get the minimum event from the heap or the sorted events
+    if (gb_tessellator_event_queue_from_heap(impl)) return (gb_mesh_vertex_ref_t)tb_priority_queue_get(impl->event_queue);
+    return impl->event_sorted_head < impl->event_sorted_size? impl->event_sorted[impl->event_sorted_head] : tb_null;
+}
+tb_void_t gb_tessellator_event_queue_pop(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->event_queue);
+
+    // pop the minimum event from the heap or the sorted events
+    if (gb_tessellator_event_queue_from_heap(impl)) tb_priority_queue_pop(impl->event_queue);
+    else if (impl->event_sorted_head < impl->event_sorted_size) impl->event_sorted_head++;
 }
 tb_void_t gb_tessellator_event_queue_insert(gb_tessellator_impl_t* impl, gb_mesh_vertex_ref_t event)
 {
     // check
     tb_assert(impl && impl->event_queue && event);
 
-    // insert this event
+    // insert this intersection event to the heap
     tb_priority_queue_put(impl->event_queue, event);
 }
 tb_void_t gb_tessellator_event_queue_remove(gb_tessellator_impl_t* impl, gb_mesh_vertex_ref_t event)
@@ -130,7 +339,31 @@ tb_void_t gb_tessellator_event_queue_remove(gb_tessellator_impl_t* impl, gb_mesh
     // check
     tb_assert(impl && impl->event_queue && event);
 
-    // find it
+    // find the first sorted event with the same key using the binary search
+    tb_uint64_t             key     = gb_tessellator_event_queue_key(event);
+    tb_uint64_t*            keys    = impl->event_sorted_keys;
+    gb_mesh_vertex_ref_t*   events  = impl->event_sorted;
+    tb_size_t               head    = impl->event_sorted_head;
+    tb_size_t               tail    = impl->event_sorted_size;
+    tb_size_t               middle  = 0;
+    while (head < tail)
+    {
+        middle = head + ((tail - head) >> 1);
+        if (keys[middle] < key) head = middle + 1;
+        else tail = middle;
+    }
+
+    // remove it from the sorted events if be found, the keys are kept for the binary search
+    for (tail = impl->event_sorted_size; head < tail && keys[head] == key; head++)
+    {
+        if (events[head] == event) 
+        {
+            events[head] = tb_null;
+            return ;
+        }
+    }
+
+    // find it from the heap
     tb_size_t itor = tb_find_all_if(impl->event_queue, gb_tessellator_event_queue_find, event);
     if (itor != tb_iterator_tail(impl->event_queue))
     {
@@ -152,8 +152,12 @@ tb_bool_t gb_tessellator_mesh_make(gb_tessellator_impl_t* impl, gb_polygon_ref_t
         vertex_element.cstr    = gb_tessellator_vertex_cstr;
 #endif
 
-        // init mesh
-        impl->mesh = gb_mesh_init(edge_element, face_element, vertex_element);
+        /* init mesh using the arenas
+         *
+         * the mesh will be cleared for each tessellation, 
+         * so we reset it in O(1) and reuse the memory of the previous frame
+         */
+        impl->mesh = gb_mesh_init_arena(edge_element, face_element, vertex_element);
 
         /* init the order
          *
@@ -1675,7 +1675,7 @@ static tb_bool_t gb_tessellator_fix_region_intersection_errors(gb_tessellator_im
  *                 .     .
  *              .          .
  */
-static tb_bool_t gb_tessellator_fix_region_intersection(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region_left)
+static tb_bool_t gb_tessellator_fix_region_intersection_done(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region_left)
 {
     // check
     tb_assert(impl && impl->mesh && region_left);
@@ -2087,6 +2087,9 @@ static tb_bool_t gb_tessellator_fix_region_intersection(gb_tessellator_impl_t* i
         gb_tessellator_profiler_add_inter(gb_mesh_edge_org(edge_right));
 #endif
 
+        // stat the intersections
+        gb_tessellator_stats_add(impl, intersections, 1);
+
         // insert the new intersection vertex to the event queue
         gb_tessellator_event_queue_insert(impl, gb_mesh_edge_org(edge_right));
 
@@ -2116,6 +2119,23 @@ static tb_bool_t gb_tessellator_fix_region_intersection(gb_tessellator_impl_t* i
     // no recursion
     return tb_false;
 }
+static tb_bool_t gb_tessellator_fix_region_intersection(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region_left)
+{
+    // check
+    tb_assert(impl);
+
+    // only stat the time of the outermost fixing, it may be called recursively
+    tb_hong_t time = impl->stats_fixing++? 0 : gb_tessellator_stats_time(impl);
+
+    // fix the intersection
+    tb_bool_t ok = gb_tessellator_fix_region_intersection_done(impl, region_left);
+
+    // stat the time
+    if (!--impl->stats_fixing) gb_tessellator_stats_time_add(impl, intersection, time);
+
+    // ok?
+    return ok;
+}
 /* fix all dirty regions which order have been violated
  * and some new dirty regions may be created when we are fixing.
  *
@@ -2583,6 +2603,7 @@ static gb_tessellator_active_region_ref_t gb_tessellator_insert_region_at_right(
     gb_tessellator_active_region_t region;
     region.edge     = edge_new;
     region.winding  = 0;
+    region.dirty    = 0;
     region.inside   = 0;
     region.bounds   = 0;
     region.fixedge  = 0;
@@ -4369,40 +4390,35 @@ tb_void_t gb_tessellator_monotone_make(gb_tessellator_impl_t* impl, gb_rect_ref_
     tb_assert(mesh);
 
     // remove degenerate edges
+    tb_hong_t time = gb_tessellator_stats_time(impl);
     gb_tessellator_remove_degenerate_edges(impl);
+    gb_tessellator_stats_time_add(impl, degenerate, time);
 
     // make event queue
+    time = gb_tessellator_stats_time(impl);
     if (!gb_tessellator_event_queue_make(impl)) return ;
+    gb_tessellator_stats_time_add(impl, event_queue, time);
 
-    // make active regions
+    // make active regions, it is counted in the sweep time
+    time = gb_tessellator_stats_time(impl);
     if (!gb_tessellator_active_regions_make(impl, bounds)) return ;
 
-    // the event queue
-    tb_priority_queue_ref_t event_queue = impl->event_queue;
-    tb_assert(event_queue);
-
     // done
-    while (tb_priority_queue_size(event_queue))
+    gb_mesh_vertex_ref_t event      = tb_null;
+    gb_mesh_vertex_ref_t event_next = tb_null;
+    while ((event = gb_tessellator_event_queue_get(impl)))
     {
-        // get the minimum vertex event
-        gb_mesh_vertex_ref_t event = (gb_mesh_vertex_ref_t)tb_priority_queue_get(event_queue);
-        tb_assert(event);
-
         // pop it from the event queue first
-        tb_priority_queue_pop(event_queue);
+        gb_tessellator_event_queue_pop(impl);
 
         // attempt to merge all vertices at same position as mush as possible
-        while (tb_priority_queue_size(event_queue))
+        while ((event_next = gb_tessellator_event_queue_get(impl)))
         {
-            // get the next vertex event
-            gb_mesh_vertex_ref_t event_next = (gb_mesh_vertex_ref_t)tb_priority_queue_get(event_queue);
-            tb_assert(event_next);
-
             // two vertices are exactly same?
             tb_check_break(gb_tessellator_vertex_eq(event, event_next));
 
             // pop the next event from the event queue
-            tb_priority_queue_pop(event_queue);
+            gb_tessellator_event_queue_pop(impl);
 
             // trace
             tb_trace_d("event: merge: %{point}", gb_tessellator_vertex_point(event));
@@ -4427,10 +4443,16 @@ tb_void_t gb_tessellator_monotone_make(gb_tessellator_impl_t* impl, gb_rect_ref_
 
         // sweep this event
         gb_tessellator_sweep_event(impl, event);
+
+        // stat the events
+        gb_tessellator_stats_add(impl, events, 1);
     }
+    gb_tessellator_stats_time_add(impl, sweep, time);
 
     // remove degenerate faces
+    time = gb_tessellator_stats_time(impl);
     gb_tessellator_remove_degenerate_faces(impl);
+    gb_tessellator_stats_time_add(impl, degenerate, time);
 
     // exit profiler
 #ifdef GB_TESSELLATOR_PROFILER_ENABLE
@@ -0,0 +1,750 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        parallel.c
+ * @ingroup     utils
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "parallel"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "parallel.h"
+#include "../../../core/impl/bounds.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the workers maxn
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_PARALLEL_WORKER_MAXN      (4)
+#else
+#   define GB_TESSELLATOR_PARALLEL_WORKER_MAXN      (16)
+#endif
+
+// the minimum points count of the polygon for grouping the contours, the overhead of the groups and threads is too large for the small polygon
+#define GB_TESSELLATOR_PARALLEL_POINTS_MINN         (512)
+
+// the minimum points count of each worker
+#define GB_TESSELLATOR_PARALLEL_WORKER_POINTS_MINN  (256)
+
+// the outputs grow
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_PARALLEL_OUTPUTS_GROW     (64)
+#else
+#   define GB_TESSELLATOR_PARALLEL_OUTPUTS_GROW     (256)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the parallel contour type
+typedef struct __gb_tessellator_parallel_contour_t
+{
+    // the bounds
+    gb_rect_t                                       bounds;
+
+    // the points offset in the polygon
+    tb_size_t                                       offset;
+
+    // the points count
+    tb_uint16_t                                     count;
+
+    // the parent contour for merging the groups, it is the root contour of the group if parent == self
+    tb_uint32_t                                     parent;
+
+    // the group index
+    tb_uint32_t                                     group;
+
+}gb_tessellator_parallel_contour_t, *gb_tessellator_parallel_contour_ref_t;
+
+// the parallel worker type
+typedef struct __gb_tessellator_parallel_worker_t
+{
+    // the tessellator of this worker, it has the own mesh and event queue
+    gb_tessellator_ref_t                            tessellator;
+
+    // the parallel impl
+    struct __gb_tessellator_parallel_impl_t*        parallel;
+
+    // the groups range: [group_head, group_tail)
+    tb_size_t                                       group_head;
+    tb_size_t                                       group_tail;
+
+    // the points of the group polygon
+    gb_point_ref_t                                  points;
+
+    // the points maxn
+    tb_size_t                                       points_maxn;
+
+    // the counts of the group polygon
+    tb_uint16_t*                                    counts;
+
+    // the counts maxn
+    tb_size_t                                       counts_maxn;
+
+    // the output points
+    gb_point_ref_t                                  outputs;
+
+    // the output points count
+    tb_size_t                                       outputs_size;
+
+    // the output points maxn
+    tb_size_t                                       outputs_maxn;
+
+    // the output counts
+    tb_uint16_t*                                    outputs_counts;
+
+    // the output counts count
+    tb_size_t                                       outputs_counts_size;
+
+    // the output counts maxn
+    tb_size_t                                       outputs_counts_maxn;
+
+    // failed to record the outputs or make the group polygon?
+    tb_bool_t                                       failed;
+
+}gb_tessellator_parallel_worker_t, *gb_tessellator_parallel_worker_ref_t;
+
+// the parallel impl type
+typedef struct __gb_tessellator_parallel_impl_t
+{
+    // the polygon
+    gb_polygon_ref_t                                polygon;
+
+    // the contours
+    gb_tessellator_parallel_contour_ref_t           contours;
+
+    // the contours count
+    tb_size_t                                       contours_count;
+
+    // the contours maxn
+    tb_size_t                                       contours_maxn;
+
+    /* the work data of the contours, tb_uint32_t[contours_maxn * 3]
+     *
+     * order:  the contour indices sorted by the group
+     * sorted: the contour indices sorted by bounds.x
+     * active: the active contour indices for sweeping
+     */
+    tb_uint32_t*                                    order;
+
+    // the heads of the groups in the order, tb_uint32_t[contours_maxn + 1]
+    tb_uint32_t*                                    groups;
+
+    // the groups count
+    tb_size_t                                       groups_count;
+
+    // the workers
+    gb_tessellator_parallel_worker_t                workers[GB_TESSELLATOR_PARALLEL_WORKER_MAXN];
+
+    // the semaphore for waiting the posted workers
+    tb_semaphore_ref_t                              semaphore;
+
+}gb_tessellator_parallel_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_uint32_t gb_tessellator_parallel_root(gb_tessellator_parallel_contour_ref_t contours, tb_uint32_t index)
+{
+    // find the root contour of the group with path halving
+    while (contours[index].parent != index)
+    {
+        contours[index].parent = contours[contours[index].parent].parent;
+        index = contours[index].parent;
+    }
+    return index;
+}
+static tb_void_t gb_tessellator_parallel_merge(gb_tessellator_parallel_contour_ref_t contours, tb_uint32_t a, tb_uint32_t b)
+{
+    // the roots
+    a = gb_tessellator_parallel_root(contours, a);
+    b = gb_tessellator_parallel_root(contours, b);
+
+    // merge the groups, the root is the smaller contour
+    if (a < b) contours[b].parent = a;
+    else if (a > b) contours[a].parent = b;
+}
+static tb_void_t gb_tessellator_parallel_sort(gb_tessellator_parallel_contour_ref_t contours, tb_uint32_t* indices, tb_uint32_t* temp, tb_size_t count)
+{
+    // check
+    tb_assert(contours && indices && temp);
+
+    // sort the contour indices by bounds.x with the bottom-up merge sort
+    tb_size_t       width = 1;
+    tb_uint32_t*    input = indices;
+    tb_uint32_t*    output = temp;
+    for (width = 1; width < count; width <<= 1)
+    {
+        // merge all pairs of the sorted runs: [head, middle) and [middle, tail)
+        tb_size_t head = 0;
+        for (head = 0; head < count; head += width << 1)
+        {
+            tb_size_t middle    = tb_min(head + width, count);
+            tb_size_t tail      = tb_min(head + (width << 1), count);
+            tb_size_t i         = head;
+            tb_size_t j         = middle;
+            tb_size_t k         = head;
+            while (i < middle && j < tail)
+                output[k++] = (contours[input[j]].bounds.x < contours[input[i]].bounds.x)? input[j++] : input[i++];
+            while (i < middle) output[k++] = input[i++];
+            while (j < tail) output[k++] = input[j++];
+        }
+
+        // swap the input and output
+        tb_swap(tb_uint32_t*, input, output);
+    }
+
+    // copy the sorted indices back if they are in the temporary data
+    if (input != indices) tb_memcpy(indices, input, count * sizeof(tb_uint32_t));
+}
+static tb_bool_t gb_tessellator_parallel_grow(gb_tessellator_parallel_impl_t* impl, tb_size_t count)
+{
+    // check
+    tb_assert(impl);
+
+    // enough?
+    tb_check_return_val(count > impl->contours_maxn, tb_true);
+
+    // grow the contours
+    impl->contours = (gb_tessellator_parallel_contour_ref_t)tb_ralloc(impl->contours, count * sizeof(gb_tessellator_parallel_contour_t));
+    tb_assert_and_check_return_val(impl->contours, tb_false);
+
+    // grow the work data
+    impl->order = (tb_uint32_t*)tb_ralloc(impl->order, count * 3 * sizeof(tb_uint32_t));
+    tb_assert_and_check_return_val(impl->order, tb_false);
+
+    // grow the groups
+    impl->groups = (tb_uint32_t*)tb_ralloc(impl->groups, (count + 1) * sizeof(tb_uint32_t));
+    tb_assert_and_check_return_val(impl->groups, tb_false);
+
+    // update the maxn
+    impl->contours_maxn = count;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_tessellator_parallel_group(gb_tessellator_parallel_impl_t* impl, gb_polygon_ref_t polygon)
+{
+    // check
+    tb_assert(impl && polygon && polygon->points && polygon->counts);
+
+    // the contours count
+    tb_size_t           count = 0;
+    tb_uint16_t const*  counts = polygon->counts;
+    while (*counts++) count++;
+
+    // only one contour?
+    tb_check_return_val(count > 1, tb_false);
+
+    // grow the contours
+    if (!gb_tessellator_parallel_grow(impl, count)) return tb_false;
+
+    // init the contours
+    tb_size_t                               i = 0;
+    tb_size_t                               offset = 0;
+    gb_tessellator_parallel_contour_ref_t   contours = impl->contours;
+    for (i = 0; i < count; i++)
+    {
+        contours[i].offset  = offset;
+        contours[i].count   = polygon->counts[i];
+        contours[i].parent  = (tb_uint32_t)i;
+        gb_bounds_make(&contours[i].bounds, polygon->points + offset, contours[i].count);
+        offset += contours[i].count;
+    }
+    impl->contours_count = count;
+
+    // sort the contours by bounds.x
+    tb_uint32_t* order  = impl->order;
+    tb_uint32_t* sorted = order + count;
+    tb_uint32_t* active = sorted + count;
+    for (i = 0; i < count; i++) sorted[i] = (tb_uint32_t)i;
+    gb_tessellator_parallel_sort(contours, sorted, active, count);
+
+    /* merge the contours with the overlapping bounds to the same group
+     *
+     * we sweep the contours by bounds.x and only compare it with the active contours
+     */
+    tb_size_t active_count = 0;
+    for (i = 0; i < count; i++)
+    {
+        // the contour
+        tb_uint32_t     index = sorted[i];
+        gb_rect_ref_t   bounds = &contours[index].bounds;
+
+        // compare it with the active contours and remove the contours on the left of it
+        tb_size_t j = 0;
+        tb_size_t k = 0;
+        for (j = 0; j < active_count; j++)
+        {
+            // the active contour
+            tb_uint32_t     other = active[j];
+            gb_rect_ref_t   other_bounds = &contours[other].bounds;
+
+            // on the left? remove it
+            if (other_bounds->x + other_bounds->w < bounds->x) continue;
+
+            // the bounds are overlapping or touching? merge them
+            if (other_bounds->y <= bounds->y + bounds->h && bounds->y <= other_bounds->y + other_bounds->h)
+                gb_tessellator_parallel_merge(contours, index, other);
+
+            // keep it
+            active[k++] = other;
+        }
+        active_count = k;
+
+        // append it to the active contours
+        active[active_count++] = index;
+    }
+
+    // make the groups in the order of their first contours
+    tb_size_t groups_count = 0;
+    for (i = 0; i < count; i++)
+    {
+        tb_uint32_t root = gb_tessellator_parallel_root(contours, (tb_uint32_t)i);
+        contours[i].group = (root == i)? (tb_uint32_t)groups_count++ : contours[root].group;
+    }
+    impl->groups_count = groups_count;
+
+    // only one group?
+    tb_check_return_val(groups_count > 1, tb_false);
+
+    // sort the contours by the group with the counting sort, the contours are also in order in the same group
+    tb_uint32_t* groups = impl->groups;
+    tb_memset(groups, 0, (groups_count + 1) * sizeof(tb_uint32_t));
+    for (i = 0; i < count; i++) groups[contours[i].group + 1]++;
+    for (i = 0; i < groups_count; i++) groups[i + 1] += groups[i];
+    for (i = 0; i < count; i++) order[groups[contours[i].group]++] = (tb_uint32_t)i;
+
+    // restore the heads of the groups
+    for (i = groups_count; i > 0; i--) groups[i] = groups[i - 1];
+    groups[0] = 0;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_tessellator_parallel_worker_grow(tb_pointer_t* pdata, tb_size_t* pmaxn, tb_size_t size, tb_size_t item_size)
+{
+    // check
+    tb_assert(pdata && pmaxn && item_size);
+
+    // enough?
+    tb_check_return_val(size > *pmaxn, tb_true);
+
+    // grow it
+    tb_size_t maxn = tb_max(size, *pmaxn + (*pmaxn >> 1) + GB_TESSELLATOR_PARALLEL_OUTPUTS_GROW);
+    *pdata = tb_ralloc(*pdata, maxn * item_size);
+    *pmaxn = *pdata? maxn : 0;
+
+    // ok?
+    return *pdata != tb_null;
+}
+static tb_void_t gb_tessellator_parallel_record(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_tessellator_parallel_worker_ref_t worker = (gb_tessellator_parallel_worker_ref_t)priv;
+    tb_assert(worker && points && count);
+
+    // failed?
+    tb_check_return(!worker->failed);
+
+    // grow the outputs and counts
+    if (    !gb_tessellator_parallel_worker_grow((tb_pointer_t*)&worker->outputs, &worker->outputs_maxn, worker->outputs_size + count, sizeof(gb_point_t))
+        ||  !gb_tessellator_parallel_worker_grow((tb_pointer_t*)&worker->outputs_counts, &worker->outputs_counts_maxn, worker->outputs_counts_size + 1, sizeof(tb_uint16_t)))
+    {
+        // the outputs of this worker are discarded and the polygon will be tessellated sequentially
+        worker->failed = tb_true;
+        return ;
+    }
+
+    // record the points of this contour
+    tb_memcpy(worker->outputs + worker->outputs_size, points, count * sizeof(gb_point_t));
+    worker->outputs_size += count;
+
+    // record the points count of this contour
+    worker->outputs_counts[worker->outputs_counts_size++] = count;
+}
+static tb_void_t gb_tessellator_parallel_worker_done(gb_tessellator_parallel_worker_ref_t worker)
+{
+    // check
+    tb_assert(worker && worker->parallel && worker->tessellator);
+
+    // the parallel impl and polygon
+    gb_tessellator_parallel_impl_t* impl = worker->parallel;
+    gb_polygon_ref_t                polygon = impl->polygon;
+    tb_assert(impl && polygon);
+
+    // clear the outputs
+    worker->outputs_size        = 0;
+    worker->outputs_counts_size = 0;
+    worker->failed              = tb_false;
+
+    // done all groups of this worker
+    tb_size_t                               i = 0;
+    tb_size_t                               group = 0;
+    tb_uint16_t                             counts[2] = {0, 0};
+    gb_tessellator_parallel_contour_ref_t   contours = impl->contours;
+    for (group = worker->group_head; group < worker->group_tail && !worker->failed; group++)
+    {
+        // the contours of this group: order[head, tail)
+        tb_size_t head = impl->groups[group];
+        tb_size_t tail = impl->groups[group + 1];
+        tb_assert(head < tail);
+
+        // make the polygon and bounds of this group
+        gb_rect_t       bounds;
+        gb_polygon_t    group_polygon = {tb_null, tb_null, polygon->convex};
+        if (tail == head + 1)
+        {
+            // only one contour? we use the points of the polygon directly
+            gb_tessellator_parallel_contour_ref_t contour = &contours[impl->order[head]];
+            counts[0]               = contour->count;
+            group_polygon.points    = polygon->points + contour->offset;
+            group_polygon.counts    = counts;
+            bounds                  = contour->bounds;
+        }
+        else
+        {
+            // grow the counts, the contours count + 1
+            if (!gb_tessellator_parallel_worker_grow((tb_pointer_t*)&worker->counts, &worker->counts_maxn, tail - head + 1, sizeof(tb_uint16_t)))
+            {
+                worker->failed = tb_true;
+                break;
+            }
+
+            // append the points and counts of all contours
+            tb_size_t size = 0;
+            gb_float_t x0 = 0;
+            gb_float_t y0 = 0;
+            gb_float_t x1 = 0;
+            gb_float_t y1 = 0;
+            for (i = head; i < tail; i++)
+            {
+                // the contour
+                gb_tessellator_parallel_contour_ref_t contour = &contours[impl->order[i]];
+
+                // append the points
+                if (!gb_tessellator_parallel_worker_grow((tb_pointer_t*)&worker->points, &worker->points_maxn, size + contour->count, sizeof(gb_point_t))) break;
+                tb_memcpy(worker->points + size, polygon->points + contour->offset, contour->count * sizeof(gb_point_t));
+                size += contour->count;
+
+                // append the count
+                worker->counts[i - head] = contour->count;
+
+                // merge the bounds
+                if (i == head)
+                {
+                    x0 = contour->bounds.x;
+                    y0 = contour->bounds.y;
+                    x1 = contour->bounds.x + contour->bounds.w;
+                    y1 = contour->bounds.y + contour->bounds.h;
+                }
+                else
+                {
+                    x0 = tb_min(x0, contour->bounds.x);
+                    y0 = tb_min(y0, contour->bounds.y);
+                    x1 = tb_max(x1, contour->bounds.x + contour->bounds.w);
+                    y1 = tb_max(y1, contour->bounds.y + contour->bounds.h);
+                }
+            }
+
+            // failed?
+            if (i != tail)
+            {
+                worker->failed = tb_true;
+                break;
+            }
+
+            // append the end of the counts
+            worker->counts[tail - head] = 0;
+
+            // init the polygon and bounds
+            group_polygon.points    = worker->points;
+            group_polygon.counts    = worker->counts;
+            bounds.x                = x0;
+            bounds.y                = y0;
+            bounds.w                = x1 - x0;
+            bounds.h                = y1 - y0;
+        }
+
+        // done tessellator for this group
+        gb_tessellator_done(worker->tessellator, &group_polygon, &bounds);
+    }
+}
+static tb_void_t gb_tessellator_parallel_worker_task(tb_thread_pool_worker_ref_t pool_worker, tb_cpointer_t priv)
+{
+    // check
+    gb_tessellator_parallel_worker_ref_t worker = (gb_tessellator_parallel_worker_ref_t)priv;
+    tb_assert(worker && worker->parallel);
+
+    // done worker
+    gb_tessellator_parallel_worker_done(worker);
+
+    // notify the waiting thread
+    tb_semaphore_post(worker->parallel->semaphore, 1);
+}
+static tb_void_t gb_tessellator_parallel_stats_merge(gb_tessellator_stats_ref_t stats, gb_tessellator_stats_ref_t worker_stats)
+{
+    // check
+    tb_assert(stats);
+    tb_check_return(worker_stats);
+
+    // merge the times and counters, the polygons have been counted by the parent tessellator
+    stats->mesh_time            += worker_stats->mesh_time;
+    stats->degenerate_time      += worker_stats->degenerate_time;
+    stats->event_queue_time     += worker_stats->event_queue_time;
+    stats->sweep_time           += worker_stats->sweep_time;
+    stats->intersection_time    += worker_stats->intersection_time;
+    stats->triangulation_time   += worker_stats->triangulation_time;
+    stats->output_time          += worker_stats->output_time;
+    stats->events               += worker_stats->events;
+    stats->intersections        += worker_stats->intersections;
+    stats->regions              += worker_stats->regions;
+    stats->vertices             += worker_stats->vertices;
+}
+static tb_bool_t gb_tessellator_parallel_worker_init(gb_tessellator_impl_t* impl, gb_tessellator_parallel_worker_ref_t worker)
+{
+    // check
+    tb_assert(impl && worker);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // init tessellator
+        if (!worker->tessellator) worker->tessellator = gb_tessellator_init();
+        tb_assert_and_check_break(worker->tessellator);
+
+        // update the mode, rule and func of the tessellator
+        gb_tessellator_mode_set(worker->tessellator, impl->mode);
+        gb_tessellator_rule_set(worker->tessellator, impl->rule);
+        gb_tessellator_func_set(worker->tessellator, gb_tessellator_parallel_record, worker);
+
+        // enable the stats of the tessellator if the stats of the parent tessellator are enabled
+        gb_tessellator_stats_enable(worker->tessellator, impl->stats != tb_null);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // ok?
+    return ok;
+}
+static tb_void_t gb_tessellator_parallel_worker_exit(gb_tessellator_parallel_worker_ref_t worker)
+{
+    // check
+    tb_assert(worker);
+
+    // exit tessellator
+    if (worker->tessellator) gb_tessellator_exit(worker->tessellator);
+    worker->tessellator = tb_null;
+
+    // exit points
+    if (worker->points) tb_free(worker->points);
+    worker->points      = tb_null;
+    worker->points_maxn = 0;
+
+    // exit counts
+    if (worker->counts) tb_free(worker->counts);
+    worker->counts      = tb_null;
+    worker->counts_maxn = 0;
+
+    // exit outputs
+    if (worker->outputs) tb_free(worker->outputs);
+    worker->outputs         = tb_null;
+    worker->outputs_size    = 0;
+    worker->outputs_maxn    = 0;
+
+    // exit outputs counts
+    if (worker->outputs_counts) tb_free(worker->outputs_counts);
+    worker->outputs_counts          = tb_null;
+    worker->outputs_counts_size     = 0;
+    worker->outputs_counts_maxn     = 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_tessellator_parallel_done(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon)
+{
+    // check
+    tb_assert(impl && impl->func && polygon && polygon->points && polygon->counts);
+
+    // the convex contours will be tessellated one by one and it is fast enough
+    tb_check_return_val(!polygon->convex, tb_false);
+
+    // the points count
+    tb_size_t           points_count = 0;
+    tb_uint16_t const*  counts = polygon->counts;
+    while (*counts) points_count += *counts++;
+
+    // the polygon is too small?
+    tb_check_return_val(points_count >= GB_TESSELLATOR_PARALLEL_POINTS_MINN, tb_false);
+
+    // init parallel
+    if (!impl->parallel) impl->parallel = (gb_tessellator_parallel_ref_t)tb_malloc0_type(gb_tessellator_parallel_impl_t);
+    tb_assert_and_check_return_val(impl->parallel, tb_false);
+
+    // group the contours, only one group?
+    gb_tessellator_parallel_impl_t* parallel = (gb_tessellator_parallel_impl_t*)impl->parallel;
+    if (!gb_tessellator_parallel_group(parallel, polygon)) return tb_false;
+
+    /* the workers count
+     *
+     * the groups are always tessellated one by one even if the threads are disabled,
+     * so the outputs are same for any threads count
+     */
+    tb_size_t workers_count = tb_min(impl->threads, GB_TESSELLATOR_PARALLEL_WORKER_MAXN);
+    workers_count = tb_min(workers_count, parallel->groups_count);
+    workers_count = tb_min(workers_count, points_count / GB_TESSELLATOR_PARALLEL_WORKER_POINTS_MINN);
+    workers_count = tb_max(workers_count, 1);
+
+    // assign the groups to the workers with the balanced points
+    tb_size_t i = 0;
+    tb_size_t group = 0;
+    tb_size_t points = 0;
+    for (i = 0; i < workers_count; i++)
+    {
+        // init worker
+        gb_tessellator_parallel_worker_ref_t worker = &parallel->workers[i];
+        worker->parallel = parallel;
+        if (!gb_tessellator_parallel_worker_init(impl, worker)) return tb_false;
+
+        // the groups of this worker, the last worker has all left groups
+        tb_size_t limit = (i + 1 < workers_count)? (points_count * (i + 1)) / workers_count : points_count;
+        worker->group_head = group;
+        while (group < parallel->groups_count && (points < limit || group == worker->group_head))
+        {
+            tb_size_t j = 0;
+            for (j = parallel->groups[group]; j < parallel->groups[group + 1]; j++)
+                points += parallel->contours[parallel->order[j]].count;
+            group++;
+        }
+        worker->group_tail = group;
+    }
+    tb_assert(group == parallel->groups_count);
+    parallel->polygon = polygon;
+
+    /* post the other workers to the thread pool
+     *
+     * the profiler of the debug mode is not thread-safe, so we done them in the current thread
+     *
+     * @note we wait them using our semaphore because tb_thread_pool_task_wait() is polling with the long interval
+     */
+#ifdef __gb_debug__
+    tb_thread_pool_ref_t pool = tb_null;
+#else
+    tb_thread_pool_ref_t pool = workers_count > 1? tb_thread_pool() : tb_null;
+#endif
+    if (pool && !parallel->semaphore) parallel->semaphore = tb_semaphore_init(0);
+    tb_size_t posted = 0;
+    tb_bool_t inlined[GB_TESSELLATOR_PARALLEL_WORKER_MAXN] = {0};
+    for (i = 1; i < workers_count; i++)
+    {
+        if (pool && parallel->semaphore && tb_thread_pool_task_post(pool, "tessellator", gb_tessellator_parallel_worker_task, tb_null, &parallel->workers[i], tb_false)) posted++;
+        else inlined[i] = tb_true;
+    }
+
+    // done the first worker and the workers which were not posted in the current thread
+    gb_tessellator_parallel_worker_done(&parallel->workers[0]);
+    for (i = 1; i < workers_count; i++)
+        if (inlined[i]) gb_tessellator_parallel_worker_done(&parallel->workers[i]);
+
+    // wait the posted workers
+    while (posted)
+    {
+        if (tb_semaphore_wait(parallel->semaphore, -1) > 0) posted--;
+    }
+    parallel->polygon = tb_null;
+
+    // some workers failed? tessellate it sequentially, no outputs have been emitted now
+    for (i = 0; i < workers_count; i++)
+    {
+        if (parallel->workers[i].failed) return tb_false;
+    }
+
+    // done the outputs of all workers in the order of the groups
+    tb_hong_t time = gb_tessellator_stats_time(impl);
+    for (i = 0; i < workers_count; i++)
+    {
+        gb_tessellator_parallel_worker_ref_t worker = &parallel->workers[i];
+        tb_size_t       j = 0;
+        tb_size_t       n = worker->outputs_counts_size;
+        gb_point_ref_t  outputs = worker->outputs;
+        for (j = 0; j < n; j++)
+        {
+            tb_uint16_t count = worker->outputs_counts[j];
+            impl->func(outputs, count, impl->priv);
+            outputs += count;
+        }
+
+        // merge the stats of this worker
+        if (impl->stats) gb_tessellator_parallel_stats_merge(impl->stats, gb_tessellator_stats(worker->tessellator));
+    }
+    gb_tessellator_stats_time_add(impl, output, time);
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_tessellator_parallel_exit(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // exit parallel
+    gb_tessellator_parallel_impl_t* parallel = (gb_tessellator_parallel_impl_t*)impl->parallel;
+    if (parallel)
+    {
+        // exit workers
+        tb_size_t i = 0;
+        for (i = 0; i < GB_TESSELLATOR_PARALLEL_WORKER_MAXN; i++)
+            gb_tessellator_parallel_worker_exit(&parallel->workers[i]);
+
+        // exit semaphore
+        if (parallel->semaphore) tb_semaphore_exit(parallel->semaphore);
+        parallel->semaphore = tb_null;
+
+        // exit contours
+        if (parallel->contours) tb_free(parallel->contours);
+        parallel->contours = tb_null;
+
+        // exit work data
+        if (parallel->order) tb_free(parallel->order);
+        parallel->order = tb_null;
+
+        // exit groups
+        if (parallel->groups) tb_free(parallel->groups);
+        parallel->groups = tb_null;
+
+        // exit it
+        tb_free(parallel);
+    }
+    impl->parallel = tb_null;
+}
@@ -0,0 +1,70 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        parallel.h
+ * @ingroup     utils
+ */
+#ifndef GB_UTILS_IMPL_TESSELLATOR_PARALLEL_H
+#define GB_UTILS_IMPL_TESSELLATOR_PARALLEL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* done the tessellator for the independent contour groups
+ *
+ * the contours are grouped by the overlapping bounds and the groups are independent,
+ * so we tessellate them with the own tessellators, on the thread pool if the threads are enabled,
+ * and pass the outputs to the tessellator func in the order of the groups.
+ *
+ * the order of the groups is the order of their first contours, 
+ * so the outputs are same for any threads count.
+ *
+ * @param impl                      the tessellator impl
+ * @param polygon                   the polygon
+ *
+ * @return                          tb_true or tb_false if it is not necessary to be grouped or failed,
+ *                                  no outputs will be passed to the tessellator func if tb_false
+ */
+tb_bool_t                           gb_tessellator_parallel_done(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon);
+
+/* exit the parallel data of the tessellator
+ *
+ * @param impl                      the tessellator impl
+ */
+tb_void_t                           gb_tessellator_parallel_exit(gb_tessellator_impl_t* impl);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -78,6 +78,15 @@
 // set the tessellator vertex point
 #define gb_tessellator_vertex_point_set(vertex, val)    do { gb_tessellator_vertex(vertex)->point = *(val); } while (0)
 
+// the start time of the stats phase, it will be zero if the stats are disabled
+#define gb_tessellator_stats_time(impl)                 ((impl)->stats? tb_uclock() : 0)
+
+// add the elapsed time of the stats phase
+#define gb_tessellator_stats_time_add(impl, name, time) do { if ((impl)->stats) (impl)->stats->name##_time += tb_uclock() - (time); } while (0)
+
+// add the stats counter
+#define gb_tessellator_stats_add(impl, name, val)       do { if ((impl)->stats) (impl)->stats->name += (val); } while (0)
+
 // define the local tessellator vertex variable
 #define gb_tessellator_vertex_local(name) \
     tb_byte_t __name##_data[sizeof(gb_mesh_vertex_t) + sizeof(gb_tessellator_vertex_t)]; \
@@ -103,9 +112,6 @@
  */
 typedef struct __gb_tessellator_active_region_t
 {
-    // the region position
-    tb_size_t                           position;
-
     // the left edge and it goes up
     gb_mesh_edge_ref_t                  edge;
 
@@ -154,8 +160,20 @@ typedef struct __gb_tessellator_vertex_t
     // the point
     gb_point_t                          point;
 
+    // the output index of the indexed triangles
+    tb_uint32_t                         index;
+
 } gb_tessellator_vertex_t, *gb_tessellator_vertex_ref_t;
 
+// the active regions ref type
+typedef struct{}*                       gb_tessellator_active_regions_ref_t;
+
+// the cache ref type
+typedef struct{}*                       gb_tessellator_cache_ref_t;
+
+// the parallel ref type
+typedef struct{}*                       gb_tessellator_parallel_ref_t;
+
 // the tessellator impl type
 typedef struct __gb_tessellator_impl_t
 {
@@ -180,11 +198,56 @@ typedef struct __gb_tessellator_impl_t
     // the output points
     tb_vector_ref_t                     outputs;
 
-    // the event queue for vertex
+    // the output triangles for gb_tessellator_done_triangles
+    gb_tessellator_triangles_ref_t      triangles;
+
+    // the event queue for the new intersection vertices
     tb_priority_queue_ref_t             event_queue;
 
+    // the sorted vertex events of the mesh
+    gb_mesh_vertex_ref_t*               event_sorted;
+
+    // the sorting keys of the sorted vertex events
+    tb_uint64_t*                        event_sorted_keys;
+
+    // the head of the sorted vertex events
+    tb_size_t                           event_sorted_head;
+
+    // the size of the sorted vertex events
+    tb_size_t                           event_sorted_size;
+
+    // the maxn of the sorted vertex events
+    tb_size_t                           event_sorted_maxn;
+
     // the active regions
-    tb_list_ref_t                       active_regions;
+    gb_tessellator_active_regions_ref_t active_regions;
+
+    // the indices and work data of the simple polygon
+    tb_uint16_t*                        simple_data;
+
+    // the maxn of the simple polygon data
+    tb_size_t                           simple_maxn;
+
+    // the points count of the simple polygon
+    tb_size_t                           simple_count;
+
+    // the indices count of the simple polygon, it will be zero if output the whole contour
+    tb_size_t                           simple_size;
+
+    // the cache of the outputs
+    gb_tessellator_cache_ref_t          cache;
+
+    // the maximum threads count for tessellating the independent contour groups
+    tb_size_t                           threads;
+
+    // the parallel data
+    gb_tessellator_parallel_ref_t       parallel;
+
+    // the stats, it will be null if the stats are disabled
+    gb_tessellator_stats_ref_t          stats;
+
+    // the nesting depth of fixing the intersections for the stats
+    tb_size_t                           stats_fixing;
 
 }gb_tessellator_impl_t;
 
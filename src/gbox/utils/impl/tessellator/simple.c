@@ -0,0 +1,438 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        simple.c
+ * @ingroup     utils
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "simple"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "simple.h"
+#include "geometry.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum points count of the non-monotone simple polygon for the ear clipping
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_SIMPLE_EARCUT_MAXN        (32)
+#else
+#   define GB_TESSELLATOR_SIMPLE_EARCUT_MAXN        (64)
+#endif
+
+/* point: a < b? 
+ *
+ * sweep direction: horizontal, be same as gb_tessellator_vertex_le
+ */
+#define gb_tessellator_simple_point_le(a, b)        ((a)->y < (b)->y || ((a)->y == (b)->y && (a)->x < (b)->x))
+
+// the next index of the contour
+#define gb_tessellator_simple_next(i, count)        ((i) + 1 < (count)? (i) + 1 : 0)
+
+// the previous index of the contour
+#define gb_tessellator_simple_prev(i, count)        ((i)? (i) - 1 : (count) - 1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+/* the two segments are intersected or touched?
+ *
+ * a         c
+ *   .     .
+ *     . .
+ *     . .
+ *   .     .
+ * d         b
+ */
+static tb_bool_t gb_tessellator_simple_intersected(gb_point_ref_t a, gb_point_ref_t b, gb_point_ref_t c, gb_point_ref_t d)
+{
+    // the bounds are not intersected? 
+    if (    tb_max(a->x, b->x) < tb_min(c->x, d->x) || tb_max(c->x, d->x) < tb_min(a->x, b->x)
+        ||  tb_max(a->y, b->y) < tb_min(c->y, d->y) || tb_max(c->y, d->y) < tb_min(a->y, b->y))
+        return tb_false;
+
+    // c and d are in the different sides of (a, b) or on it?
+    tb_long_t o1 = gb_points_orientation(a, b, c);
+    tb_long_t o2 = gb_points_orientation(a, b, d);
+    tb_check_return_val(o1 * o2 <= 0, tb_false);
+
+    /* all points are collinear? 
+     *
+     * they must be overlapped now because the bounds have been intersected
+     */
+    if (!o1 && !o2) return tb_true;
+
+    // a and b are in the different sides of (c, d) or on it?
+    return gb_points_orientation(c, d, a) * gb_points_orientation(c, d, b) <= 0;
+}
+/* append a triangle and make it counter-clockwise
+ *
+ * we discard the degenerated triangle because it covers nothing
+ */
+static __tb_inline__ tb_void_t gb_tessellator_simple_append(gb_tessellator_impl_t* impl, gb_point_ref_t points, tb_size_t a, tb_size_t b, tb_size_t c)
+{
+    // the orientation
+    tb_long_t orient = gb_points_orientation(points + a, points + b, points + c);
+    tb_check_return(orient);
+
+    // append it
+    tb_uint16_t* indices = impl->simple_data + impl->simple_size;
+    indices[0] = (tb_uint16_t)a;
+    indices[1] = (tb_uint16_t)(orient > 0? b : c);
+    indices[2] = (tb_uint16_t)(orient > 0? c : b);
+    impl->simple_size += 3;
+}
+/* check the monotone polygon is simple and sort it's points
+ *
+ * we merge the left and right chains from top to bottom, 
+ * and each point must be in the inside of the current edge of another chain.
+ *
+ *          top
+ *          . .
+ *   left .     . right
+ *         .      .
+ *          .  . -- . ---- the current edge
+ *           .     .
+ *            .   .
+ *              .
+ *           bottom
+ */
+static tb_bool_t gb_tessellator_simple_monotone_check(gb_point_ref_t points, tb_size_t count, tb_size_t top, tb_size_t bottom, tb_long_t orient, tb_uint16_t* order)
+{
+    // done
+    tb_size_t index     = 0;
+    tb_size_t forward   = gb_tessellator_simple_next(top, count);
+    tb_size_t backward  = gb_tessellator_simple_prev(top, count);
+    order[index++] = (tb_uint16_t)top;
+    while (forward != bottom || backward != bottom)
+    {
+        // the next point is at the forward chain?
+        if (forward != bottom && (backward == bottom || gb_tessellator_simple_point_le(points + forward, points + backward)))
+        {
+            // it must be in the inside of the backward edge
+            if (gb_points_orientation(points + backward, points + gb_tessellator_simple_next(backward, count), points + forward) != orient)
+                return tb_false;
+
+            // append it
+            order[index++] = (tb_uint16_t)forward;
+            forward = gb_tessellator_simple_next(forward, count);
+        }
+        else
+        {
+            // it must be in the inside of the forward edge
+            if (gb_points_orientation(points + gb_tessellator_simple_prev(forward, count), points + forward, points + backward) != orient)
+                return tb_false;
+
+            // append it
+            order[index++] = (tb_uint16_t)backward;
+            backward = gb_tessellator_simple_prev(backward, count);
+        }
+    }
+    order[index++] = (tb_uint16_t)bottom;
+
+    // ok
+    tb_assert(index == count);
+    return tb_true;
+}
+/* triangulate the monotone polygon in linear time
+ *
+ * we walk the sorted points from top to bottom and keep the reflex chain in the stack.
+ *
+ * - the point is at the another chain: connect it to all points in the stack
+ * - the point is at the same chain: connect it to the stack points until the chain becomes reflex
+ */
+static tb_void_t gb_tessellator_simple_monotone_make(gb_tessellator_impl_t* impl, gb_point_ref_t points, tb_size_t count, tb_size_t top, tb_size_t bottom, tb_long_t orient, tb_uint16_t const* order, tb_uint16_t* stack)
+{
+    // the chain size of the forward chain
+    tb_size_t chain = (bottom + count - top) % count;
+
+    // the point is at the forward chain?
+#define gb_tessellator_simple_is_forward(i)     (((i) + count - top) % count < chain)
+
+    // done
+    tb_size_t j         = 0;
+    tb_size_t last      = 0;
+    tb_size_t point     = 0;
+    tb_size_t size      = 0;
+    tb_bool_t forward   = tb_false;
+    stack[size++] = order[0];
+    stack[size++] = order[1];
+    for (j = 2; j < count - 1; j++)
+    {
+        // the point
+        point   = order[j];
+        forward = gb_tessellator_simple_is_forward(point);
+
+        // at the another chain?
+        if (forward != gb_tessellator_simple_is_forward(stack[size - 1]))
+        {
+            // connect it to all points in the stack
+            while (size > 1) 
+            {
+                gb_tessellator_simple_append(impl, points, point, stack[size - 1], stack[size - 2]);
+                size--;
+            }
+
+            // the new reflex chain
+            size = 0;
+            stack[size++] = order[j - 1];
+            stack[size++] = (tb_uint16_t)point;
+        }
+        else
+        {
+            // connect it to the stack points if the diagonal is inside
+            last = stack[--size];
+            while (size && gb_points_orientation(points + stack[size - 1], points + last, points + point) == (forward? orient : -orient))
+            {
+                gb_tessellator_simple_append(impl, points, point, last, stack[size - 1]);
+                last = stack[--size];
+            }
+
+            // push it 
+            stack[size++] = (tb_uint16_t)last;
+            stack[size++] = (tb_uint16_t)point;
+        }
+    }
+
+    // connect the bottom point to the remaining points
+    point = order[count - 1];
+    while (size > 1) 
+    {
+        gb_tessellator_simple_append(impl, points, point, stack[size - 1], stack[size - 2]);
+        size--;
+    }
+
+#undef gb_tessellator_simple_is_forward
+}
+/* triangulate the small simple polygon using the ear clipping
+ *
+ *        .
+ *      .   .
+ *    . ear   .
+ *  . . . . .   .
+ *            .
+ *
+ * @return  tb_false if it is not simple
+ */
+static tb_bool_t gb_tessellator_simple_earcut_make(gb_tessellator_impl_t* impl, gb_point_ref_t points, tb_size_t count, tb_long_t orient, tb_uint16_t* prev, tb_uint16_t* next)
+{
+    // check the simplicity, all edges must not be intersected or touched
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    for (i = 0; i < count; i++)
+    {
+        // the current edge
+        gb_point_ref_t a = points + i;
+        gb_point_ref_t b = points + gb_tessellator_simple_next(i, count);
+
+        // the adjacent edge goes back along this edge?
+        gb_point_ref_t c = points + gb_tessellator_simple_next(gb_tessellator_simple_next(i, count), count);
+        if (    !gb_points_orientation(a, b, c)
+            &&  (tb_hong_t)(gb_float_to_fixed(a->x) - gb_float_to_fixed(b->x)) * (gb_float_to_fixed(c->x) - gb_float_to_fixed(b->x))
+            +   (tb_hong_t)(gb_float_to_fixed(a->y) - gb_float_to_fixed(b->y)) * (gb_float_to_fixed(c->y) - gb_float_to_fixed(b->y)) > 0)
+            return tb_false;
+
+        // check the other non-adjacent edges
+        for (j = i + 2; j < count && (i || j + 1 < count); j++)
+        {
+            if (gb_tessellator_simple_intersected(a, b, points + j, points + gb_tessellator_simple_next(j, count)))
+                return tb_false;
+        }
+    }
+
+    // init the linked points
+    for (i = 0; i < count; i++)
+    {
+        prev[i] = (tb_uint16_t)gb_tessellator_simple_prev(i, count);
+        next[i] = (tb_uint16_t)gb_tessellator_simple_next(i, count);
+    }
+
+    // done
+    tb_size_t size  = count;
+    tb_size_t ear   = 0;
+    tb_size_t guard = 0;
+    while (size > 3)
+    {
+        // the ear triangle
+        tb_size_t       p   = prev[ear];
+        tb_size_t       n   = next[ear];
+        gb_point_ref_t  pp  = points + p;
+        gb_point_ref_t  pe  = points + ear;
+        gb_point_ref_t  pn  = points + n;
+
+        // is convex?
+        tb_bool_t ok = gb_points_orientation(pp, pe, pn) == orient;
+        if (ok)
+        {
+            // does it contain other reflex points?
+            for (i = next[n]; i != p; i = next[i])
+            {
+                // is reflex?
+                gb_point_ref_t pi = points + i;
+                if (gb_points_orientation(points + prev[i], pi, points + next[i]) == orient) continue;
+
+                // in the ear or on it?
+                if (    gb_points_orientation(pp, pe, pi) != -orient
+                    &&  gb_points_orientation(pe, pn, pi) != -orient
+                    &&  gb_points_orientation(pn, pp, pi) != -orient)
+                {
+                    ok = tb_false;
+                    break;
+                }
+            }
+        }
+
+        // clip this ear
+        if (ok)
+        {
+            gb_tessellator_simple_append(impl, points, p, ear, n);
+            next[p] = (tb_uint16_t)n;
+            prev[n] = (tb_uint16_t)p;
+            size--;
+            ear     = n;
+            guard   = 0;
+        }
+        else 
+        {
+            // no ear? the numerical errors may be too large, we use the general algorithm
+            tb_check_return_val(++guard <= size, tb_false);
+
+            // the next point
+            ear = next[ear];
+        }
+    }
+
+    // the last triangle
+    gb_tessellator_simple_append(impl, points, prev[ear], ear, next[ear]);
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_tessellator_simple_make(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon)
+{
+    // check
+    tb_assert(impl && polygon && polygon->points && polygon->counts);
+
+    // only one contour?
+    tb_check_return_val(polygon->counts[0] && !polygon->counts[1], tb_false);
+
+    // the points
+    gb_point_ref_t  points  = polygon->points;
+    tb_size_t       count   = polygon->counts[0];
+
+    // ignore the closed point
+    while (count > 1 && gb_point_eq(points + count - 1, points)) count--;
+    tb_check_return_val(count > 2, tb_false);
+
+    /* find the top and bottom points and count the local extreme points
+     *
+     * the polygon is monotone if there are only two extreme points
+     */
+    tb_size_t   i           = 0;
+    tb_size_t   top         = 0;
+    tb_size_t   bottom      = 0;
+    tb_size_t   extremes    = 0;
+    tb_long_t   turn        = 0;
+    tb_long_t   orient      = 0;
+    tb_bool_t   convex      = tb_true;
+    for (i = 0; i < count; i++)
+    {
+        // the previous, current and next points
+        gb_point_ref_t p = points + gb_tessellator_simple_prev(i, count);
+        gb_point_ref_t c = points + i;
+        gb_point_ref_t n = points + gb_tessellator_simple_next(i, count);
+
+        // the degenerated edge? we need remove it using the general algorithm
+        tb_check_return_val(!gb_point_eq(c, n), tb_false);
+
+        // is extreme point?
+        if (gb_tessellator_simple_point_le(p, c) == gb_tessellator_simple_point_le(n, c)) extremes++;
+
+        // the top and bottom points
+        if (gb_tessellator_simple_point_le(c, points + top)) top = i;
+        if (gb_tessellator_simple_point_le(points + bottom, c)) bottom = i;
+
+        // all turns have the same orientation?
+        orient = gb_points_orientation(p, c, n);
+        if (orient)
+        {
+            if (!turn) turn = orient;
+            else if (orient != turn) convex = tb_false;
+        }
+    }
+
+    // the orientation of the polygon, the top point must be convex
+    orient = gb_points_orientation(points + gb_tessellator_simple_prev(top, count), points + top, points + gb_tessellator_simple_next(top, count));
+    tb_check_return_val(orient, tb_false);
+
+    // make triangulation?
+    tb_bool_t triangulation = impl->triangles || impl->mode == GB_TESSELLATOR_MODE_TRIANGULATION;
+
+    // not monotone? only triangulate the small polygon using the ear clipping
+    tb_check_return_val(extremes == 2 || (triangulation && count <= GB_TESSELLATOR_SIMPLE_EARCUT_MAXN), tb_false);
+
+    // make convex polygon? only for the convex polygon
+    tb_check_return_val(triangulation || convex || impl->mode == GB_TESSELLATOR_MODE_MONOTONE, tb_false);
+
+    // init the data: indices + order + stack or indices + prev + next
+    tb_size_t maxn = 5 * count;
+    if (!impl->simple_data || impl->simple_maxn < maxn)
+    {
+        impl->simple_data = (tb_uint16_t*)tb_ralloc(impl->simple_data, maxn * sizeof(tb_uint16_t));
+        tb_assert_and_check_return_val(impl->simple_data, tb_false);
+        impl->simple_maxn = maxn;
+    }
+    impl->simple_count  = count;
+    impl->simple_size   = 0;
+
+    // the extra data after indices
+    tb_uint16_t* data = impl->simple_data + 3 * count;
+
+    // the monotone polygon? 
+    if (extremes == 2)
+    {
+        // check it and sort points
+        if (!gb_tessellator_simple_monotone_check(points, count, top, bottom, orient, data)) return tb_false;
+
+        // output the whole contour if make monotone or convex polygon
+        tb_check_return_val(triangulation, tb_true);
+
+        // triangulate it
+        gb_tessellator_simple_monotone_make(impl, points, count, top, bottom, orient, data, data + count);
+        return tb_true;
+    }
+
+    // triangulate the small polygon
+    return gb_tessellator_simple_earcut_make(impl, points, count, orient, data, data + count);
+}
@@ -32,6 +32,7 @@
 #include "convex.h"
 #include "geometry.h"
 #include "monotone.h"
+#include "simple.h"
 #include "triangulation.h"
 
 #endif
@@ -432,10 +432,7 @@ static tb_long_t gb_mesh_printf_vertex(tb_cpointer_t object, tb_char_t* cstr, tb
 }
 #endif
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
- */
-gb_mesh_ref_t gb_mesh_init(tb_element_t edge_element, tb_element_t face_element, tb_element_t vertex_element)
+static gb_mesh_ref_t gb_mesh_init_done(tb_element_t edge_element, tb_element_t face_element, tb_element_t vertex_element, tb_bool_t arena)
 {
     // done
     tb_bool_t           ok = tb_false;
@@ -447,15 +444,15 @@ gb_mesh_ref_t gb_mesh_init(tb_element_t edge_element, tb_element_t face_element,
         tb_assert_and_check_break(impl);
     
         // init edges
-        impl->edges = gb_mesh_edge_list_init(edge_element);
+        impl->edges = gb_mesh_edge_list_init(edge_element, arena);
         tb_assert_and_check_break(impl->edges);
   
         // init faces
-        impl->faces = gb_mesh_face_list_init(face_element);
+        impl->faces = gb_mesh_face_list_init(face_element, arena);
         tb_assert_and_check_break(impl->faces);
 
         // init vertices
-        impl->vertices = gb_mesh_vertex_list_init(vertex_element);
+        impl->vertices = gb_mesh_vertex_list_init(vertex_element, arena);
         tb_assert_and_check_break(impl->vertices);
 
 #ifdef __gb_debug__
@@ -492,6 +489,20 @@ gb_mesh_ref_t gb_mesh_init(tb_element_t edge_element, tb_element_t face_element,
     // ok?
     return (gb_mesh_ref_t)impl;
 }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_mesh_ref_t gb_mesh_init(tb_element_t edge_element, tb_element_t face_element, tb_element_t vertex_element)
+{
+    // init it using the pools
+    return gb_mesh_init_done(edge_element, face_element, vertex_element, tb_false);
+}
+gb_mesh_ref_t gb_mesh_init_arena(tb_element_t edge_element, tb_element_t face_element, tb_element_t vertex_element)
+{
+    // init it using the arenas
+    return gb_mesh_init_done(edge_element, face_element, vertex_element, tb_true);
+}
 tb_void_t gb_mesh_exit(gb_mesh_ref_t mesh)
 {
     // check
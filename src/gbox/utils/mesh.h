@@ -373,6 +373,21 @@ typedef struct{}*               gb_mesh_ref_t;
  */
 gb_mesh_ref_t                   gb_mesh_init(tb_element_t edge_element, tb_element_t face_element, tb_element_t vertex_element);
 
+/*! init the mesh using the arenas
+ *
+ * the edges, faces and vertices are bumped from the arenas, 
+ * gb_mesh_clear() will reset them in O(1) and keep their memory for the next using.
+ *
+ * @note the element free functions will be not called when clearing the mesh
+ *
+ * @param edge_element          the edge element
+ * @param face_element          the face element
+ * @param vertex_element        the vertex element
+ *
+ * @return                      the mesh
+ */
+gb_mesh_ref_t                   gb_mesh_init_arena(tb_element_t edge_element, tb_element_t face_element, tb_element_t vertex_element);
+
 /*! exit the mesh 
  *
  * @param mesh                  the mesh
@@ -34,6 +34,9 @@
  */
 #include "tessellator.h"
 #include "impl/tessellator/tessellator.h"
+#include "impl/tessellator/active_region.h"
+#include "impl/tessellator/cache.h"
+#include "impl/tessellator/parallel.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -46,13 +49,109 @@
 #   define GB_TESSELLATOR_OUTPUTS_GROW                          (64)
 #endif
 
+// the vertex have been not output to the triangles
+#define GB_TESSELLATOR_VERTEX_INDEX_NONE                        (0xffffffff)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static __tb_inline__ tb_uint32_t gb_tessellator_done_output_vertex(gb_tessellator_triangles_ref_t triangles, gb_mesh_vertex_ref_t vertex)
+{
+    // the tessellator vertex
+    gb_tessellator_vertex_ref_t data = gb_tessellator_vertex(vertex);
+
+    // output this vertex only once if it is shared by the triangles
+    if (data->index == GB_TESSELLATOR_VERTEX_INDEX_NONE)
+    {
+        // save the index
+        data->index = (tb_uint32_t)triangles->vertices_count;
+
+        // append the vertex if the vertices are enough, we only count it if be overflow
+        if (triangles->vertices_count < triangles->vertices_maxn) triangles->vertices[triangles->vertices_count] = data->point;
+        triangles->vertices_count++;
+    }
+
+    // the index
+    return data->index;
+}
+static __tb_inline__ tb_void_t gb_tessellator_done_output_index(gb_tessellator_triangles_ref_t triangles, tb_uint32_t index)
+{
+    // append the index if the indices are enough, we only count it if be overflow
+    if (triangles->indices_count < triangles->indices_maxn)
+    {
+        if (triangles->index_type == GB_TESSELLATOR_INDEX_TYPE_UINT16)
+            ((tb_uint16_t*)triangles->indices)[triangles->indices_count] = (tb_uint16_t)index;
+        else ((tb_uint32_t*)triangles->indices)[triangles->indices_count] = index;
+    }
+    triangles->indices_count++;
+}
+static tb_void_t gb_tessellator_done_output_triangles(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->mesh && impl->triangles);
+
+    // the triangles
+    gb_tessellator_triangles_ref_t triangles = impl->triangles;
+    tb_size_t                      vertices_count = triangles->vertices_count;
+
+    // reset the output index of all vertices
+    tb_for_all_if (gb_mesh_vertex_ref_t, vertex, gb_mesh_vertex_itor(impl->mesh), vertex)
+    {
+        gb_tessellator_vertex(vertex)->index = GB_TESSELLATOR_VERTEX_INDEX_NONE;
+    }
+
+    // done
+    tb_for_all_if (gb_mesh_face_ref_t, face, gb_mesh_face_itor(impl->mesh), face)
+    {
+        // the face is inside?
+        if (gb_tessellator_face_inside(face)) 
+        {
+            /* make the triangle fan of this region
+             *
+             * the inside regions have been triangulated, 
+             * but we also fan them for the degenerate regions with more than three edges
+             */
+            gb_mesh_edge_ref_t  head    = gb_mesh_face_edge(face);
+            gb_mesh_edge_ref_t  edge    = gb_mesh_edge_lnext(head);
+            gb_mesh_edge_ref_t  last    = gb_mesh_edge_lprev(head);
+            tb_uint32_t         first   = 0;
+            tb_uint32_t         prev    = 0;
+
+            // less than three vertices? ignore it
+            tb_check_continue(edge != head && edge != last);
+
+            // append the first two vertices
+            first   = gb_tessellator_done_output_vertex(triangles, gb_mesh_edge_org(head));
+            prev    = gb_tessellator_done_output_vertex(triangles, gb_mesh_edge_org(edge));
+            while (edge != last)
+            {
+                // the next edge
+                edge = gb_mesh_edge_lnext(edge);
+
+                // append the next triangle
+                tb_uint32_t index = gb_tessellator_done_output_vertex(triangles, gb_mesh_edge_org(edge));
+                gb_tessellator_done_output_index(triangles, first);
+                gb_tessellator_done_output_index(triangles, prev);
+                gb_tessellator_done_output_index(triangles, index);
+                prev = index;
+            }
+        }
+    }
+
+    // stat the output vertices
+    gb_tessellator_stats_add(impl, vertices, triangles->vertices_count - vertices_count);
+}
 static tb_void_t gb_tessellator_done_output(gb_tessellator_impl_t* impl)
 {
     // check
-    tb_assert(impl && impl->mesh && impl->func);
+    tb_assert(impl && impl->mesh && (impl->func || impl->triangles));
+
+    // make the indexed triangles?
+    if (impl->triangles) 
+    {
+        gb_tessellator_done_output_triangles(impl);
+        return ;
+    }
 
     // init outputs first
     if (!impl->outputs) impl->outputs = tb_vector_init(GB_TESSELLATOR_OUTPUTS_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
@@ -101,6 +200,9 @@ static tb_void_t gb_tessellator_done_output(gb_tessellator_impl_t* impl)
                 // append the first point for closing the contour
                 tb_vector_insert_tail(outputs, point_first);
 
+                // stat the output vertices
+                gb_tessellator_stats_add(impl, vertices, tb_vector_size(outputs));
+
                 // done it
                 impl->func((gb_point_ref_t)tb_vector_data(outputs), (tb_uint16_t)tb_vector_size(outputs), impl->priv);
             }
@@ -110,26 +212,33 @@ static tb_void_t gb_tessellator_done_output(gb_tessellator_impl_t* impl)
 static tb_void_t gb_tessellator_done_convex(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
 {
     // check
-    tb_assert(impl && impl->func && polygon && bounds);
+    tb_assert(impl && (impl->func || impl->triangles) && polygon && bounds);
 
     // only one convex contour
     tb_assert(polygon->convex && polygon->counts && !polygon->counts[1]);
 
     // make convex or monotone? done it directly
-    if (impl->mode == GB_TESSELLATOR_MODE_CONVEX || impl->mode == GB_TESSELLATOR_MODE_MONOTONE)
+    if (!impl->triangles && (impl->mode == GB_TESSELLATOR_MODE_CONVEX || impl->mode == GB_TESSELLATOR_MODE_MONOTONE))
     {
         // done it
+        tb_hong_t time = gb_tessellator_stats_time(impl);
         impl->func(polygon->points, polygon->counts[0], impl->priv);
+        gb_tessellator_stats_time_add(impl, output, time);
+
+        // stat the output vertices
+        gb_tessellator_stats_add(impl, vertices, polygon->counts[0]);
 
         // ok
         return ;
     }
 
     // must be triangulation mode now
-    tb_assert(impl->mode == GB_TESSELLATOR_MODE_TRIANGULATION);
+    tb_assert(impl->triangles || impl->mode == GB_TESSELLATOR_MODE_TRIANGULATION);
 
     // make mesh
+    tb_hong_t time = gb_tessellator_stats_time(impl);
     if (!gb_tessellator_mesh_make(impl, polygon)) return ;
+    gb_tessellator_stats_time_add(impl, mesh, time);
 
     // only two faces
     gb_mesh_ref_t mesh = impl->mesh;
@@ -139,10 +248,14 @@ static tb_void_t gb_tessellator_done_convex(gb_tessellator_impl_t* impl, gb_poly
     gb_tessellator_face_inside_set(gb_mesh_face_head(mesh), 1);
 
     // make triangulation region
+    time = gb_tessellator_stats_time(impl);
     gb_tessellator_triangulation_make(impl);
+    gb_tessellator_stats_time_add(impl, triangulation, time);
 
     // done output
+    time = gb_tessellator_stats_time(impl);
     gb_tessellator_done_output(impl);
+    gb_tessellator_stats_time_add(impl, output, time);
 }
 static tb_void_t gb_tessellator_done_concave(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
 { 
@@ -150,27 +263,126 @@ static tb_void_t gb_tessellator_done_concave(gb_tessellator_impl_t* impl, gb_pol
     tb_assert(impl && polygon && !polygon->convex && bounds);
 
     // make mesh
+    tb_hong_t time = gb_tessellator_stats_time(impl);
     if (!gb_tessellator_mesh_make(impl, polygon)) return ;
+    gb_tessellator_stats_time_add(impl, mesh, time);
 
     // make horizontal monotone region
     gb_tessellator_monotone_make(impl, bounds);
 
     // need make convex or triangulation polygon?
-    if (impl->mode == GB_TESSELLATOR_MODE_CONVEX || impl->mode == GB_TESSELLATOR_MODE_TRIANGULATION)
+    if (impl->triangles || impl->mode == GB_TESSELLATOR_MODE_CONVEX || impl->mode == GB_TESSELLATOR_MODE_TRIANGULATION)
     {
         // make triangulation region for each horizontal monotone region
+        time = gb_tessellator_stats_time(impl);
         gb_tessellator_triangulation_make(impl);
 
         // make convex? 
-        if (impl->mode == GB_TESSELLATOR_MODE_CONVEX)
+        if (!impl->triangles && impl->mode == GB_TESSELLATOR_MODE_CONVEX)
         {
             // merge triangles to the convex polygon
             gb_tessellator_convex_make(impl);
         }
+        gb_tessellator_stats_time_add(impl, triangulation, time);
     }
 
     // done output
+    time = gb_tessellator_stats_time(impl);
     gb_tessellator_done_output(impl);
+    gb_tessellator_stats_time_add(impl, output, time);
+}
+static tb_bool_t gb_tessellator_done_simple(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon)
+{
+    // check
+    tb_assert(impl && (impl->func || impl->triangles) && polygon);
+
+    // make the simple polygon, we need use the general algorithm if it is not simple
+    tb_hong_t time = gb_tessellator_stats_time(impl);
+    tb_bool_t ok = gb_tessellator_simple_make(impl, polygon);
+    gb_tessellator_stats_time_add(impl, triangulation, time);
+    tb_check_return_val(ok, tb_false);
+
+    // the points and indices
+    gb_point_ref_t      points  = polygon->points;
+    tb_uint16_t const*  indices = impl->simple_data;
+    tb_size_t           size    = impl->simple_size;
+    tb_size_t           index   = 0;
+
+    // make the indexed triangles?
+    time = gb_tessellator_stats_time(impl);
+    gb_tessellator_triangles_ref_t triangles = impl->triangles;
+    if (triangles)
+    {
+        // the base index
+        tb_size_t base = triangles->vertices_count;
+
+        // append all points, they are not shared with other contours
+        tb_size_t count = impl->simple_count;
+        for (index = 0; index < count; index++)
+        {
+            if (triangles->vertices_count < triangles->vertices_maxn) triangles->vertices[triangles->vertices_count] = points[index];
+            triangles->vertices_count++;
+        }
+
+        // append all indices
+        for (index = 0; index < size; index++)
+            gb_tessellator_done_output_index(triangles, (tb_uint32_t)(base + indices[index]));
+    }
+    // output the whole contour?
+    else if (!size) impl->func(points, polygon->counts[0], impl->priv);
+    else
+    {
+        // output all triangles
+        gb_point_t triangle[4];
+        for (index = 0; index < size; index += 3)
+        {
+            triangle[0] = points[indices[index]];
+            triangle[1] = points[indices[index + 1]];
+            triangle[2] = points[indices[index + 2]];
+            triangle[3] = triangle[0];
+            impl->func(triangle, 4, impl->priv);
+        }
+    }
+    gb_tessellator_stats_time_add(impl, output, time);
+
+    // stat the output vertices, the closed points of the triangles are also counted
+    gb_tessellator_stats_add(impl, vertices, triangles? impl->simple_count : (size? (size / 3) << 2 : polygon->counts[0]));
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_tessellator_done_polygon(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(impl && polygon && polygon->points && polygon->counts && bounds);
+
+    // is convex polygon for each contour?
+    if (polygon->convex)
+    {
+        // done
+        tb_size_t       index               = 0;
+        gb_point_ref_t  points              = polygon->points;
+        tb_uint16_t*    counts              = polygon->counts;
+        tb_uint16_t     contour_counts[2]   = {0, 0};
+        gb_polygon_t    contour             = {tb_null, contour_counts, tb_true};
+        while ((contour_counts[0] = *counts++))
+        {
+            // init the polygon for this contour
+            contour.points = points + index;
+
+            // done tessellator for the convex contour, will be faster
+            gb_tessellator_done_convex(impl, &contour, bounds);
+
+            // update the contour index
+            index += contour_counts[0];
+        }
+    }
+    // done tessellator for the simple polygon without the mesh, will be faster
+    else if (!gb_tessellator_done_simple(impl, polygon))
+    {
+        // done tessellator for the concave polygon
+        gb_tessellator_done_concave(impl, polygon, bounds);
+    }
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -199,9 +411,28 @@ tb_void_t gb_tessellator_exit(gb_tessellator_ref_t tessellator)
     if (impl->event_queue) tb_priority_queue_exit(impl->event_queue);
     impl->event_queue = tb_null;
 
+    // exit the sorted events
+    if (impl->event_sorted_keys) tb_free(impl->event_sorted_keys);
+    impl->event_sorted_keys = tb_null;
+    impl->event_sorted      = tb_null;
+
     // exit active regions
-    if (impl->active_regions) tb_list_exit(impl->active_regions);
-    impl->active_regions = tb_null;
+    gb_tessellator_active_regions_exit(impl);
+
+    // exit the simple polygon data
+    if (impl->simple_data) tb_free(impl->simple_data);
+    impl->simple_data = tb_null;
+
+    // exit cache
+    if (impl->cache) gb_tessellator_cache_exit(impl->cache);
+    impl->cache = tb_null;
+
+    // exit parallel
+    gb_tessellator_parallel_exit(impl);
+
+    // exit stats
+    if (impl->stats) tb_free(impl->stats);
+    impl->stats = tb_null;
 
     // exit it
     tb_free(impl);
@@ -234,36 +465,116 @@ tb_void_t gb_tessellator_func_set(gb_tessellator_ref_t tessellator, gb_tessellat
     impl->func = func;
     impl->priv = priv;
 }
+tb_void_t gb_tessellator_cache_set(gb_tessellator_ref_t tessellator, tb_size_t maxn)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_and_check_return(impl);
+
+    // exit the old cache
+    if (impl->cache) gb_tessellator_cache_exit(impl->cache);
+    impl->cache = tb_null;
+
+    // init the new cache
+    if (maxn) impl->cache = gb_tessellator_cache_init(maxn);
+}
+tb_void_t gb_tessellator_threads_set(gb_tessellator_ref_t tessellator, tb_size_t count)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_and_check_return(impl);
+
+    // set the threads count
+    impl->threads = count;
+}
+tb_void_t gb_tessellator_stats_enable(gb_tessellator_ref_t tessellator, tb_bool_t enable)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_and_check_return(impl);
+
+    // enable it?
+    if (enable)
+    {
+        // make stats
+        if (!impl->stats) impl->stats = tb_malloc0_type(gb_tessellator_stats_t);
+
+        // clear stats
+        gb_tessellator_stats_clear(tessellator);
+    }
+    // disable it
+    else 
+    {
+        // exit stats
+        if (impl->stats) tb_free(impl->stats);
+        impl->stats = tb_null;
+    }
+}
+gb_tessellator_stats_ref_t gb_tessellator_stats(gb_tessellator_ref_t tessellator)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the stats
+    return impl->stats;
+}
+tb_void_t gb_tessellator_stats_clear(gb_tessellator_ref_t tessellator)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_and_check_return(impl);
+
+    // clear stats
+    if (impl->stats) tb_memset(impl->stats, 0, sizeof(gb_tessellator_stats_t));
+}
 tb_void_t gb_tessellator_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
 {
     // check
     gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
     tb_assert_and_check_return(impl && impl->func && polygon && polygon->points && polygon->counts && bounds);
 
-    // is convex polygon for each contour?
-    if (polygon->convex)
-    {
-        // done
-        tb_size_t       index               = 0;
-        gb_point_ref_t  points              = polygon->points;
-        tb_uint16_t*    counts              = polygon->counts;
-        tb_uint16_t     contour_counts[2]   = {0, 0};
-        gb_polygon_t    contour             = {tb_null, contour_counts, tb_true};
-        while ((contour_counts[0] = *counts++))
-        {
-            // init the polygon for this contour
-            contour.points = points + index;
+    // done it from the cache if this polygon has been tessellated
+    if (impl->cache && gb_tessellator_cache_done(impl, polygon)) return ;
 
-            // done tessellator for the convex contour, will be faster
-            gb_tessellator_done_convex(impl, &contour, bounds);
+    // stat the polygons
+    gb_tessellator_stats_add(impl, polygons, 1);
 
-            // update the contour index
-            index += contour_counts[0];
-        }
-    }
-    else
+    // done the independent contour groups one by one, concurrently if the threads are enabled
+    if (!gb_tessellator_parallel_done(impl, polygon))
     {
-        // done tessellator for the concave polygon
-        gb_tessellator_done_concave(impl, polygon, bounds);
+        // done it
+        gb_tessellator_done_polygon(impl, polygon, bounds);
     }
+
+    // save the outputs to the cache
+    if (impl->cache) gb_tessellator_cache_save(impl, polygon);
+}
+tb_bool_t gb_tessellator_done_triangles(gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, gb_tessellator_triangles_ref_t triangles)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_and_check_return_val(impl && polygon && polygon->points && polygon->counts && bounds, tb_false);
+    tb_assert_and_check_return_val(triangles && (triangles->vertices || !triangles->vertices_maxn) && (triangles->indices || !triangles->indices_maxn), tb_false);
+
+    // clear the triangles
+    triangles->vertices_count   = 0;
+    triangles->indices_count    = 0;
+
+    // stat the polygons
+    gb_tessellator_stats_add(impl, polygons, 1);
+
+    // done it and output to the triangles
+    impl->triangles = triangles;
+    gb_tessellator_done_polygon(impl, polygon, bounds);
+    impl->triangles = tb_null;
+
+    // the vertices and indices are enough?
+    tb_check_return_val(triangles->vertices_count <= triangles->vertices_maxn && triangles->indices_count <= triangles->indices_maxn, tb_false);
+
+    // the tb_uint16_t indices are overflow?
+    tb_check_return_val(triangles->index_type != GB_TESSELLATOR_INDEX_TYPE_UINT16 || triangles->vertices_count <= 0x10000, tb_false);
+
+    // ok
+    return tb_true;
 }
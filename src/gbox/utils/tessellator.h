@@ -115,6 +115,95 @@ typedef enum __gb_tessellator_rule_e
 
 }gb_tessellator_rule_e;
 
+/// the polygon tessellator index type enum
+typedef enum __gb_tessellator_index_type_e
+{
+    GB_TESSELLATOR_INDEX_TYPE_UINT16    = 0     //!< the tb_uint16_t indices
+,   GB_TESSELLATOR_INDEX_TYPE_UINT32    = 1     //!< the tb_uint32_t indices
+
+}gb_tessellator_index_type_e;
+
+/*! the polygon tessellator triangles type
+ *
+ * the indexed triangle mesh of the whole polygon, 
+ * the vertices and indices are provided by the caller and the shared vertices will be only output once.
+ *
+ * @code
+    gb_point_t                  vertices[256];
+    tb_uint16_t                 indices[768];
+    gb_tessellator_triangles_t  triangles = {vertices, 256, 0, indices, 768, 0, GB_TESSELLATOR_INDEX_TYPE_UINT16};
+ * @endcode
+ */
+typedef struct __gb_tessellator_triangles_t
+{
+    /// the vertices
+    gb_point_ref_t      vertices;
+
+    /// the vertices maxn
+    tb_size_t           vertices_maxn;
+
+    /// the vertices count, it will be the needed count if the vertices are not enough
+    tb_size_t           vertices_count;
+
+    /// the indices, tb_uint16_t* or tb_uint32_t*
+    tb_pointer_t        indices;
+
+    /// the indices maxn
+    tb_size_t           indices_maxn;
+
+    /// the indices count, it will be the needed count if the indices are not enough
+    tb_size_t           indices_count;
+
+    /// the index type
+    tb_size_t           index_type;
+
+}gb_tessellator_triangles_t, *gb_tessellator_triangles_ref_t;
+
+/*! the polygon tessellator stats type
+ *
+ * the times (microseconds) and counters are accumulated for all tessellated polygons until it is cleared,
+ * the outputs of the cache are not counted and the times of the concurrent workers are summed.
+ */
+typedef struct __gb_tessellator_stats_t
+{
+    /// the time of building the mesh
+    tb_hong_t           mesh_time;
+
+    /// the time of removing the degenerate edges and faces
+    tb_hong_t           degenerate_time;
+
+    /// the time of making the event queue
+    tb_hong_t           event_queue_time;
+
+    /// the time of sweeping the events, including the intersection fixups
+    tb_hong_t           sweep_time;
+
+    /// the time of fixing the intersections
+    tb_hong_t           intersection_time;
+
+    /// the time of triangulating the regions or merging them into the convex regions
+    tb_hong_t           triangulation_time;
+
+    /// the time of outputting the regions, including the tessellator func
+    tb_hong_t           output_time;
+
+    /// the tessellated polygons count
+    tb_size_t           polygons;
+
+    /// the swept events count
+    tb_size_t           events;
+
+    /// the inserted intersections count
+    tb_size_t           intersections;
+
+    /// the inserted active regions count
+    tb_size_t           regions;
+
+    /// the output vertices count
+    tb_size_t           vertices;
+
+}gb_tessellator_stats_t, *gb_tessellator_stats_ref_t;
+
 /// the polygon tessellator ref type 
 typedef struct{}*       gb_tessellator_ref_t;
 
@@ -164,6 +253,57 @@ tb_void_t               gb_tessellator_rule_set(gb_tessellator_ref_t tessellator
  */
 tb_void_t               gb_tessellator_func_set(gb_tessellator_ref_t tessellator, gb_tessellator_func_t func, tb_cpointer_t priv);
 
+/*! set the cache of the tessellator
+ *
+ * the outputs of the same polygon (points, counts, rule and mode) will be reused
+ * and the least recently used outputs will be removed if the memory is not enough.
+ *
+ * the cache is disabled by default and it is only used by gb_tessellator_done().
+ *
+ * @param tessellator   the tessellator
+ * @param maxn          the maximum memory size of all cached outputs, disable the cache if be zero
+ */
+tb_void_t               gb_tessellator_cache_set(gb_tessellator_ref_t tessellator, tb_size_t maxn);
+
+/*! set the maximum threads count of the tessellator
+ *
+ * the contours of the large polygon are grouped by the overlapping bounds, e.g. the separate islands on a map,
+ * and the independent groups are always tessellated one by one, concurrently on the thread pool if the threads are enabled.
+ *
+ * the outputs are passed to the tessellator func in the current thread and in the order of the groups,
+ * so they are same for any threads count, including the disabled threads.
+ *
+ * the threads are disabled by default and they are only used by gb_tessellator_done().
+ *
+ * @param tessellator   the tessellator
+ * @param count         the maximum threads count, disable it if be zero or one
+ */
+tb_void_t               gb_tessellator_threads_set(gb_tessellator_ref_t tessellator, tb_size_t count);
+
+/*! enable or disable the stats of the tessellator
+ *
+ * it works in the release mode and the stats will be cleared if it is enabled.
+ * the stats are disabled by default and the tessellator will be not slowed down.
+ *
+ * @param tessellator   the tessellator
+ * @param enable        enable the stats?
+ */
+tb_void_t               gb_tessellator_stats_enable(gb_tessellator_ref_t tessellator, tb_bool_t enable);
+
+/*! get the stats of the tessellator
+ *
+ * @param tessellator   the tessellator
+ *
+ * @return              the stats, tb_null if the stats are disabled
+ */
+gb_tessellator_stats_ref_t gb_tessellator_stats(gb_tessellator_ref_t tessellator);
+
+/*! clear the stats of the tessellator
+ *
+ * @param tessellator   the tessellator
+ */
+tb_void_t               gb_tessellator_stats_clear(gb_tessellator_ref_t tessellator);
+
 /*! done the tessellator
  *
  * @param tessellator   the tessellator
@@ -172,6 +312,21 @@ tb_void_t               gb_tessellator_func_set(gb_tessellator_ref_t tessellator
  */
 tb_void_t               gb_tessellator_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds);
 
+/*! done the tessellator and make the indexed triangles of the whole polygon
+ *
+ * the polygon will be triangulated in one pass and the tessellator func will be not called.
+ *
+ * @note the vertices count must be not larger than 65536 for the tb_uint16_t indices
+ *
+ * @param tessellator   the tessellator
+ * @param polygon       the polygon
+ * @param bounds        the polygon bounds
+ * @param triangles     the triangles
+ *
+ * @return              tb_true or tb_false if the vertices or indices are not enough
+ */
+tb_bool_t               gb_tessellator_done_triangles(gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, gb_tessellator_triangles_ref_t triangles);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */